@@ -49,6 +49,7 @@ class CommandBufferQueue {
     mutable std::vector<Range> mCommandBuffersToExecute;
     size_t mFreeSpace = 0;
     size_t mHighWatermark = 0;
+    size_t mPeriodHighWatermark = 0;
     uint32_t mExitRequested = 0;
 
     static constexpr uint32_t EXIT_REQUESTED = 0x31415926;
@@ -63,8 +64,12 @@ public:
 
     size_t getCapacity() const noexcept { return mRequiredSize; }
 
+    // maximum number of bytes in flight in the circular buffer, since creation
     size_t getHighWatermark() const noexcept { return mHighWatermark; }
 
+    // maximum number of bytes in flight in the circular buffer since the last call
+    size_t getAndResetPeriodHighWatermark() noexcept;
+
     // wait for commands to be available and returns an array containing these commands
     std::vector<Range> waitForCommands() const;
 
@@ -204,8 +204,11 @@ private:
         struct Node { uint8_t age; };
         // Note: using the `extra` parameter of PoolAllocator<>, even with a 1-byte structure,
         // generally increases all pool allocations by 8-bytes because of alignment restrictions.
+        // Handles are typically allocated on the main thread and freed on the backend thread,
+        // the per-thread caches of ThreadCachedFreeList keep these two from contending.
         template<size_t SIZE>
-        using Pool = utils::PoolAllocator<SIZE, MIN_ALIGNMENT, sizeof(Node)>;
+        using Pool = utils::PoolAllocator<SIZE, MIN_ALIGNMENT, sizeof(Node),
+                utils::ThreadCachedFreeList>;
         Pool<P0> mPool0;
         Pool<P1> mPool1;
         Pool<P2> mPool2;
@@ -247,16 +250,15 @@ private:
         }
     };
 
-// FIXME: We should be using a Spinlock here, at least on platforms where mutexes are not
-//        efficient (i.e. non-Linux). However, we've seen some hangs on that spinlock, which
-//        we don't understand well (b/308029108).
+// The pools are thread-safe, so the arena only needs a lock for the TrackingPolicy on
+// debug builds.
 #ifndef NDEBUG
     using HandleArena = utils::Arena<Allocator,
             utils::LockingPolicy::Mutex,
             utils::TrackingPolicy::DebugAndHighWatermark>;
 #else
     using HandleArena = utils::Arena<Allocator,
-            utils::LockingPolicy::Mutex>;
+            utils::LockingPolicy::NoLock>;
 #endif
 
     // allocateHandle()/deallocateHandle() selects the pool to use at compile-time based on the
@@ -275,7 +277,7 @@ private:
     }
 
     // allocateHandleInPool()/deallocateHandleFromPool() is NOT inlined, which will cause three
-    // versions to be generated, one for each pool. Because the arena is synchronized,
+    // versions to be generated, one for each pool. Because the pools are synchronized,
     // the code generated is not trivial (even if it's not insane either).
     template<size_t SIZE>
     UTILS_NOINLINE
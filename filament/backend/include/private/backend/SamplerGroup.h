@@ -78,6 +78,7 @@ public:
 
     // FIXME: This is now [[deprecated]]. Currently it is only used by the Vulkan/Metal backends.
     backend::SamplerDescriptor* data() noexcept { return mBuffer.data(); }
+    backend::SamplerDescriptor const* data() const noexcept { return mBuffer.data(); }
 
 private:
 #if !defined(NDEBUG)
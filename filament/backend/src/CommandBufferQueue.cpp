@@ -100,18 +100,19 @@ void CommandBufferQueue::flush() noexcept {
 
     // wait until there is enough space in the buffer
     mFreeSpace -= used;
-    if (UTILS_UNLIKELY(mFreeSpace < requiredSize)) {
 
+    size_t const totalUsed = circularBuffer.size() - mFreeSpace;
+    mHighWatermark = std::max(mHighWatermark, totalUsed);
+    mPeriodHighWatermark = std::max(mPeriodHighWatermark, totalUsed);
+
+    if (UTILS_UNLIKELY(mFreeSpace < requiredSize)) {
 
 #ifndef NDEBUG
-        size_t const totalUsed = circularBuffer.size() - mFreeSpace;
         slog.d << "CommandStream used too much space (will block): "
                 << "needed space " << requiredSize << " out of " << mFreeSpace
                 << ", totalUsed=" << totalUsed << ", current=" << used
                 << ", queue size=" << mCommandBuffersToExecute.size() << " buffers"
                 << io::endl;
-
-        mHighWatermark = std::max(mHighWatermark, totalUsed);
 #endif
 
         SYSTRACE_NAME("waiting: CircularBuffer::flush()");
@@ -122,6 +123,13 @@ void CommandBufferQueue::flush() noexcept {
     }
 }
 
+size_t CommandBufferQueue::getAndResetPeriodHighWatermark() noexcept {
+    std::lock_guard<utils::Mutex> const lock(mLock);
+    size_t const wm = mPeriodHighWatermark;
+    mPeriodHighWatermark = mCircularBuffer.size() - mFreeSpace;
+    return wm;
+}
+
 std::vector<CommandBufferQueue::Range> CommandBufferQueue::waitForCommands() const {
     if (!UTILS_HAS_THREADING) {
         return std::move(mCommandBuffersToExecute);
@@ -331,6 +331,38 @@ public:
          * The default value of 30 corresponds to about half a second at 60 fps.
          */
         uint32_t resourceAllocatorCacheMaxAge = 30;
+
+        /*
+         * Maximum size in MiB the per-render-pass arena is allowed to grow to.
+         *
+         * When this is larger than perRenderPassArenaSizeMB, the per-render-pass arena and the
+         * per-frame commands buffer it contains are grown between frames, when the previous
+         * frame used more than 3/4 of their capacity. Growing the arena reallocates it, and the
+         * new sizes are reflected in getConfig(). The default value of 0 disables this behavior.
+         *
+         * @see Engine::getFrameMemoryUsage
+         */
+        uint32_t perRenderPassArenaMaxSizeMB = 0;
+    };
+
+    /**
+     * Peak memory usage of the Engine's per-frame buffers, in bytes.
+     *
+     * @see Engine::getFrameMemoryUsage
+     */
+    struct FrameMemoryUsage {
+        //! peak usage of the per-render-pass arena, including the per-frame commands
+        size_t perRenderPassArenaPeak = 0;
+        //! size of the per-render-pass arena (Config::perRenderPassArenaSizeMB)
+        size_t perRenderPassArenaSize = 0;
+        //! peak usage of the per-frame commands buffer, exceeds its size on overflow
+        size_t perFrameCommandsPeak = 0;
+        //! size of the per-frame commands buffer (Config::perFrameCommandsSizeMB)
+        size_t perFrameCommandsSize = 0;
+        //! peak number of bytes in flight in the backend command buffer
+        size_t commandBufferPeak = 0;
+        //! size of the backend command buffer (Config::commandBufferSizeMB)
+        size_t commandBufferSize = 0;
     };
 
 
@@ -597,6 +629,25 @@ public:
      */
     bool isStereoSupported(StereoscopicType stereoscopicType) const noexcept;
 
+    /**
+     * Enables sampling the CPU's hardware performance counters (instructions, cycles, L1 data
+     * cache and branch predictor events) around each phase of Renderer::render().
+     *
+     * This is only supported on Linux and Android, and might require the permission to use
+     * perf events. Reading the counters has a cost, so this is disabled by default.
+     *
+     * @param enabled true to enable the performance counters, false to disable them.
+     * @return false if the performance counters couldn't be enabled.
+     * @see Renderer::getPerformanceReport()
+     */
+    bool setPerformanceCountersEnabled(bool enabled) noexcept;
+
+    /**
+     * @return true if the performance counters are enabled.
+     * @see setPerformanceCountersEnabled()
+     */
+    bool isPerformanceCountersEnabled() const noexcept;
+
     /**
      * Retrieves the configuration settings of this Engine.
      *
@@ -610,6 +661,19 @@ public:
      */
     const Config& getConfig() const noexcept;
 
+    /**
+     * Returns the peak memory usage of the Engine's per-frame buffers during the last frame,
+     * that is, between the last two calls to Renderer::endFrame() (or
+     * Renderer::renderStandaloneView()).
+     *
+     * This can be used to size Config::perRenderPassArenaSizeMB, Config::perFrameCommandsSizeMB
+     * and Config::commandBufferSizeMB for a given application.
+     *
+     * @return a FrameMemoryUsage structure with the peak usage of each buffer and its size
+     * @see Config::perRenderPassArenaMaxSizeMB
+     */
+    FrameMemoryUsage getFrameMemoryUsage() const noexcept;
+
     /**
      * Returns the maximum number of stereoscopic eyes supported by Filament. The actual number of
      * eyes rendered is set at Engine creation time with the Engine::Config::stereoscopicEyeCount
@@ -222,6 +222,30 @@ public:
         Builder& material(size_t index,
                 MaterialInstance const* UTILS_NONNULL materialInstance) noexcept;
 
+        /**
+         * Groups primitives into a level of detail. Only one level of detail of a renderable is
+         * drawn at a time, selected from its size on screen, so that distant renderables cost
+         * fewer triangles and fewer draw calls.
+         *
+         * Levels are made of consecutive primitives: level 0 is made of the first
+         * \p primitiveCount primitives, level 1 of the following ones, and so on. Level 0 should
+         * be the most detailed. Primitive indices passed to other methods span all the levels.
+         *
+         * The screen size of a renderable is the diameter of its bounding sphere projected on
+         * screen, as a fraction of the viewport height. A level is drawn when the screen size of
+         * the renderable is at least \p screenSize, and the renderable is not drawn at all when
+         * it is smaller than the screen size of its last level, which can be 0. Screen sizes must
+         * decrease from one level to the next. Levels are selected for each pass, e.g. shadow maps
+         * use the size of the renderable as seen from the light.
+         *
+         * By default, a renderable has a single level of detail made of all its primitives.
+         *
+         * @param level zero-based index of the level of detail
+         * @param primitiveCount number of primitives in this level
+         * @param screenSize smallest screen size at which this level is drawn
+         */
+        Builder& levelOfDetail(uint8_t level, size_t primitiveCount, float screenSize) noexcept;
+
         /**
          * The axis-aligned bounding box of the renderable.
          *
@@ -786,6 +810,12 @@ public:
      */
     size_t getPrimitiveCount(Instance instance) const noexcept;
 
+    /**
+     * Gets the immutable number of levels of detail in the given renderable, 1 unless they were
+     * specified with Builder::levelOfDetail().
+     */
+    size_t getLevelOfDetailCount(Instance instance) const noexcept;
+
     /**
      * Changes the material instance binding for the given primitive.
      *
@@ -153,6 +153,45 @@ public:
         bool discard = true;
     };
 
+    /**
+     * Phases of rendering a View, for which CPU performance counters are reported.
+     *
+     * @see getPerformanceReport()
+     */
+    enum class RenderPhase : uint8_t {
+        PREPARE,    //!< scene and view preparation, excluding culling
+        CULLING,    //!< renderables, lights and shadow casters culling
+        COMMANDS,   //!< draw commands generation
+        SORT,       //!< draw commands sorting and instancing
+        EXECUTE,    //!< frame graph setup and execution, excluding the phases above
+        FLUSH,      //!< command buffer flush
+    };
+
+    static constexpr size_t RENDER_PHASE_COUNT = 6;
+
+    /**
+     * CPU performance counters accumulated during one phase of a frame.
+     * IPC is instructions / cpuCycles.
+     */
+    struct PerformanceCounters {
+        uint64_t instructions = 0;          //!< retired instructions
+        uint64_t cpuCycles = 0;             //!< CPU cycles, 0 if not supported
+        uint64_t l1dReferences = 0;         //!< L1 data cache references, 0 if not supported
+        uint64_t l1dMisses = 0;             //!< L1 data cache misses, 0 if not supported
+        uint64_t branchInstructions = 0;    //!< branch instructions, 0 if not supported
+        uint64_t branchMisses = 0;          //!< mispredicted branches, 0 if not supported
+        uint64_t timeNs = 0;                //!< time spent in the phase, in nanoseconds
+    };
+
+    /**
+     * Per-phase performance counters of a frame, indexed by RenderPhase.
+     */
+    struct PerformanceReport {
+        uint32_t frameId = 0;               //!< frame this report is for
+        bool valid = false;                 //!< false if counters were disabled or unavailable
+        PerformanceCounters phases[RENDER_PHASE_COUNT];
+    };
+
     /**
      * Information about the display this Renderer is associated to. This information is needed
      * to accurately compute dynamic-resolution scaling and for frame-pacing.
@@ -566,6 +605,21 @@ public:
      */
     double getUserTime() const;
 
+    /**
+     * Returns the CPU performance counters of the last frame, i.e. between the last two calls to
+     * beginFrame() and endFrame() (or of the last renderStandaloneView()), for each RenderPhase.
+     *
+     * The counters must be enabled with Engine::setPerformanceCountersEnabled(), and are only
+     * available on Linux and Android. They only account for work done on the thread calling
+     * render(), not for the work done by the JobSystem's worker threads, or by the backend.
+     *
+     * @return a PerformanceReport whose valid field is false if the counters were disabled or
+     *         not available.
+     *
+     * @see Engine::setPerformanceCountersEnabled()
+     */
+    PerformanceReport const& getPerformanceReport() const noexcept;
+
     /**
      * Sets the user time epoch to now, i.e. resets the user time to zero.
      *
@@ -48,9 +48,12 @@ using HeapAllocatorArena = utils::Arena<
         utils::TrackingPolicy::Untracked,
         utils::AreaPolicy::NullArea>;
 
+// LinearAllocatorArena always tracks its high watermark, which is reported by
+// Engine::getFrameMemoryUsage().
 using LinearAllocatorArena = utils::Arena<
         utils::LinearAllocator,
-        utils::LockingPolicy::NoLock>;
+        utils::LockingPolicy::NoLock,
+        utils::TrackingPolicy::HighWatermark>;
 
 #endif
 
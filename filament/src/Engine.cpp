@@ -327,10 +327,22 @@ size_t Engine::getMaxAutomaticInstances() const noexcept {
     return downcast(this)->getMaxAutomaticInstances();
 }
 
+bool Engine::setPerformanceCountersEnabled(bool enabled) noexcept {
+    return downcast(this)->getRenderPhaseCounters().setEnabled(enabled);
+}
+
+bool Engine::isPerformanceCountersEnabled() const noexcept {
+    return downcast(this)->getRenderPhaseCounters().isEnabled();
+}
+
 const Engine::Config& Engine::getConfig() const noexcept {
     return downcast(this)->getConfig();
 }
 
+Engine::FrameMemoryUsage Engine::getFrameMemoryUsage() const noexcept {
+    return downcast(this)->getFrameMemoryUsage();
+}
+
 bool Engine::isStereoSupported(StereoscopicType stereoscopicType) const noexcept {
     return downcast(this)->isStereoSupported(stereoscopicType);
 }
@@ -102,7 +102,7 @@ MaterialParser::ParseResult MaterialParser::parse() noexcept {
     }
     const ChunkType matTag = mImpl.mMaterialTag;
     const ChunkType dictTag = mImpl.mDictionaryTag;
-    if (UTILS_UNLIKELY(!cc.hasChunk(matTag) || !cc.hasChunk(dictTag))) {
+    if (UTILS_UNLIKELY(!cc.hasChunk(matTag) || !DictionaryReader::hasDictionary(cc, dictTag))) {
         return ParseResult::ERROR_MISSING_BACKEND;
     }
     if (UTILS_UNLIKELY(!DictionaryReader::unflatten(cc, dictTag, mImpl.mBlobDictionary))) {
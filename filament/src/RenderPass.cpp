@@ -128,6 +128,9 @@ RenderPass::RenderPass(FEngine& engine, RenderPassBuilder const& builder) noexce
     mCommandBegin = curr;
     mCommandEnd = curr + commandCount + customCommandCount;
 
+    RenderPhaseCounters& counters = engine.getRenderPhaseCounters();
+
+    counters.push(RenderPhaseCounters::Phase::COMMANDS);
     appendCommands(engine, { curr, commandCount }, builder.mCommandTypeFlags);
 
     if (builder.mCustomCommands.has_value()) {
@@ -136,13 +139,16 @@ RenderPass::RenderPass(FEngine& engine, RenderPassBuilder const& builder) noexce
             appendCustomCommand(p++, channel, passId, command, order, fn);
         }
     }
+    counters.pop();
 
+    counters.push(RenderPhaseCounters::Phase::SORT);
     // sort commands once we're done adding commands
     sortCommands(builder.mArena);
 
     if (engine.isAutomaticInstancingEnabled()) {
         instanceify(engine, builder.mArena);
     }
+    counters.pop();
 }
 
 // this destructor is actually heavy because it inlines ~vector<>
@@ -843,6 +849,7 @@ void RenderPass::Executor::execute(FEngine& engine,
 
         FMaterialInstance const* UTILS_RESTRICT mi = nullptr;
         FMaterial const* UTILS_RESTRICT ma = nullptr;
+        Handle<HwSamplerGroup> boundSamplerGroup;
         auto const* UTILS_RESTRICT pCustomCommands = mCustomCommands.data();
 
         // Maximum space occupied in the CircularBuffer by a single `Command`. This must be
@@ -879,6 +886,7 @@ void RenderPass::Executor::execute(FEngine& engine,
 
                 if (UTILS_UNLIKELY((first->key & CUSTOM_MASK) != uint64_t(CustomCommand::PASS))) {
                     mi = nullptr; // custom command could change the currently bound MaterialInstance
+                    boundSamplerGroup = {};
                     uint32_t const index = (first->key & CUSTOM_INDEX_MASK) >> CUSTOM_INDEX_SHIFT;
                     assert_invariant(index < mCustomCommands.size());
                     pCustomCommands[index]();
@@ -930,7 +938,7 @@ void RenderPass::Executor::execute(FEngine& engine,
 
                     *pPipelinePolygonOffset = mi->getPolygonOffset();
                     pipeline.stencilState = mi->getStencilState();
-                    mi->use(driver);
+                    mi->use(driver, boundSamplerGroup);
                 }
 
                 assert_invariant(ma);
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RenderPhaseCounters.h"
+
+#include <utils/debug.h>
+#include <utils/Log.h>
+#include <utils/Profiler.h>
+
+using namespace utils;
+
+namespace filament {
+
+RenderPhaseCounters::RenderPhaseCounters() noexcept = default;
+
+RenderPhaseCounters::~RenderPhaseCounters() noexcept = default;
+
+bool RenderPhaseCounters::setEnabled(bool enabled) noexcept {
+    mDepth = 0;
+    mReport = {};
+    if (!enabled) {
+        if (mEnabled) {
+            mProfiler.stop();
+            mProfiler.resetEvents(0);
+        }
+        mEnabled = false;
+        return true;
+    }
+    if (!mEnabled) {
+        mProfiler.resetEvents(Profiler::EV_CPU_CYCLES |
+                Profiler::EV_L1D_RATES | Profiler::EV_BPU_RATES);
+        if (!mProfiler.isValid()) {
+            slog.w << "Performance counters are not available" << io::endl;
+            return false;
+        }
+        mProfiler.reset();
+        mProfiler.start();
+        mLastCounters = mProfiler.readCounters();
+        mEnabled = true;
+    }
+    return true;
+}
+
+void RenderPhaseCounters::beginFrame(uint32_t frameId) noexcept {
+    mReport = {};
+    mReport.frameId = frameId;
+    mReport.valid = mEnabled;
+    if (mEnabled) {
+        // don't attribute what happened between frames to any phase
+        mDepth = 0;
+        mLastCounters = mProfiler.readCounters();
+    }
+}
+
+void RenderPhaseCounters::pushSlow(Phase phase) noexcept {
+    accumulate();
+    assert_invariant(mDepth < MAX_DEPTH);
+    if (mDepth < MAX_DEPTH) {
+        mStack[mDepth] = phase;
+    }
+    mDepth++;
+}
+
+void RenderPhaseCounters::popSlow() noexcept {
+    // the counters could have been enabled in the middle of a phase
+    if (mDepth) {
+        accumulate();
+        mDepth--;
+    }
+}
+
+void RenderPhaseCounters::accumulate() noexcept {
+    Profiler::Counters const counters = mProfiler.readCounters();
+    if (mDepth && mDepth <= MAX_DEPTH) {
+        Profiler::Counters const delta = counters - mLastCounters;
+        Renderer::PerformanceCounters& phase = mReport.phases[size_t(mStack[mDepth - 1])];
+        // events the hardware doesn't support are not reported (they'd alias instructions)
+        uint32_t const events = mProfiler.getEnabledEvents();
+        auto const value = [events](uint32_t event, uint64_t v) -> uint64_t {
+            return (events & event) ? v : 0;
+        };
+        phase.instructions        += delta.getInstructions();
+        phase.cpuCycles           += value(Profiler::EV_CPU_CYCLES, delta.getCpuCycles());
+        phase.l1dReferences       += value(Profiler::EV_L1D_REFS, delta.getL1DReferences());
+        phase.l1dMisses           += value(Profiler::EV_L1D_MISSES, delta.getL1DMisses());
+        phase.branchInstructions  += value(Profiler::EV_BPU_REFS, delta.getBranchInstructions());
+        phase.branchMisses        += value(Profiler::EV_BPU_MISSES, delta.getBranchMisses());
+        phase.timeNs              += delta.getWallTime().count();
+    }
+    mLastCounters = counters;
+}
+
+} // namespace filament
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_RENDERPHASECOUNTERS_H
+#define TNT_FILAMENT_RENDERPHASECOUNTERS_H
+
+#include <filament/Renderer.h>
+
+#include <utils/compiler.h>
+#include <utils/Profiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * RenderPhaseCounters samples the CPU's hardware performance counters of the calling thread
+ * (normally the main thread) and attributes them to the phase of rendering being executed.
+ *
+ * Phases can be nested, in which case the counters are attributed to the innermost phase only.
+ * When disabled, push() and pop() are essentially free.
+ */
+class RenderPhaseCounters {
+public:
+    using Phase = Renderer::RenderPhase;
+    using Report = Renderer::PerformanceReport;
+
+    RenderPhaseCounters() noexcept;
+    ~RenderPhaseCounters() noexcept;
+
+    RenderPhaseCounters(RenderPhaseCounters const& rhs) = delete;
+    RenderPhaseCounters& operator=(RenderPhaseCounters const& rhs) = delete;
+
+    // returns false if the counters are not supported or not accessible on this platform
+    bool setEnabled(bool enabled) noexcept;
+
+    bool isEnabled() const noexcept { return mEnabled; }
+
+    // starts a new report
+    void beginFrame(uint32_t frameId) noexcept;
+
+    // the report for the frame started by the last beginFrame()
+    Report const& getReport() const noexcept { return mReport; }
+
+    // the counters are attributed to the given phase until the matching pop()
+    void push(Phase phase) noexcept {
+        if (UTILS_UNLIKELY(mEnabled)) {
+            pushSlow(phase);
+        }
+    }
+
+    void pop() noexcept {
+        if (UTILS_UNLIKELY(mEnabled)) {
+            popSlow();
+        }
+    }
+
+    class Scope {
+    public:
+        Scope(RenderPhaseCounters& counters, Phase phase) noexcept : mCounters(counters) {
+            counters.push(phase);
+        }
+        ~Scope() noexcept {
+            mCounters.pop();
+        }
+        Scope(Scope const& rhs) = delete;
+        Scope& operator=(Scope const& rhs) = delete;
+    private:
+        RenderPhaseCounters& mCounters;
+    };
+
+private:
+    static constexpr size_t MAX_DEPTH = 8;
+
+    void pushSlow(Phase phase) noexcept;
+    void popSlow() noexcept;
+
+    // attributes the counters since the last call to the current phase
+    void accumulate() noexcept;
+
+    utils::Profiler mProfiler;
+    utils::Profiler::Counters mLastCounters{};
+    Phase mStack[MAX_DEPTH] = {};
+    uint32_t mDepth = 0;
+    bool mEnabled = false;
+    Report mReport;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_RENDERPHASECOUNTERS_H
@@ -85,6 +85,10 @@ Renderer::ClearOptions const& Renderer::getClearOptions() const noexcept {
     return downcast(this)->getClearOptions();
 }
 
+Renderer::PerformanceReport const& Renderer::getPerformanceReport() const noexcept {
+    return downcast(this)->getPerformanceReport();
+}
+
 void Renderer::renderStandaloneView(View const* view) {
     downcast(this)->renderStandaloneView(downcast(view));
 }
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SamplerGroupCache.h"
+
+#include <backend/DriverEnums.h>
+
+#include <utils/CString.h>
+#include <utils/debug.h>
+#include <utils/Hash.h>
+
+#include <algorithm>
+
+using namespace utils;
+
+namespace filament {
+
+using namespace backend;
+
+SamplerGroupCache::SamplerGroupCache() noexcept = default;
+
+SamplerGroupCache::~SamplerGroupCache() noexcept {
+    assert_invariant(mEntries.empty());
+}
+
+void SamplerGroupCache::terminate(DriverApi& driver) noexcept {
+    for (auto const& item : mEntries) {
+        driver.destroySamplerGroup(SamplerGroupHandle{ item.first });
+    }
+    mIndex.clear();
+    mTextureIndex.clear();
+    mEntries.clear();
+}
+
+size_t SamplerGroupCache::hash(SamplerDescriptor const* data, size_t count) noexcept {
+    size_t seed = count;
+    for (size_t i = 0; i < count; i++) {
+        hash::combine_fast(seed, data[i].t.getId());
+        hash::combine_fast(seed, SamplerParams::Hasher{}(data[i].s));
+    }
+    return seed;
+}
+
+bool SamplerGroupCache::KeyEqualTo::operator()(Key const& lhs, Key const& rhs) const noexcept {
+    return lhs.hash == rhs.hash && lhs.count == rhs.count &&
+           std::equal(lhs.data, lhs.data + lhs.count, rhs.data,
+                   [](SamplerDescriptor const& a, SamplerDescriptor const& b) {
+                       return a.t == b.t && SamplerParams::EqualTo{}(a.s, b.s);
+                   });
+}
+
+void SamplerGroupCache::index(HandleId id, Entry& entry) {
+    assert_invariant(!entry.indexed);
+    entry.indexed = mIndex.insert({{ entry.samplers.data(), entry.samplers.size(), entry.hash },
+            id }).second;
+    if (entry.indexed) {
+        for (SamplerDescriptor const& d : entry.samplers) {
+            if (d.t) {
+                // a group can reference the same texture several times, it's listed once
+                std::vector<HandleId>& groups = mTextureIndex[d.t.getId()];
+                if (groups.empty() || groups.back() != id) {
+                    groups.push_back(id);
+                }
+            }
+        }
+    }
+}
+
+void SamplerGroupCache::unindex(Entry& entry) noexcept {
+    if (entry.indexed) {
+        auto pos = mIndex.find({ entry.samplers.data(), entry.samplers.size(), entry.hash });
+        assert_invariant(pos != mIndex.end());
+        HandleId const id = pos->second;
+        mIndex.erase(pos);
+        for (SamplerDescriptor const& d : entry.samplers) {
+            // the texture is gone from mTextureIndex if we're called from invalidate()
+            auto texture = d.t ? mTextureIndex.find(d.t.getId()) : mTextureIndex.end();
+            if (texture != mTextureIndex.end()) {
+                std::vector<HandleId>& groups = texture.value();
+                auto it = std::find(groups.begin(), groups.end(), id);
+                if (it != groups.end()) {
+                    *it = groups.back();
+                    groups.pop_back();
+                }
+                if (groups.empty()) {
+                    mTextureIndex.erase(texture);
+                }
+            }
+        }
+        entry.indexed = false;
+    }
+}
+
+SamplerGroupCache::SamplerGroupHandle SamplerGroupCache::acquire(DriverApi& driver,
+        SamplerGroup const& samplers, SamplerGroupHandle previous, CString const& name) {
+    Key const key{ samplers.data(), samplers.getSize(), hash(samplers.data(), samplers.getSize()) };
+
+    auto pos = mIndex.find(key);
+    if (pos != mIndex.end()) {
+        // these exact samplers are already in a group, no need to update anything
+        samplers.clean();
+        SamplerGroupHandle const handle{ pos->second };
+        if (handle != previous) {
+            mEntries[handle.getId()].refCount++;
+            if (previous) {
+                release(driver, previous);
+            }
+        }
+        return handle;
+    }
+
+    if (previous) {
+        auto prev = mEntries.find(previous.getId());
+        assert_invariant(prev != mEntries.end());
+        Entry& entry = prev.value();
+        if (entry.refCount == 1) {
+            // we're the only user of the previous group, just update it
+            unindex(entry);
+            std::copy_n(samplers.data(), samplers.getSize(), entry.samplers.data());
+            entry.hash = key.hash;
+            index(previous.getId(), entry);
+            driver.updateSamplerGroup(previous, samplers.toBufferDescriptor(driver));
+            return previous;
+        }
+        release(driver, previous);
+    }
+
+    SamplerGroupHandle const handle = driver.createSamplerGroup(
+            samplers.getSize(), FixedSizeString<32>(name.c_str_safe()));
+    driver.updateSamplerGroup(handle, samplers.toBufferDescriptor(driver));
+
+    Entry& entry = mEntries[handle.getId()];
+    entry.samplers = FixedCapacityVector<SamplerDescriptor>(samplers.getSize());
+    std::copy_n(samplers.data(), samplers.getSize(), entry.samplers.data());
+    entry.hash = key.hash;
+    entry.refCount = 1;
+    index(handle.getId(), entry);
+    return handle;
+}
+
+void SamplerGroupCache::release(DriverApi& driver, SamplerGroupHandle handle) noexcept {
+    auto pos = mEntries.find(handle.getId());
+    assert_invariant(pos != mEntries.end());
+    Entry& entry = pos.value();
+    assert_invariant(entry.refCount > 0);
+    if (--entry.refCount == 0) {
+        unindex(entry);
+        mEntries.erase(pos);
+        driver.destroySamplerGroup(handle);
+    }
+}
+
+void SamplerGroupCache::invalidate(TextureHandle texture) noexcept {
+    if (!texture) {
+        return;
+    }
+    auto pos = mTextureIndex.find(texture.getId());
+    if (pos == mTextureIndex.end()) {
+        return;
+    }
+    std::vector<HandleId> const groups = std::move(pos.value());
+    mTextureIndex.erase(pos);
+    for (HandleId const id : groups) {
+        auto it = mEntries.find(id);
+        assert_invariant(it != mEntries.end());
+        unindex(it.value());
+    }
+}
+
+} // namespace filament
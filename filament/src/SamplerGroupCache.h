@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_SAMPLERGROUPCACHE_H
+#define TNT_FILAMENT_SAMPLERGROUPCACHE_H
+
+#include "private/backend/DriverApi.h"
+#include "private/backend/SamplerGroup.h"
+
+#include <backend/Handle.h>
+#include <backend/SamplerDescriptor.h>
+
+#include <utils/CString.h>
+#include <utils/FixedCapacityVector.h>
+
+#include <tsl/robin_map.h>
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * SamplerGroupCache shares backend sampler groups between all the material instances that bind
+ * the same textures with the same sampler parameters. Groups are looked up by content and
+ * reference counted, a group is destroyed when its last user releases it.
+ *
+ * Texture handles are recycled by the backend, so the groups that reference a texture must be
+ * removed from the lookup table when that texture is destroyed (see invalidate()). Users that
+ * can't guarantee this (e.g. because they bind transient textures) must not use the cache.
+ */
+class SamplerGroupCache {
+public:
+    using SamplerGroupHandle = backend::Handle<backend::HwSamplerGroup>;
+    using TextureHandle = backend::Handle<backend::HwTexture>;
+
+    SamplerGroupCache() noexcept;
+    ~SamplerGroupCache() noexcept;
+
+    SamplerGroupCache(SamplerGroupCache const& rhs) = delete;
+    SamplerGroupCache& operator=(SamplerGroupCache const& rhs) = delete;
+
+    // Destroys the remaining groups, if any.
+    void terminate(backend::DriverApi& driver) noexcept;
+
+    // Returns a backend sampler group with the content of samplers and cleans its dirty flag.
+    // previous is the group the caller was using before (can be null), which is released. If the
+    // caller was the only user of previous, it is updated in place rather than recreated.
+    SamplerGroupHandle acquire(backend::DriverApi& driver,
+            backend::SamplerGroup const& samplers, SamplerGroupHandle previous,
+            utils::CString const& name);
+
+    // Releases a group obtained by acquire(), destroys it when it's no longer used.
+    void release(backend::DriverApi& driver, SamplerGroupHandle handle) noexcept;
+
+    // Must be called when a texture is destroyed. Groups referencing it are no longer shared,
+    // but stay valid for their current users. This only visits the groups referencing texture.
+    void invalidate(TextureHandle texture) noexcept;
+
+    // Number of live backend sampler groups
+    size_t getGroupCount() const noexcept { return mEntries.size(); }
+
+private:
+    using HandleId = backend::HandleBase::HandleId;
+
+    struct Entry {
+        utils::FixedCapacityVector<backend::SamplerDescriptor> samplers;
+        size_t hash = 0;
+        uint32_t refCount = 0;
+        bool indexed = false;
+    };
+
+    // Points to sampler descriptors owned either by an Entry or by the SamplerGroup of a lookup.
+    struct Key {
+        backend::SamplerDescriptor const* data;
+        size_t count;
+        size_t hash;
+    };
+
+    struct KeyHasher {
+        size_t operator()(Key const& key) const noexcept { return key.hash; }
+    };
+
+    struct KeyEqualTo {
+        bool operator()(Key const& lhs, Key const& rhs) const noexcept;
+    };
+
+    static size_t hash(backend::SamplerDescriptor const* data, size_t count) noexcept;
+
+    void index(HandleId id, Entry& entry);
+    void unindex(Entry& entry) noexcept;
+
+    // groups that can be shared, by content
+    tsl::robin_map<Key, HandleId, KeyHasher, KeyEqualTo> mIndex;
+    // groups that can be shared, by the textures they reference
+    tsl::robin_map<HandleId, std::vector<HandleId>> mTextureIndex;
+    // all the live groups, including the ones that are no longer shared
+    tsl::robin_map<HandleId, Entry> mEntries;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_SAMPLERGROUPCACHE_H
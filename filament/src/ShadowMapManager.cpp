@@ -364,6 +364,12 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FEngine& engine, FrameG
                     }
                 }
 
+                // The loop above left the shadow cameras' levels of detail in the shared
+                // renderable data. The color pass already has its commands, but the passes that
+                // build theirs later (structure, SSR) must use the main camera's levels.
+                view.updatePrimitivesLod(engine,
+                        mainCameraInfo, scene->getRenderableData(), view.getVisibleRenderables());
+
                 // Finally update our UBO in one batch
                 if (mShadowUb.isDirty()) {
                     driver.updateBufferObject(mShadowUbh,
@@ -23,10 +23,16 @@ using namespace filament::math;
 
 namespace filament {
 
+UniformBufferUploadStats& UniformBufferUploadStats::get() noexcept {
+    static UniformBufferUploadStats sStats;
+    return sStats;
+}
+
 UniformBuffer::UniformBuffer(size_t size) noexcept
         : mBuffer(mStorage),
           mSize(uint32_t(size)),
-          mSomethingDirty(true) {
+          mDirtyBegin(0),
+          mDirtyEnd(uint32_t(size)) {
     if (UTILS_LIKELY(size > sizeof(mStorage))) {
         mBuffer = UniformBuffer::alloc(size);
     }
@@ -36,7 +42,8 @@ UniformBuffer::UniformBuffer(size_t size) noexcept
 UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
         : mBuffer(rhs.mBuffer),
           mSize(rhs.mSize),
-          mSomethingDirty(rhs.mSomethingDirty) {
+          mDirtyBegin(rhs.mDirtyBegin),
+          mDirtyEnd(rhs.mDirtyEnd) {
     if (UTILS_LIKELY(rhs.isLocalStorage())) {
         mBuffer = mStorage;
         memcpy(mBuffer, rhs.mBuffer, mSize);
@@ -47,7 +54,8 @@ UniformBuffer::UniformBuffer(UniformBuffer&& rhs) noexcept
 
 UniformBuffer& UniformBuffer::operator=(UniformBuffer&& rhs) noexcept {
     if (this != &rhs) {
-        mSomethingDirty = rhs.mSomethingDirty;
+        mDirtyBegin = rhs.mDirtyBegin;
+        mDirtyEnd = rhs.mDirtyEnd;
         if (UTILS_LIKELY(rhs.isLocalStorage())) {
             mBuffer = mStorage;
             mSize = rhs.mSize;
@@ -24,6 +24,7 @@
 #include <utils/Allocator.h>
 #include <utils/compiler.h>
 #include <utils/Log.h>
+#include <utils/Range.h>
 #include <utils/debug.h>
 
 #include <backend/BufferDescriptor.h>
@@ -31,11 +32,29 @@
 #include <math/mat3.h>
 #include <math/mat4.h>
 
+#include <atomic>
+
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 namespace filament {
 
+// Process-wide counters for the uniform buffer commits that only upload their modified range,
+// reset every frame by FRenderer::endFrame(). bytesSaved is the amount of data that uploading the
+// whole buffers would have added.
+struct UniformBufferUploadStats {
+    std::atomic<uint64_t> bytesUploaded{};
+    std::atomic<uint64_t> bytesSaved{};
+
+    void record(size_t uploaded, size_t total) noexcept {
+        bytesUploaded.fetch_add(uploaded, std::memory_order_relaxed);
+        bytesSaved.fetch_add(total - uploaded, std::memory_order_relaxed);
+    }
+
+    static UniformBufferUploadStats& get() noexcept;
+};
+
 class UniformBuffer { // NOLINT(cppcoreguidelines-pro-type-member-init)
 public:
     UniformBuffer() noexcept = default;
@@ -69,7 +88,8 @@ public:
     // invalidate a range of uniforms and return a pointer to it. offset and size given in bytes
     void* invalidateUniforms(size_t offset, size_t size) {
         assert_invariant(offset + size <= mSize);
-        mSomethingDirty = true;
+        mDirtyBegin = std::min(mDirtyBegin, uint32_t(offset));
+        mDirtyEnd = std::max(mDirtyEnd, uint32_t(offset + size));
         return static_cast<char*>(mBuffer) + offset;
     }
 
@@ -84,10 +104,13 @@ public:
     size_t getSize() const noexcept { return mSize; }
 
     // return if any uniform has been changed
-    bool isDirty() const noexcept { return mSomethingDirty; }
+    bool isDirty() const noexcept { return mDirtyBegin < mDirtyEnd; }
 
     // mark the whole buffer as clean (no modified uniforms)
-    void clean() const noexcept { mSomethingDirty = false; }
+    void clean() const noexcept {
+        mDirtyBegin = UINT32_MAX;
+        mDirtyEnd = 0;
+    }
 
     /*
      * -----------------------------------------------
@@ -177,6 +200,23 @@ public:
         return p;
     }
 
+    // copy only the modified range of the UBO, rounded to vec4 boundaries, and cleans the dirty
+    // bits. The byte offset of the range is returned in outOffset.
+    backend::BufferDescriptor toDirtyBufferDescriptor(
+            backend::DriverApi& driver, size_t* outOffset) const noexcept {
+        utils::Range<size_t> const range = getDirtyRange();
+        UniformBufferUploadStats::get().record(range.size(), getSize());
+        *outOffset = range.first;
+        return toBufferDescriptor(driver, range.first, range.size());
+    }
+
+    // range of modified bytes, rounded to vec4 boundaries
+    utils::Range<size_t> getDirtyRange() const noexcept {
+        assert_invariant(isDirty());
+        return { mDirtyBegin & ~size_t(0xF),
+                 std::min((mDirtyEnd + size_t(0xF)) & ~size_t(0xF), getSize()) };
+    }
+
     // set uniform of known types to the proper offset (e.g.: use offsetof())
     template<size_t Size>
     void setUniformUntyped(size_t offset, void const* UTILS_RESTRICT v) noexcept;
@@ -203,7 +243,9 @@ private:
     char mStorage[96];
     void *mBuffer = nullptr;
     uint32_t mSize = 0;
-    mutable bool mSomethingDirty = false;
+    // range of modified bytes, empty when mDirtyBegin >= mDirtyEnd
+    mutable uint32_t mDirtyBegin = UINT32_MAX;
+    mutable uint32_t mDirtyEnd = 0;
 };
 
 // specialization for mat3f (which has a different alignment, see std140 layout rules)
@@ -47,9 +47,10 @@ void FCameraManager::terminate(FEngine& engine) noexcept {
     }
 }
 
-void FCameraManager::gc(FEngine& engine, utils::EntityManager& em) noexcept {
+size_t FCameraManager::gc(FEngine& engine, utils::EntityManager& em,
+        size_t maxScanned) noexcept {
     auto& manager = mManager;
-    manager.gc(em, [this, &engine](Entity e) {
+    return manager.incrementalGc(em, maxScanned, [this, &engine](Entity e) {
         destroy(engine, e);
     });
 }
@@ -46,7 +46,9 @@ public:
     // free-up all resources
     void terminate(FEngine& engine) noexcept;
 
-    void gc(FEngine& engine, utils::EntityManager& em) noexcept;
+    // removes the components of dead entities, scanning at most maxScanned components,
+    // returns the number of components removed.
+    size_t gc(FEngine& engine, utils::EntityManager& em, size_t maxScanned) noexcept;
 
     /*
     * Component Manager APIs
@@ -95,6 +97,7 @@ private:
 
     struct CameraManagerImpl : public Base {
         using Base::gc;
+        using Base::incrementalGc;
         using Base::swap;
         using Base::hasComponent;
     } mManager;
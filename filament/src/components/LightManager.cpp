@@ -226,8 +226,8 @@ void FLightManager::terminate() noexcept {
         }
     }
 }
-void FLightManager::gc(utils::EntityManager& em) noexcept {
-    mManager.gc(em, [this](Entity e) {
+size_t FLightManager::gc(utils::EntityManager& em, size_t maxScanned) noexcept {
+    return mManager.incrementalGc(em, maxScanned, [this](Entity e) {
         destroy(e);
     });
 }
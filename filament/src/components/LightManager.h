@@ -44,7 +44,9 @@ public:
 
     void terminate() noexcept;
 
-    void gc(utils::EntityManager& em) noexcept;
+    // removes the components of dead entities, scanning at most maxScanned components,
+    // returns the number of components removed.
+    size_t gc(utils::EntityManager& em, size_t maxScanned) noexcept;
 
     /*
      * Component Manager APIs
@@ -275,6 +277,7 @@ private:
 
     struct Sim : public Base {
         using Base::gc;
+        using Base::incrementalGc;
         using Base::swap;
 
         struct Proxy {
@@ -34,7 +34,9 @@
 #include <utils/Log.h>
 #include <utils/Panic.h>
 #include <utils/debug.h>
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 using namespace filament::math;
 using namespace utils;
@@ -67,6 +69,7 @@ struct RenderableManager::BuilderDetails {
     uint32_t mSkinningBufferOffset = 0;
     utils::FixedCapacityVector<math::float2> mBoneIndicesAndWeights;
     size_t mBoneIndicesAndWeightsCount = 0;
+    std::vector<FRenderableManager::LevelOfDetail> mLevelsOfDetail;
 
     // bone indices and weights defined for primitive index
     std::unordered_map<size_t, utils::FixedCapacityVector<
@@ -129,6 +132,17 @@ RenderableManager::Builder& RenderableManager::Builder::material(size_t index,
     return *this;
 }
 
+RenderableManager::Builder& RenderableManager::Builder::levelOfDetail(uint8_t level,
+        size_t primitiveCount, float screenSize) noexcept {
+    auto& levels = mImpl->mLevelsOfDetail;
+    if (level >= levels.size()) {
+        levels.resize(level + 1);
+    }
+    levels[level].screenSize = screenSize;
+    levels[level].count = uint32_t(primitiveCount);
+    return *this;
+}
+
 RenderableManager::Builder& RenderableManager::Builder::boundingBox(const Box& axisAlignedBoundingBox) noexcept {
     mImpl->mAABB = axisAlignedBoundingBox;
     return *this;
@@ -402,6 +416,21 @@ RenderableManager::Builder::Result RenderableManager::Builder::build(Engine& eng
                 mImpl->mInstanceCount, bufferInstanceCount);
     }
 
+    // Levels of detail must partition the primitives, from the largest screen size to the
+    // smallest.
+    auto& levels = mImpl->mLevelsOfDetail;
+    uint32_t levelOffset = 0;
+    for (size_t i = 0, c = levels.size(); i < c; i++) {
+        ASSERT_PRECONDITION(i == 0 || levels[i].screenSize < levels[i - 1].screenSize,
+                "[entity=%u] level of detail %zu must have a smaller screen size than level %zu",
+                entity.getId(), i, i - 1);
+        levels[i].offset = levelOffset;
+        levelOffset += levels[i].count;
+    }
+    ASSERT_PRECONDITION(levels.empty() || levelOffset == mImpl->mEntries.size(),
+            "[entity=%u] levels of detail have %u primitives, but the renderable has %zu",
+            entity.getId(), levelOffset, mImpl->mEntries.size());
+
     if (UTILS_LIKELY(mImpl->mSkinningBoneCount || mImpl->mSkinningBufferMode)) {
         mImpl->processBoneIndicesAndWights(engine, entity);
     }
@@ -508,6 +537,14 @@ void FRenderableManager::create(
         }
         setPrimitives(ci, { rp, size_type(entryCount) });
 
+        // A single level of detail is the same as none, and doesn't need to be stored.
+        auto const& levels = builder->mLevelsOfDetail;
+        if (UTILS_UNLIKELY(levels.size() > 1)) {
+            LevelOfDetail* const lods = new LevelOfDetail[levels.size()];
+            std::copy(levels.begin(), levels.end(), lods);
+            manager[ci].levelsOfDetail = { lods, Slice<LevelOfDetail>::size_type(levels.size()) };
+        }
+
         setAxisAlignedBoundingBox(ci, builder->mAABB);
         setLayerMask(ci, builder->mLayerMask);
         setPriority(ci, builder->mPriority);
@@ -680,8 +717,8 @@ void FRenderableManager::terminate() noexcept {
     mHwRenderPrimitiveFactory.terminate(mEngine.getDriverApi());
 }
 
-void FRenderableManager::gc(utils::EntityManager& em) noexcept {
-    mManager.gc(em, [this](Entity e) {
+size_t FRenderableManager::gc(utils::EntityManager& em, size_t maxScanned) noexcept {
+    return mManager.incrementalGc(em, maxScanned, [this](Entity e) {
         destroy(e);
     });
 }
@@ -696,6 +733,8 @@ void FRenderableManager::destroyComponent(Instance ci) noexcept {
     // See create(RenderableManager::Builder&, Entity)
     destroyComponentPrimitives(mHwRenderPrimitiveFactory, driver, manager[ci].primitives);
     destroyComponentMorphTargets(engine, manager[ci].morphTargets);
+    Slice<LevelOfDetail> const& levels = manager[ci].levelsOfDetail;
+    delete[] levels.data();
 
     // destroy the bones structures if any
     Bones const& bones = manager[ci].bones;
@@ -736,7 +775,7 @@ void FRenderableManager::destroyComponentMorphTargets(FEngine&,
 void FRenderableManager::setMaterialInstanceAt(Instance instance, uint8_t level,
         size_t primitiveIndex, FMaterialInstance const* mi) {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive>& primitives = getAllRenderPrimitives(instance);
         if (primitiveIndex < primitives.size()) {
             assert_invariant(mi);
             FMaterial const* material = mi->getMaterial();
@@ -761,7 +800,7 @@ void FRenderableManager::setMaterialInstanceAt(Instance instance, uint8_t level,
 MaterialInstance* FRenderableManager::getMaterialInstanceAt(
         Instance instance, uint8_t level, size_t primitiveIndex) const noexcept {
     if (instance) {
-        const Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        const Slice<FRenderPrimitive>& primitives = getAllRenderPrimitives(instance);
         if (primitiveIndex < primitives.size()) {
             // We store the material instance as const because we don't want to change it internally
             // but when the user queries it, we want to allow them to call setParameter()
@@ -774,7 +813,7 @@ MaterialInstance* FRenderableManager::getMaterialInstanceAt(
 void FRenderableManager::setBlendOrderAt(Instance instance, uint8_t level,
         size_t primitiveIndex, uint16_t order) noexcept {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive>& primitives = getAllRenderPrimitives(instance);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].setBlendOrder(order);
         }
@@ -784,7 +823,7 @@ void FRenderableManager::setBlendOrderAt(Instance instance, uint8_t level,
 void FRenderableManager::setGlobalBlendOrderEnabledAt(Instance instance, uint8_t level,
         size_t primitiveIndex, bool enabled) noexcept {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive>& primitives = getAllRenderPrimitives(instance);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].setGlobalBlendOrderEnabled(enabled);
         }
@@ -794,7 +833,7 @@ void FRenderableManager::setGlobalBlendOrderEnabledAt(Instance instance, uint8_t
 AttributeBitset FRenderableManager::getEnabledAttributesAt(
         Instance instance, uint8_t level, size_t primitiveIndex) const noexcept {
     if (instance) {
-        Slice<FRenderPrimitive> const& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive> const& primitives = getAllRenderPrimitives(instance);
         if (primitiveIndex < primitives.size()) {
             return primitives[primitiveIndex].getEnabledAttributes();
         }
@@ -806,7 +845,7 @@ void FRenderableManager::setGeometryAt(Instance instance, uint8_t level, size_t
         PrimitiveType type, FVertexBuffer* vertices, FIndexBuffer* indices,
         size_t offset, size_t count) noexcept {
     if (instance) {
-        Slice<FRenderPrimitive>& primitives = getRenderPrimitives(instance, level);
+        Slice<FRenderPrimitive>& primitives = getAllRenderPrimitives(instance);
         if (primitiveIndex < primitives.size()) {
             primitives[primitiveIndex].set(mHwRenderPrimitiveFactory, mEngine.getDriverApi(),
                     type, vertices, indices, offset, count);
@@ -914,7 +953,7 @@ void FRenderableManager::setMorphTargetBufferAt(Instance instance, uint8_t level
                 "Only %d morph targets can be set (count=%d)",
                 morphWeights.count, morphTargetBuffer->getCount());
 
-        Slice<MorphTargets>& morphTargets = getMorphTargets(instance, level);
+        Slice<MorphTargets>& morphTargets = getAllMorphTargets(instance);
         if (primitiveIndex < morphTargets.size()) {
             morphTargets[primitiveIndex] = { morphTargetBuffer, (uint32_t)offset,
                                              (uint32_t)count };
@@ -925,7 +964,7 @@ void FRenderableManager::setMorphTargetBufferAt(Instance instance, uint8_t level
 MorphTargetBuffer* FRenderableManager::getMorphTargetBufferAt(Instance instance, uint8_t level,
         size_t primitiveIndex) const noexcept {
     if (instance) {
-        const Slice<MorphTargets>& morphTargets = getMorphTargets(instance, level);
+        const Slice<MorphTargets>& morphTargets = getAllMorphTargets(instance);
         if (primitiveIndex < morphTargets.size()) {
             return morphTargets[primitiveIndex].buffer;
         }
@@ -962,7 +1001,50 @@ bool FRenderableManager::getLightChannel(Instance ci, unsigned int channel) cons
 }
 
 size_t FRenderableManager::getPrimitiveCount(Instance instance, uint8_t level) const noexcept {
-    return getRenderPrimitives(instance, level).size();
+    return getAllRenderPrimitives(instance).size();
+}
+
+FRenderableManager::LevelOfDetail FRenderableManager::getLevelOfDetail(
+        Instance instance, uint8_t level) const noexcept {
+    Slice<LevelOfDetail> const& levels = mManager[instance].levelsOfDetail;
+    if (UTILS_LIKELY(levels.empty())) {
+        // without levels of detail, level 0 is made of all the primitives
+        return { 0.0f, 0, level ? 0u : uint32_t(getAllRenderPrimitives(instance).size()) };
+    }
+    return level < levels.size() ? levels[level] : LevelOfDetail{};
+}
+
+Slice<FRenderPrimitive> FRenderableManager::getRenderPrimitives(
+        Instance instance, uint8_t level) const noexcept {
+    LevelOfDetail const lod = getLevelOfDetail(instance, level);
+    return { getAllRenderPrimitives(instance).data() + lod.offset, lod.count };
+}
+
+Slice<FRenderableManager::MorphTargets> FRenderableManager::getMorphTargets(
+        Instance instance, uint8_t level) const noexcept {
+    // morph targets are parallel to the primitives
+    LevelOfDetail const lod = getLevelOfDetail(instance, level);
+    return { getAllMorphTargets(instance).data() + lod.offset, lod.count };
+}
+
+uint8_t FRenderableManager::getLevelOfDetailForScreenSize(
+        Instance instance, float screenSize) const noexcept {
+    Slice<LevelOfDetail> const& levels = mManager[instance].levelsOfDetail;
+    // Levels are sorted by decreasing screen size, and there are only a handful of them.
+    uint8_t level = 0;
+    for (; level < levels.size(); level++) {
+        if (screenSize >= levels[level].screenSize) {
+            break;
+        }
+    }
+    // When the renderable is too small to be drawn, this is getLevelOfDetailCount(), which
+    // has no primitives.
+    return level;
+}
+
+size_t FRenderableManager::getLevelOfDetailCount(Instance instance) const noexcept {
+    Slice<LevelOfDetail> const& levels = mManager[instance].levelsOfDetail;
+    return std::max(size_t(1), size_t(levels.size()));
 }
 
 } // namespace filament
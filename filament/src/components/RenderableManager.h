@@ -69,6 +69,14 @@ public:
 
     static_assert(sizeof(Visibility) == sizeof(uint16_t), "Visibility should be 16 bits");
 
+    // Levels of detail are ranges of consecutive primitives. A level is drawn when the screen
+    // size of the renderable is at least screenSize, see Builder::levelOfDetail().
+    struct LevelOfDetail {
+        float screenSize = 0.0f;
+        uint32_t offset = 0;
+        uint32_t count = 0;
+    };
+
     struct MorphTargets {
         FMorphTargetBuffer* buffer = nullptr;
         uint32_t offset = 0;
@@ -81,7 +89,9 @@ public:
     // free-up all resources
     void terminate() noexcept;
 
-    void gc(utils::EntityManager& em) noexcept;
+    // removes the components of dead entities, scanning at most maxScanned components,
+    // returns the number of components removed.
+    size_t gc(utils::EntityManager& em, size_t maxScanned) noexcept;
 
     /*
      * Component Manager APIs
@@ -203,12 +213,23 @@ public:
     void setBlendOrderAt(Instance instance, uint8_t level, size_t primitiveIndex, uint16_t blendOrder) noexcept;
     void setGlobalBlendOrderEnabledAt(Instance instance, uint8_t level, size_t primitiveIndex, bool enabled) noexcept;
     AttributeBitset getEnabledAttributesAt(Instance instance, uint8_t level, size_t primitiveIndex) const noexcept;
-    inline utils::Slice<FRenderPrimitive> const& getRenderPrimitives(Instance instance, uint8_t level) const noexcept;
-    inline utils::Slice<FRenderPrimitive>& getRenderPrimitives(Instance instance, uint8_t level) noexcept;
-    inline utils::Slice<MorphTargets> const& getMorphTargets(Instance instance, uint8_t level) const noexcept;
-    inline utils::Slice<MorphTargets>& getMorphTargets(Instance instance, uint8_t level) noexcept;
+    size_t getLevelOfDetailCount(Instance instance) const noexcept;
+    inline bool hasLevelsOfDetail(Instance instance) const noexcept;
+    // returns the level of detail drawn at this screen size, getLevelOfDetailCount() if none
+    uint8_t getLevelOfDetailForScreenSize(Instance instance, float screenSize) const noexcept;
+    // primitives and morph targets of a level of detail, empty if the level doesn't exist
+    utils::Slice<FRenderPrimitive> getRenderPrimitives(Instance instance, uint8_t level) const noexcept;
+    utils::Slice<MorphTargets> getMorphTargets(Instance instance, uint8_t level) const noexcept;
 
 private:
+    // primitives and morph targets of all the levels of detail, which the primitive indices of
+    // the public API span
+    inline utils::Slice<FRenderPrimitive> const& getAllRenderPrimitives(Instance instance) const noexcept;
+    inline utils::Slice<FRenderPrimitive>& getAllRenderPrimitives(Instance instance) noexcept;
+    inline utils::Slice<MorphTargets> const& getAllMorphTargets(Instance instance) const noexcept;
+    inline utils::Slice<MorphTargets>& getAllMorphTargets(Instance instance) noexcept;
+    LevelOfDetail getLevelOfDetail(Instance instance, uint8_t level) const noexcept;
+
     void destroyComponent(Instance ci) noexcept;
     static void destroyComponentPrimitives(
             HwRenderPrimitiveFactory& factory, backend::DriverApi& driver,
@@ -241,7 +262,8 @@ private:
         VISIBILITY,             // user data
         PRIMITIVES,             // user data
         BONES,                  // filament data, UBO storing a pointer to the bones information
-        MORPH_TARGETS
+        MORPH_TARGETS,
+        LEVELS_OF_DETAIL        // user data, empty unless there are several levels of detail
     };
 
     using Base = utils::SingleInstanceComponentManager<
@@ -253,11 +275,13 @@ private:
             Visibility,                      // VISIBILITY
             utils::Slice<FRenderPrimitive>,  // PRIMITIVES
             Bones,                           // BONES
-            utils::Slice<MorphTargets>       // MORPH_TARGETS
+            utils::Slice<MorphTargets>,      // MORPH_TARGETS
+            utils::Slice<LevelOfDetail>      // LEVELS_OF_DETAIL
     >;
 
     struct Sim : public Base {
         using Base::gc;
+        using Base::incrementalGc;
         using Base::swap;
 
         struct Proxy {
@@ -277,6 +301,7 @@ private:
                 Field<PRIMITIVES>           primitives;
                 Field<BONES>                bones;
                 Field<MORPH_TARGETS>        morphTargets;
+                Field<LEVELS_OF_DETAIL>     levelsOfDetail;
             };
         };
 
@@ -436,7 +461,7 @@ inline uint32_t FRenderableManager::getBoneCount(Instance instance) const noexce
 FRenderableManager::MorphingBindingInfo
 FRenderableManager::getMorphingBufferInfo(Instance instance) const noexcept {
     MorphWeights const& morphWeights = mManager[instance].morphWeights;
-    utils::Slice<MorphTargets> const& morphTargets = getMorphTargets(instance, 0);
+    utils::Slice<MorphTargets> const morphTargets = getMorphTargets(instance, 0);
     return { morphWeights.handle, morphWeights.count, morphTargets.data() };
 }
 
@@ -445,23 +470,28 @@ FRenderableManager::getInstancesInfo(Instance instance) const noexcept {
     return mManager[instance].instances;
 }
 
-utils::Slice<FRenderPrimitive> const& FRenderableManager::getRenderPrimitives(
-        Instance instance, uint8_t level) const noexcept {
+bool FRenderableManager::hasLevelsOfDetail(Instance instance) const noexcept {
+    utils::Slice<LevelOfDetail> const& levels = mManager[instance].levelsOfDetail;
+    return !levels.empty();
+}
+
+utils::Slice<FRenderPrimitive> const& FRenderableManager::getAllRenderPrimitives(
+        Instance instance) const noexcept {
     return mManager[instance].primitives;
 }
 
-utils::Slice<FRenderPrimitive>& FRenderableManager::getRenderPrimitives(
-        Instance instance, uint8_t level) noexcept {
+utils::Slice<FRenderPrimitive>& FRenderableManager::getAllRenderPrimitives(
+        Instance instance) noexcept {
     return mManager[instance].primitives;
 }
 
-utils::Slice<FRenderableManager::MorphTargets> const& FRenderableManager::getMorphTargets(
-        Instance instance, uint8_t level) const noexcept {
+utils::Slice<FRenderableManager::MorphTargets> const& FRenderableManager::getAllMorphTargets(
+        Instance instance) const noexcept {
     return mManager[instance].morphTargets;
 }
 
-utils::Slice<FRenderableManager::MorphTargets>& FRenderableManager::getMorphTargets(
-        Instance instance, uint8_t level) noexcept {
+utils::Slice<FRenderableManager::MorphTargets>& FRenderableManager::getAllMorphTargets(
+        Instance instance) noexcept {
     return mManager[instance].morphTargets;
 }
 
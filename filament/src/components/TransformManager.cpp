@@ -470,8 +470,8 @@ void FTransformManager::validateNode(UTILS_UNUSED_IN_RELEASE Instance i) noexcep
 #endif
 }
 
-void FTransformManager::gc(utils::EntityManager& em) noexcept {
-    mManager.gc(em, [this](Entity e) {
+size_t FTransformManager::gc(utils::EntityManager& em, size_t maxScanned) noexcept {
+    return mManager.incrementalGc(em, maxScanned, [this](Entity e) {
                 destroy(e);
             });
 }
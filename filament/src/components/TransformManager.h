@@ -99,7 +99,9 @@ public:
 
     void commitLocalTransformTransaction() noexcept;
 
-    void gc(utils::EntityManager& em) noexcept;
+    // removes the components of dead entities, scanning at most maxScanned components,
+    // returns the number of components removed.
+    size_t gc(utils::EntityManager& em, size_t maxScanned) noexcept;
 
     utils::Slice<const math::mat4f> getWorldTransforms() const noexcept {
         return mManager.slice<WORLD>();
@@ -177,6 +179,7 @@ private:
 
     struct Sim : public Base {
         using Base::gc;
+        using Base::incrementalGc;
         using Base::swap;
 
         typename Base::SoA& getSoA() { return mData; }
@@ -483,6 +483,8 @@ void FEngine::shutdown() {
         cleanupResourceList(std::move(item.second));
     }
 
+    mSamplerGroupCache.terminate(driver);
+
     cleanupResourceListLocked(mFenceListLock, std::move(mFences));
 
     driver.destroyTexture(mDummyOneTexture);
@@ -550,11 +552,56 @@ void FEngine::prepare() {
 
 void FEngine::gc() {
     // Note: this runs in a Job
+    SYSTRACE_CALL();
+    SYSTRACE_CONTEXT();
+
+    // maximum number of components each manager checks per frame, the managers resume where they
+    // left off on the next frame.
+    constexpr size_t GC_SLICE_SIZE = 4096;
+
     auto& em = mEntityManager;
-    mRenderableManager.gc(em);
-    mLightManager.gc(em);
-    mTransformManager.gc(em);
-    mCameraManager.gc(*this, em);
+
+    // Each manager runs its gc in its own job. CameraManager destroys the transform components
+    // it owns, so TransformManager's gc runs after it.
+    struct {
+        size_t renderables = 0;
+        size_t lights = 0;
+        size_t cameras = 0;
+        size_t transforms = 0;
+    } reclaimed;
+
+    JobSystem& js = mJobSystem;
+    JobSystem::Job* parent = js.createJob();
+
+    JobSystem::Job* renderables = js.createJob(parent,
+            [this, &em, &reclaimed](JobSystem&, JobSystem::Job*) {
+                reclaimed.renderables = mRenderableManager.gc(em, GC_SLICE_SIZE);
+            });
+
+    JobSystem::Job* lights = js.createJob(parent,
+            [this, &em, &reclaimed](JobSystem&, JobSystem::Job*) {
+                reclaimed.lights = mLightManager.gc(em, GC_SLICE_SIZE);
+            });
+
+    JobSystem::Job* cameras = js.createJob(parent,
+            [this, &em, &reclaimed](JobSystem&, JobSystem::Job*) {
+                reclaimed.cameras = mCameraManager.gc(*this, em, GC_SLICE_SIZE);
+            });
+
+    js.runAfter(js.createJob(parent,
+            [this, &em, &reclaimed](JobSystem&, JobSystem::Job*) {
+                reclaimed.transforms = mTransformManager.gc(em, GC_SLICE_SIZE);
+            }), { cameras });
+
+    js.run(renderables);
+    js.run(lights);
+    js.run(cameras);
+    js.runAndWait(parent);
+
+    SYSTRACE_VALUE32("gc.renderables", reclaimed.renderables);
+    SYSTRACE_VALUE32("gc.lights", reclaimed.lights);
+    SYSTRACE_VALUE32("gc.cameras", reclaimed.cameras);
+    SYSTRACE_VALUE32("gc.transforms", reclaimed.transforms);
 }
 
 void FEngine::flush() {
@@ -562,6 +609,78 @@ void FEngine::flush() {
     flushCommandBuffer(mCommandBufferQueue);
 }
 
+void FEngine::updateFrameMemoryUsage() noexcept {
+    auto& listener = mPerRenderPassArena.getListener();
+    mFrameMemoryUsage = {
+            .perRenderPassArenaPeak = listener.getHighWatermark(),
+            .perRenderPassArenaSize = getPerRenderPassArenaSize(),
+            .perFrameCommandsPeak = mCommandsHighWatermark,
+            .perFrameCommandsSize = getPerFrameCommandsSize(),
+            .commandBufferPeak = mCommandBufferQueue.getAndResetPeriodHighWatermark(),
+            .commandBufferSize = getCommandBufferSize(),
+    };
+    listener.resetHighWatermark();
+    mCommandsHighWatermark = 0;
+
+    uint32_t const maxArenaSizeMB = mConfig.perRenderPassArenaMaxSizeMB;
+    if (UTILS_LIKELY(maxArenaSizeMB <= mConfig.perRenderPassArenaSizeMB)) {
+        return;
+    }
+
+    auto const [newArenaSizeMB, newCommandsSizeMB] = growPerRenderPassArena(mFrameMemoryUsage,
+            { mConfig.perRenderPassArenaSizeMB, mConfig.perFrameCommandsSizeMB }, maxArenaSizeMB);
+
+    if (newArenaSizeMB == mConfig.perRenderPassArenaSizeMB &&
+            newCommandsSizeMB == mConfig.perFrameCommandsSizeMB) {
+        return;
+    }
+
+    slog.i << "Growing the per-render-pass arena to " << newArenaSizeMB << " MiB ("
+           << newCommandsSizeMB << " MiB of commands)" << io::endl;
+
+    mConfig.perRenderPassArenaSizeMB = newArenaSizeMB;
+    mConfig.perFrameCommandsSizeMB = newCommandsSizeMB;
+
+    // no RootArenaScope is alive at this point, so the arena can be replaced
+    RootArenaScope::Arena arena("FEngine::mPerRenderPassAllocator", getPerRenderPassArenaSize());
+    swap(mPerRenderPassArena, arena);
+}
+
+FEngine::PerRenderPassArenaSize FEngine::growPerRenderPassArena(FrameMemoryUsage const& usage,
+        PerRenderPassArenaSize current, uint32_t maxArenaSizeMB) noexcept {
+    // we grow a buffer when more than 3/4 of it was used, to 1.5 times its peak usage
+    auto const grownSizeMB = [](size_t peak, size_t size, uint32_t sizeMB) -> uint32_t {
+        if (peak <= size - size / 4) {
+            return sizeMB;
+        }
+        return std::max(sizeMB, uint32_t((peak + peak / 2 + MiB - 1) / MiB));
+    };
+
+    uint32_t const commandsSizeMB = current.commandsSizeMB;
+    uint32_t const otherSizeMB = current.arenaSizeMB - commandsSizeMB;
+
+    // the per-frame commands are allocated from the per-render-pass arena, so we look at
+    // the rest of the arena separately.
+    size_t const otherPeak = usage.perRenderPassArenaPeak -
+            std::min(usage.perRenderPassArenaPeak, usage.perFrameCommandsSize);
+
+    uint32_t const wantedCommandsSizeMB = grownSizeMB(
+            usage.perFrameCommandsPeak, usage.perFrameCommandsSize, commandsSizeMB);
+    uint32_t const newOtherSizeMB = grownSizeMB(
+            otherPeak, otherSizeMB * MiB, otherSizeMB);
+
+    uint32_t const newArenaSizeMB = std::max(current.arenaSizeMB,
+            std::min(maxArenaSizeMB, wantedCommandsSizeMB + newOtherSizeMB));
+
+    // when the maximum size is reached, the commands only get what the rest of the arena
+    // doesn't need; neither part ever shrinks.
+    uint32_t const newCommandsSizeMB = std::max(commandsSizeMB,
+            std::min(wantedCommandsSizeMB, newArenaSizeMB - std::min(newArenaSizeMB,
+                    std::max(newOtherSizeMB, otherSizeMB))));
+
+    return { newArenaSizeMB, newCommandsSizeMB };
+}
+
 void FEngine::flushAndWait() {
 
 #if defined(__ANDROID__)
@@ -1248,8 +1367,6 @@ Engine* Engine::Builder::build() const {
 }
 
 Engine::Config Engine::BuilderDetails::validateConfig(const Config* const pConfig) noexcept {
-    // Rule of thumb: perRenderPassArenaMB must be roughly 1 MB larger than perFrameCommandsMB
-    constexpr uint32_t COMMAND_ARENA_OVERHEAD = 1;
     constexpr uint32_t CONCURRENT_FRAME_COUNT = 3;
 
     Config config;
@@ -1280,7 +1397,7 @@ Engine::Config Engine::BuilderDetails::validateConfig(const Config* const pConfi
     // Enforce pre-render-pass arena rule-of-thumb
     config.perRenderPassArenaSizeMB = std::max(
             config.perRenderPassArenaSizeMB,
-            config.perFrameCommandsSizeMB + COMMAND_ARENA_OVERHEAD);
+            config.perFrameCommandsSizeMB + FEngine::COMMAND_ARENA_OVERHEAD_MB);
 
     // This value gets validated during driver creation, so pass it through
     config.driverHandleArenaSizeMB = config.driverHandleArenaSizeMB;
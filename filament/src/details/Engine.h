@@ -22,7 +22,9 @@
 #include "Allocators.h"
 #include "DFG.h"
 #include "PostProcessManager.h"
+#include "RenderPhaseCounters.h"
 #include "ResourceList.h"
+#include "SamplerGroupCache.h"
 
 #include "components/CameraManager.h"
 #include "components/LightManager.h"
@@ -63,6 +65,7 @@
 #include <utils/JobSystem.h>
 #include <utils/CountDownLatch.h>
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <new>
@@ -139,6 +142,8 @@ public:
 
     DFG const& getDFG() const noexcept { return mDFG; }
 
+    SamplerGroupCache& getSamplerGroupCache() noexcept { return mSamplerGroupCache; }
+
     // the per-frame Area is used by all Renderer, so they must run in sequence and
     // have freed all allocated memory when done. If this needs to change in the future,
     // we'll simply have to use separate Areas (for instance).
@@ -411,6 +416,8 @@ public:
     backend::Handle<backend::HwTexture> getZeroTextureArray() const { return mDummyZeroTextureArray; }
 
     static constexpr const size_t MiB = 1024u * 1024u;
+    // Rule of thumb: the per-render-pass arena must be roughly 1 MiB larger than the commands
+    static constexpr const uint32_t COMMAND_ARENA_OVERHEAD_MB = 1;
     size_t getMinCommandBufferSize() const noexcept { return mConfig.minCommandBufferSizeMB * MiB; }
     size_t getCommandBufferSize() const noexcept { return mConfig.commandBufferSizeMB * MiB; }
     size_t getPerFrameCommandsSize() const noexcept { return mConfig.perFrameCommandsSizeMB * MiB; }
@@ -418,6 +425,30 @@ public:
     size_t getRequestedDriverHandleArenaSize() const noexcept { return mConfig.driverHandleArenaSizeMB * MiB; }
     Config const& getConfig() const noexcept { return mConfig; }
 
+    FrameMemoryUsage getFrameMemoryUsage() const noexcept { return mFrameMemoryUsage; }
+
+    // called by each render pass with the high watermark of its commands arena
+    void recordCommandsHighWatermark(size_t watermark) noexcept {
+        mCommandsHighWatermark = std::max(mCommandsHighWatermark, watermark);
+    }
+
+    // latches the per-frame memory usage and grows the per-render-pass arena if allowed.
+    // Must be called between frames, when no RootArenaScope is alive.
+    void updateFrameMemoryUsage() noexcept;
+
+    struct PerRenderPassArenaSize {
+        uint32_t arenaSizeMB;       // the whole per-render-pass arena
+        uint32_t commandsSizeMB;    // the part of it used by the per-frame commands
+    };
+
+    // Computes the per-render-pass arena size after a frame with the given memory usage, up to
+    // maxArenaSizeMB. Neither the per-frame commands nor the rest of the arena ever shrink.
+    static PerRenderPassArenaSize growPerRenderPassArena(FrameMemoryUsage const& usage,
+            PerRenderPassArenaSize current, uint32_t maxArenaSizeMB) noexcept;
+
+    RenderPhaseCounters& getRenderPhaseCounters() noexcept { return mRenderPhaseCounters; }
+    RenderPhaseCounters const& getRenderPhaseCounters() const noexcept { return mRenderPhaseCounters; }
+
     bool hasFeatureLevel(backend::FeatureLevel neededFeatureLevel) const noexcept {
         return FEngine::getActiveFeatureLevel() >= neededFeatureLevel;
     }
@@ -503,6 +534,9 @@ private:
 
     DFG mDFG;
 
+    // sampler groups shared between material instances
+    SamplerGroupCache mSamplerGroupCache;
+
     std::thread mDriverThread;
     backend::CommandBufferQueue mCommandBufferQueue;
     std::aligned_storage<sizeof(DriverApi), alignof(DriverApi)>::type mDriverApiStorage;
@@ -513,6 +547,10 @@ private:
     RootArenaScope::Arena mPerRenderPassArena;
     HeapAllocatorArena mHeapAllocator;
 
+    FrameMemoryUsage mFrameMemoryUsage;
+    size_t mCommandsHighWatermark = 0;
+    RenderPhaseCounters mRenderPhaseCounters;
+
     utils::JobSystem mJobSystem;
     static uint32_t getJobSystemThreadPoolSize(Engine::Config const& config) noexcept;
 
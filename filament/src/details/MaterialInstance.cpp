@@ -73,8 +73,7 @@ FMaterialInstance::FMaterialInstance(FEngine& engine,
 
     if (!material->getSamplerInterfaceBlock().isEmpty()) {
         mSamplers = other->getSamplerGroup();
-        mSbHandle = driver.createSamplerGroup(
-                mSamplers.getSize(), utils::FixedSizeString<32>(mMaterial->getName().c_str_safe()));
+        initSamplerGroup(engine, other->mHasSharedSamplerGroup);
     }
 
     if (material->hasDoubleSidedCapability()) {
@@ -116,8 +115,7 @@ void FMaterialInstance::initDefaultInstance(FEngine& engine, FMaterial const* ma
 
     if (!material->getSamplerInterfaceBlock().isEmpty()) {
         mSamplers = SamplerGroup(material->getSamplerInterfaceBlock().getSize());
-        mSbHandle = driver.createSamplerGroup(
-                mSamplers.getSize(), utils::FixedSizeString<32>(mMaterial->getName().c_str_safe()));
+        initSamplerGroup(engine, true);
     }
 
     const RasterState& rasterState = material->getRasterState();
@@ -158,16 +156,49 @@ FMaterialInstance::~FMaterialInstance() noexcept = default;
 void FMaterialInstance::terminate(FEngine& engine) {
     FEngine::DriverApi& driver = engine.getDriverApi();
     driver.destroyBufferObject(mUbHandle);
-    driver.destroySamplerGroup(mSbHandle);
+    if (mSbHandle) {
+        if (mHasSharedSamplerGroup) {
+            engine.getSamplerGroupCache().release(driver, mSbHandle);
+        } else {
+            driver.destroySamplerGroup(mSbHandle);
+        }
+    }
+}
+
+void FMaterialInstance::initSamplerGroup(FEngine& engine, bool shared) {
+    FEngine::DriverApi& driver = engine.getDriverApi();
+    mHasSharedSamplerGroup = shared;
+    if (shared) {
+        mSbHandle = engine.getSamplerGroupCache().acquire(
+                driver, mSamplers, {}, mMaterial->getName());
+    } else {
+        mSbHandle = driver.createSamplerGroup(
+                mSamplers.getSize(), utils::FixedSizeString<32>(mMaterial->getName().c_str_safe()));
+        driver.updateSamplerGroup(mSbHandle, mSamplers.toBufferDescriptor(driver));
+    }
 }
 
 void FMaterialInstance::commitSlow(DriverApi& driver) const {
     // update uniforms if needed
     if (mUniforms.isDirty()) {
-        driver.updateBufferObject(mUbHandle, mUniforms.toBufferDescriptor(driver), 0);
+        if (mMaterial->getEngine().getBackend() == Backend::OPENGL) {
+            // A partial update is a glBufferSubData(), which stalls if the GPU still uses the
+            // buffer, while a full update orphans it. The few bytes saved aren't worth it.
+            driver.updateBufferObject(mUbHandle, mUniforms.toBufferDescriptor(driver), 0);
+        } else {
+            size_t offset;
+            auto data = mUniforms.toDirtyBufferDescriptor(driver, &offset);
+            driver.updateBufferObject(mUbHandle, std::move(data), offset);
+        }
     }
     if (mSamplers.isDirty()) {
-        driver.updateSamplerGroup(mSbHandle, mSamplers.toBufferDescriptor(driver));
+        if (UTILS_LIKELY(mHasSharedSamplerGroup)) {
+            // this switches to the group that has our new samplers, creating it if needed
+            mSbHandle = mMaterial->getEngine().getSamplerGroupCache().acquire(
+                    driver, mSamplers, mSbHandle, mMaterial->getName());
+        } else {
+            driver.updateSamplerGroup(mSbHandle, mSamplers.toBufferDescriptor(driver));
+        }
     }
 }
 
@@ -175,6 +206,13 @@ void FMaterialInstance::commitSlow(DriverApi& driver) const {
 
 void FMaterialInstance::setParameter(std::string_view name,
         backend::Handle<backend::HwTexture> texture, backend::SamplerParams params) noexcept {
+    if (UTILS_UNLIKELY(mHasSharedSamplerGroup && mSbHandle)) {
+        // We can't know when this texture is destroyed, so we can't share our samplers anymore.
+        FEngine& engine = mMaterial->getEngine();
+        FEngine::DriverApi& driver = engine.getDriverApi();
+        engine.getSamplerGroupCache().release(driver, mSbHandle);
+        initSamplerGroup(engine, false);
+    }
     size_t const index = mMaterial->getSamplerInterfaceBlock().getSamplerInfo(name)->offset;
     mSamplers.setSampler(index, { texture, params });
 }
@@ -206,7 +244,10 @@ void FMaterialInstance::setParameterImpl(std::string_view name,
     if (UTILS_LIKELY(texture)) {
         handle = texture->getHwHandle();
     }
-    setParameter(name, handle, sampler.getSamplerParams());
+    // FTexture invalidates the shared sampler groups that use it when it's destroyed, so we don't
+    // go through setParameter() here.
+    size_t const index = mMaterial->getSamplerInterfaceBlock().getSamplerInfo(name)->offset;
+    mSamplers.setSampler(index, { handle, sampler.getSamplerParams() });
 }
 
 void FMaterialInstance::setMaskThreshold(float threshold) noexcept {
@@ -63,12 +63,28 @@ public:
         }
     }
 
+    // Same as above, but skips binding the sampler group if it's already bound. This is common
+    // because instances that use the same textures share their sampler group.
+    void use(FEngine::DriverApi& driver,
+            backend::Handle<backend::HwSamplerGroup>& boundSamplerGroup) const {
+        if (mUbHandle) {
+            driver.bindUniformBuffer(+UniformBindingPoints::PER_MATERIAL_INSTANCE, mUbHandle);
+        }
+        if (mSbHandle && mSbHandle != boundSamplerGroup) {
+            driver.bindSamplers(+SamplerBindingPoints::PER_MATERIAL_INSTANCE, mSbHandle);
+            boundSamplerGroup = mSbHandle;
+        }
+    }
+
     FMaterial const* getMaterial() const noexcept { return mMaterial; }
 
     uint64_t getSortingKey() const noexcept { return mMaterialSortingKey; }
 
     UniformBuffer const& getUniformBuffer() const noexcept { return mUniforms; }
     backend::SamplerGroup const& getSamplerGroup() const noexcept { return mSamplers; }
+    backend::Handle<backend::HwSamplerGroup> getSamplerGroupHandle() const noexcept {
+        return mSbHandle;
+    }
 
     void setScissor(uint32_t left, uint32_t bottom, uint32_t width, uint32_t height) noexcept {
         constexpr uint32_t maxvalu = std::numeric_limits<int32_t>::max();
@@ -236,11 +252,15 @@ private:
 
     void commitSlow(FEngine::DriverApi& driver) const;
 
+    void initSamplerGroup(FEngine& engine, bool shared);
+
     // keep these grouped, they're accessed together in the render-loop
     FMaterial const* mMaterial = nullptr;
 
     backend::Handle<backend::HwBufferObject> mUbHandle;
-    backend::Handle<backend::HwSamplerGroup> mSbHandle;
+    // when shared, this handle is owned by the engine's SamplerGroupCache and changes with the
+    // content of mSamplers
+    mutable backend::Handle<backend::HwSamplerGroup> mSbHandle;
     UniformBuffer mUniforms;
     backend::SamplerGroup mSamplers;
 
@@ -259,6 +279,10 @@ private:
     bool mIsDoubleSided : 1;
     TransparencyMode mTransparencyMode : 2;
 
+    // The sampler group is shared with other instances, until a texture handle that's not owned
+    // by a FTexture is set, since the cache can't track its lifetime.
+    bool mHasSharedSamplerGroup = true;
+
     uint64_t mMaterialSortingKey = 0;
 
     // Scissor rectangle is specified as: Left Bottom Width Height.
@@ -22,7 +22,9 @@
 #include "PostProcessManager.h"
 #include "RendererUtils.h"
 #include "RenderPass.h"
+#include "RenderPhaseCounters.h"
 #include "ResourceAllocator.h"
+#include "UniformBuffer.h"
 
 #include "details/Engine.h"
 #include "details/Fence.h"
@@ -243,6 +245,8 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
     FEngine& engine = mEngine;
     FEngine::DriverApi& driver = engine.getDriverApi();
 
+    engine.getRenderPhaseCounters().beginFrame(mFrameId);
+
     // start a frame capture, if requested.
     if (UTILS_UNLIKELY(engine.debug.renderer.doFrameCapture)) {
         driver.startCapture();
@@ -309,6 +313,7 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
 
 void FRenderer::endFrame() {
     SYSTRACE_CALL();
+    SYSTRACE_CONTEXT();
 
     if (UTILS_UNLIKELY(mBeginFrameInternal)) {
         mBeginFrameInternal();
@@ -332,6 +337,13 @@ void FRenderer::endFrame() {
     mFrameInfoManager.endFrame(driver);
     mFrameSkipper.endFrame(driver);
 
+    // report the uniform data partial uploads sent this frame, and how much they saved
+    UniformBufferUploadStats& uboStats = UniformBufferUploadStats::get();
+    SYSTRACE_VALUE64("uboBytesUploaded",
+            uboStats.bytesUploaded.exchange(0, std::memory_order_relaxed));
+    SYSTRACE_VALUE64("uboBytesSaved",
+            uboStats.bytesSaved.exchange(0, std::memory_order_relaxed));
+
     driver.endFrame(mFrameId);
 
     // gives the backend a chance to execute periodic tasks
@@ -352,10 +364,18 @@ void FRenderer::endFrame() {
 
     auto *job = js.runAndRetain(jobs::createJob(js, nullptr, &FEngine::gc, &engine)); // gc all managers
 
-    engine.flush();     // flush command stream
+    {
+        RenderPhaseCounters::Scope phase(engine.getRenderPhaseCounters(), RenderPhase::FLUSH);
+        engine.flush();     // flush command stream
+    }
 
     // make sure we're done with the gcs
     js.waitAndRelease(job);
+
+    // latch this frame's arenas usage, this may grow the per-render-pass arena
+    engine.updateFrameMemoryUsage();
+
+    mPerformanceReport = engine.getRenderPhaseCounters().getReport();
 }
 
 void FRenderer::readPixels(uint32_t xoffset, uint32_t yoffset, uint32_t width, uint32_t height,
@@ -438,6 +458,7 @@ void FRenderer::renderStandaloneView(FView const* view) {
 
         // ask the engine to do what it needs to (e.g. updates light buffer, materials...)
         FEngine& engine = mEngine;
+        engine.getRenderPhaseCounters().beginFrame(mFrameId);
         engine.prepare();
 
         FEngine::DriverApi& driver = engine.getDriverApi();
@@ -446,6 +467,10 @@ void FRenderer::renderStandaloneView(FView const* view) {
         renderInternal(view);
 
         driver.endFrame(mFrameId);
+
+        engine.updateFrameMemoryUsage();
+
+        mPerformanceReport = engine.getRenderPhaseCounters().getReport();
     }
 }
 
@@ -486,7 +511,10 @@ void FRenderer::renderInternal(FView const* view) {
     renderJob(rootArenaScope, const_cast<FView&>(*view));
 
     // make sure to flush the command buffer
-    engine.flush();
+    {
+        RenderPhaseCounters::Scope phase(engine.getRenderPhaseCounters(), RenderPhase::FLUSH);
+        engine.flush();
+    }
 
     // and wait for all jobs to finish as a safety (this should be a no-op)
     js.runAndWait(rootJob);
@@ -498,6 +526,10 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     FEngine::DriverApi& driver = engine.getDriverApi();
     PostProcessManager& ppm = engine.getPostProcessManager();
 
+    // everything not attributed to a more specific phase below is attributed to EXECUTE
+    RenderPhaseCounters& counters = engine.getRenderPhaseCounters();
+    RenderPhaseCounters::Scope executePhase(counters, RenderPhase::EXECUTE);
+
     // DEBUG: driver commands must all happen from the same thread. Enforce that on debug builds.
     driver.debugThreading();
 
@@ -657,7 +689,9 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
         xvp.bottom = int32_t(guardBand);
     }
 
+    counters.push(RenderPhase::PREPARE);
     view.prepare(engine, driver, rootArenaScope, svp, cameraInfo, getShaderUserTime(), needsAlphaChannel);
+    counters.pop();
 
     view.prepareUpscaler(scale, taaOptions, dsrOptions);
 
@@ -1198,7 +1232,9 @@ void FRenderer::renderJob(RootArenaScope& rootArenaScope, FView& view) {
     // save the current history entry and destroy the oldest entry
     view.commitFrameHistory(engine);
 
-    recordHighWatermark(commandArena.getListener().getHighWatermark());
+    size_t const commandsHighWatermark = commandArena.getListener().getHighWatermark();
+    recordHighWatermark(commandsHighWatermark);
+    engine.recordCommandsHighWatermark(commandsHighWatermark);
 }
 
 } // namespace filament
@@ -131,6 +131,10 @@ public:
         return mClearOptions;
     }
 
+    PerformanceReport const& getPerformanceReport() const noexcept {
+        return mPerformanceReport;
+    }
+
 private:
     friend class Renderer;
     using Command = RenderPass::Command;
@@ -183,6 +187,7 @@ private:
     DisplayInfo mDisplayInfo;
     FrameRateOptions mFrameRateOptions;
     ClearOptions mClearOptions;
+    PerformanceReport mPerformanceReport;
     backend::TargetBufferFlags mDiscardStartFlags{};
     backend::TargetBufferFlags mClearFlags{};
     tsl::robin_set<FRenderTarget*> mPreviousRenderTargets;
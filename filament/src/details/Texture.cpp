@@ -221,6 +221,7 @@ FTexture::FTexture(FEngine& engine, const Builder& builder) {
 // frees driver resources, object becomes invalid
 void FTexture::terminate(FEngine& engine) {
     FEngine::DriverApi& driver = engine.getDriverApi();
+    engine.getSamplerGroupCache().invalidate(mHandle);
     driver.destroyTexture(mHandle);
 }
 
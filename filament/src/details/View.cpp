@@ -46,6 +46,7 @@
 
 #include <array>
 #include <memory>
+#include <limits>
 
 using namespace utils;
 
@@ -497,14 +498,17 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
         float* const distances = rootArenaScope.allocate<float>(
                 (positionalLightCount + 3u) & ~3u, CACHELINE_SIZE);
 
-        prepareVisibleLightsJob = js.runAndRetain(js.createJob(nullptr,
+        prepareVisibleLightsJob = js.createJob(nullptr,
                 [&engine, distances, positionalLightCount, &viewMatrix = cameraInfo.view, &cullingFrustum,
                  &lightData = scene->getLightData()]
                         (JobSystem&, JobSystem::Job*) {
                     FView::prepareVisibleLights(engine.getLightManager(),
                             { distances, distances + positionalLightCount },
                             viewMatrix, cullingFrustum, lightData);
-                }));
+                });
+        // culling is on the critical path of the frame, don't let background work delay it
+        js.setPriority(prepareVisibleLightsJob, JobSystem::JobPriority::CRITICAL);
+        prepareVisibleLightsJob = js.runAndRetain(prepareVisibleLightsJob);
     }
 
     // this is used later (in Renderer.cpp) to wait for froxelization to finishes
@@ -515,6 +519,10 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
 
     { // all the operations in this scope must happen sequentially
 
+        // culling, shadow casters culling and partitioning, for the performance counters
+        RenderPhaseCounters& counters = engine.getRenderPhaseCounters();
+        counters.push(RenderPhaseCounters::Phase::CULLING);
+
         Slice<Culler::result_type> cullingMask = renderableData.slice<FScene::VISIBLE_MASK>();
         std::uninitialized_fill(cullingMask.begin(), cullingMask.end(), 0);
 
@@ -563,7 +571,9 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
                             (JobSystem&, JobSystem::Job*) {
                         froxelizer.froxelizeLights(engine, viewMatrix, lightData);
                     };
-            froxelizeLightsJob = js.runAndRetain(js.createJob(nullptr, std::move(froxelizerWork)));
+            froxelizeLightsJob = js.createJob(nullptr, std::move(froxelizerWork));
+            js.setPriority(froxelizeLightsJob, JobSystem::JobPriority::CRITICAL);
+            froxelizeLightsJob = js.runAndRetain(froxelizeLightsJob);
         }
 
         setFroxelizerSync(froxelizeLightsJob);
@@ -636,6 +646,8 @@ void FView::prepare(FEngine& engine, DriverApi& driver, RootArenaScope& rootAren
 
         SYSTRACE_NAME_END();
 
+        counters.pop();
+
         // TODO: when any spotlight is used, `merged` ends-up being the whole list. However,
         //       some of the items will end-up not being visible by any light. Can we do better?
         //       e.g. could we deffer some of the prepareVisibleRenderables() to later?
@@ -987,13 +999,33 @@ inline void FView::computeLightCameraDistances(
     }
 }
 
-void FView::updatePrimitivesLod(FEngine& engine, const CameraInfo&,
+void FView::updatePrimitivesLod(FEngine& engine, const CameraInfo& camera,
         FScene::RenderableSoa& renderableData, Range visible) noexcept {
     FRenderableManager const& rcm = engine.getRenderableManager();
+    mat4f const& p = camera.projection;
     for (uint32_t const index : visible) {
-        uint8_t const level = 0; // TODO: pick the proper level of detail
         auto ri = renderableData.elementAt<FScene::RENDERABLE_INSTANCE>(index);
+        if (UTILS_LIKELY(!rcm.hasLevelsOfDetail(ri))) {
+            renderableData.elementAt<FScene::PRIMITIVES>(index) = rcm.getRenderPrimitives(ri, 0);
+            continue;
+        }
+
+        // The screen size is the diameter of the bounding sphere projected on screen, as a
+        // fraction of the viewport height. This works for both perspective (w is the distance
+        // to the camera) and orthographic (w is 1) projections, e.g. for directional shadows.
+        float3 const center = renderableData.elementAt<FScene::WORLD_AABB_CENTER>(index);
+        float3 const extent = renderableData.elementAt<FScene::WORLD_AABB_EXTENT>(index);
+        float4 const v = camera.view * float4{ center, 1.0f };
+        float const w = p[0][3] * v.x + p[1][3] * v.y + p[2][3] * v.z + p[3][3] * v.w;
+        float const screenSize = w > 0.0f ?
+                length(extent) * p[1][1] / w : std::numeric_limits<float>::infinity();
+
+        // the morph targets of the level must be selected along with its primitives, because
+        // RenderPass looks them up by primitive index
+        uint8_t const level = rcm.getLevelOfDetailForScreenSize(ri, screenSize);
         renderableData.elementAt<FScene::PRIMITIVES>(index) = rcm.getRenderPrimitives(ri, level);
+        renderableData.elementAt<FScene::MORPHING_BUFFER>(index).targets =
+                rcm.getMorphTargets(ri, level).data();
     }
 }
 
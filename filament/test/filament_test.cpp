@@ -31,6 +31,12 @@
 #include <filament/Frustum.h>
 #include <filament/Material.h>
 #include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/MorphTargetBuffer.h>
+#include <filament/RenderableManager.h>
+#include <filament/Texture.h>
+#include <filament/TextureSampler.h>
+#include <filament/VertexBuffer.h>
 
 #include <private/filament/BufferInterfaceBlock.h>
 #include <private/filament/UibStructs.h>
@@ -40,7 +46,11 @@
 #include "details/Material.h"
 #include "details/Camera.h"
 #include "Froxelizer.h"
+#include "RenderPrimitive.h"
 #include "details/Engine.h"
+#include "details/MaterialInstance.h"
+#include "details/MorphTargetBuffer.h"
+#include "details/Texture.h"
 #include "components/RenderableManager.h"
 #include "components/TransformManager.h"
 #include "UniformBuffer.h"
@@ -515,6 +525,227 @@ TEST(FilamentTest, UniformBufferSize2) {
     buffer.invalidate();
 }
 
+TEST(FilamentTest, UniformBufferDirtyRange) {
+    UniformBuffer buffer(256);
+    EXPECT_TRUE(buffer.isDirty());
+    EXPECT_EQ(0, buffer.getDirtyRange().first);
+    EXPECT_EQ(256, buffer.getDirtyRange().last);
+
+    buffer.clean();
+    EXPECT_FALSE(buffer.isDirty());
+
+    // a single float dirties its vec4
+    buffer.setUniform(36, 1.0f);
+    EXPECT_TRUE(buffer.isDirty());
+    EXPECT_EQ(32, buffer.getDirtyRange().first);
+    EXPECT_EQ(48, buffer.getDirtyRange().last);
+
+    // the range grows to cover all modified uniforms
+    buffer.setUniform(128, float4(1.0f));
+    EXPECT_EQ(32, buffer.getDirtyRange().first);
+    EXPECT_EQ(144, buffer.getDirtyRange().last);
+
+    buffer.clean();
+    buffer.setUniform(192, mat4f());
+    EXPECT_EQ(192, buffer.getDirtyRange().first);
+    EXPECT_EQ(256, buffer.getDirtyRange().last);
+}
+
+TEST(FilamentTest, PerRenderPassArenaGrowth) {
+    constexpr size_t MB = 1024 * 1024;
+    auto const usage = [](size_t arenaPeakMB, size_t arenaSizeMB,
+            size_t commandsPeakMB, size_t commandsSizeMB) {
+        Engine::FrameMemoryUsage result;
+        result.perRenderPassArenaPeak = arenaPeakMB;
+        result.perRenderPassArenaSize = arenaSizeMB * MB;
+        result.perFrameCommandsPeak = commandsPeakMB;
+        result.perFrameCommandsSize = commandsSizeMB * MB;
+        return result;
+    };
+
+    // less than 3/4 of each part is used, nothing grows
+    auto size = FEngine::growPerRenderPassArena(usage(3 * MB, 4, MB, 2), { 4, 2 }, 16);
+    EXPECT_EQ(4, size.arenaSizeMB);
+    EXPECT_EQ(2, size.commandsSizeMB);
+
+    // the commands grow to 1.5 times their peak, the rest of the arena is unchanged
+    size = FEngine::growPerRenderPassArena(usage(3 * MB, 4, 2 * MB, 2), { 4, 2 }, 16);
+    EXPECT_EQ(5, size.arenaSizeMB);
+    EXPECT_EQ(3, size.commandsSizeMB);
+
+    // the commands would need 4 MB but the arena is capped at 5 MB: the rest of the arena keeps
+    // its 2 MB and the commands get the remaining 3 MB
+    size = FEngine::growPerRenderPassArena(
+            usage(2 * MB + MB / 2 + MB / 4, 4, 2 * MB + MB / 2, 2), { 4, 2 }, 5);
+    EXPECT_EQ(5, size.arenaSizeMB);
+    EXPECT_EQ(3, size.commandsSizeMB);
+
+    // both parts want to grow past the maximum: the rest of the arena is served first, the
+    // commands never shrink
+    size = FEngine::growPerRenderPassArena(usage(6 * MB, 4, 2 * MB, 2), { 4, 2 }, 6);
+    EXPECT_EQ(6, size.arenaSizeMB);
+    EXPECT_EQ(2, size.commandsSizeMB);
+
+    // the arena is already at its maximum, nothing changes
+    size = FEngine::growPerRenderPassArena(usage(5 * MB, 5, 3 * MB, 3), { 5, 3 }, 5);
+    EXPECT_EQ(5, size.arenaSizeMB);
+    EXPECT_EQ(3, size.commandsSizeMB);
+}
+
+TEST(FilamentTest, LevelsOfDetailMorphing) {
+    using namespace filament;
+
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+
+    VertexBuffer* vb = VertexBuffer::Builder()
+            .vertexCount(3)
+            .bufferCount(1)
+            .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3)
+            .build(*engine);
+    IndexBuffer* ib = IndexBuffer::Builder()
+            .indexCount(3)
+            .bufferType(IndexBuffer::IndexType::USHORT)
+            .build(*engine);
+    MorphTargetBuffer* targets[3];
+    for (auto& target : targets) {
+        target = MorphTargetBuffer::Builder().vertexCount(3).count(1).build(*engine);
+    }
+
+    // level 0 is primitive 0, level 1 is primitives 1 and 2, each with its own morph targets
+    utils::Entity const entity = utils::EntityManager::get().create();
+    RenderableManager::Builder builder(3);
+    builder.boundingBox({{ 0, 0, 0 }, { 1, 1, 1 }})
+            .levelOfDetail(0, 1, 0.5f)
+            .levelOfDetail(1, 2, 0.0f)
+            .morphing(1);
+    for (size_t i = 0; i < 3; i++) {
+        builder.geometry(i, RenderableManager::PrimitiveType::TRIANGLES, vb, ib)
+                .morphing(0, i, targets[i]);
+    }
+    builder.build(*engine, entity);
+
+    FRenderableManager& rcm = downcast(engine)->getRenderableManager();
+    auto const ri = rcm.getInstance(entity);
+    ASSERT_EQ(2, rcm.getLevelOfDetailCount(ri));
+    EXPECT_EQ(0, rcm.getLevelOfDetailForScreenSize(ri, 1.0f));
+    EXPECT_EQ(1, rcm.getLevelOfDetailForScreenSize(ri, 0.25f));
+
+    // the morph targets of a level match its primitives
+    for (uint8_t level = 0; level < 2; level++) {
+        auto const primitives = rcm.getRenderPrimitives(ri, level);
+        auto const morphTargets = rcm.getMorphTargets(ri, level);
+        ASSERT_EQ(primitives.size(), morphTargets.size());
+        size_t const first = level == 0 ? 0 : 1;
+        for (size_t i = 0; i < morphTargets.size(); i++) {
+            EXPECT_EQ(downcast(targets[first + i]), morphTargets[i].buffer);
+        }
+    }
+
+    // primitive indices of the public API span all the levels
+    EXPECT_EQ(3, rcm.getPrimitiveCount(ri, 0));
+    EXPECT_EQ(targets[2], rcm.getMorphTargetBufferAt(ri, 0, 2));
+
+    rcm.destroy(entity);
+    utils::EntityManager::get().destroy(entity);
+    for (auto* target : targets) {
+        engine->destroy(target);
+    }
+    engine->destroy(ib);
+    engine->destroy(vb);
+    Engine::destroy(&engine);
+}
+
+TEST(FilamentTest, SamplerGroupCacheSharing) {
+    using namespace filament;
+
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+    FEngine* fengine = downcast(engine);
+    FEngine::DriverApi& driver = fengine->getDriverApi();
+    SamplerGroupCache const& cache = fengine->getSamplerGroupCache();
+
+    // the skybox material has a single sampler
+    FMaterial const* material = fengine->getSkyboxMaterial();
+    Texture* texture = Texture::Builder()
+            .sampler(Texture::Sampler::SAMPLER_CUBEMAP)
+            .format(Texture::InternalFormat::RGBA8)
+            .build(*engine);
+    size_t const groupCount = cache.getGroupCount();
+
+    // new instances share the group of the default instance
+    FMaterialInstance* a = material->createInstance("a");
+    FMaterialInstance* b = material->createInstance("b");
+    EXPECT_EQ(groupCount, cache.getGroupCount());
+
+    // instances that bind the same texture with the same sampler share a group
+    a->setParameter("skybox", texture, TextureSampler());
+    b->setParameter("skybox", texture, TextureSampler());
+    a->commit(driver);
+    b->commit(driver);
+    EXPECT_EQ(a->getSamplerGroupHandle(), b->getSamplerGroupHandle());
+    EXPECT_EQ(groupCount + 1, cache.getGroupCount());
+
+    // a different sampler needs another group
+    b->setParameter("skybox", texture, TextureSampler(TextureSampler::MagFilter::NEAREST));
+    b->commit(driver);
+    EXPECT_NE(a->getSamplerGroupHandle(), b->getSamplerGroupHandle());
+    EXPECT_EQ(groupCount + 2, cache.getGroupCount());
+
+    // the group is destroyed with its last user
+    engine->destroy(b);
+    EXPECT_EQ(groupCount + 1, cache.getGroupCount());
+    engine->destroy(a);
+    EXPECT_EQ(groupCount, cache.getGroupCount());
+
+    engine->destroy(texture);
+    Engine::destroy(&engine);
+}
+
+TEST(FilamentTest, SamplerGroupCacheInvalidation) {
+    using namespace filament;
+
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+    FEngine* fengine = downcast(engine);
+    FEngine::DriverApi& driver = fengine->getDriverApi();
+    SamplerGroupCache& cache = fengine->getSamplerGroupCache();
+
+    FMaterial const* material = fengine->getSkyboxMaterial();
+    Texture* texture = Texture::Builder()
+            .sampler(Texture::Sampler::SAMPLER_CUBEMAP)
+            .format(Texture::InternalFormat::RGBA8)
+            .build(*engine);
+    size_t const groupCount = cache.getGroupCount();
+
+    FMaterialInstance* a = material->createInstance("a");
+    FMaterialInstance* b = material->createInstance("b");
+    a->setParameter("skybox", texture, TextureSampler());
+    b->setParameter("skybox", texture, TextureSampler());
+    a->commit(driver);
+    b->commit(driver);
+    ASSERT_EQ(a->getSamplerGroupHandle(), b->getSamplerGroupHandle());
+
+    // a raw texture handle can't be tracked, so the instance switches to a private group
+    a->setParameter("skybox", downcast(texture)->getHwHandle(),
+            TextureSampler().getSamplerParams());
+    a->commit(driver);
+    EXPECT_NE(a->getSamplerGroupHandle(), b->getSamplerGroupHandle());
+    EXPECT_EQ(groupCount + 1, cache.getGroupCount());
+
+    // once the texture is destroyed its handle can be recycled, so the group of b isn't shared
+    // anymore, but b keeps it
+    auto const handle = b->getSamplerGroupHandle();
+    engine->destroy(texture);
+    auto const other = cache.acquire(driver, b->getSamplerGroup(), {}, {});
+    EXPECT_NE(handle, other);
+    EXPECT_EQ(handle, b->getSamplerGroupHandle());
+    EXPECT_EQ(groupCount + 2, cache.getGroupCount());
+    cache.release(driver, other);
+
+    engine->destroy(a);
+    engine->destroy(b);
+    EXPECT_EQ(groupCount, cache.getGroupCount());
+    Engine::destroy(&engine);
+}
+
 TEST(FilamentTest, BoxCulling) {
     Frustum frustum(mat4f::frustum(-1, 1, -1, 1, 1, 100));
 
@@ -17,8 +17,15 @@
 #include <fstream>
 #include <iostream>
 
+#include <string.h>
+
 #include <gtest/gtest.h>
 
+#include <filament/Engine.h>
+#include <filament/Material.h>
+
+#include <private/filament/Variant.h>
+
 #include "MaterialParser.h"
 
 #include "filament_test_resources.h"
@@ -41,6 +48,74 @@ TEST(MaterialParser, Parse) {
             "See instructions in filament_test_material_parser.cpp" << std::endl;
 }
 
+// The same material, built with matc --compress.
+TEST(MaterialParser, ParseCompressed) {
+    MaterialParser parser(backend::ShaderLanguage::ESSL3,
+            FILAMENT_TEST_RESOURCES_TEST_MATERIAL_DATA, FILAMENT_TEST_RESOURCES_TEST_MATERIAL_SIZE);
+    MaterialParser compressedParser(backend::ShaderLanguage::ESSL3,
+            FILAMENT_TEST_RESOURCES_TEST_MATERIAL_COMPRESSED_DATA,
+            FILAMENT_TEST_RESOURCES_TEST_MATERIAL_COMPRESSED_SIZE);
+    ASSERT_EQ(MaterialParser::ParseResult::SUCCESS, parser.parse());
+    ASSERT_EQ(MaterialParser::ParseResult::SUCCESS, compressedParser.parse());
+
+    size_t shaderCount = 0;
+    for (auto shaderModel : { backend::ShaderModel::MOBILE, backend::ShaderModel::DESKTOP }) {
+        for (size_t k = 0; k < VARIANT_COUNT; k++) {
+            Variant const variant(k);
+            for (auto stage : { backend::ShaderStage::VERTEX, backend::ShaderStage::FRAGMENT }) {
+                if (!parser.hasShader(shaderModel, variant, stage)) {
+                    EXPECT_FALSE(compressedParser.hasShader(shaderModel, variant, stage));
+                    continue;
+                }
+                filaflat::ShaderContent shader;
+                filaflat::ShaderContent compressedShader;
+                EXPECT_TRUE(parser.getShader(shader, shaderModel, variant, stage));
+                EXPECT_TRUE(compressedParser.getShader(
+                        compressedShader, shaderModel, variant, stage));
+                ASSERT_EQ(shader.size(), compressedShader.size());
+                EXPECT_EQ(0, memcmp(shader.data(), compressedShader.data(), shader.size()));
+                shaderCount++;
+            }
+        }
+    }
+    EXPECT_GT(shaderCount, 0);
+
+#if defined(FILAMENT_DRIVER_SUPPORTS_VULKAN)
+    MaterialParser spirvParser(backend::ShaderLanguage::SPIRV,
+            FILAMENT_TEST_RESOURCES_TEST_MATERIAL_COMPRESSED_DATA,
+            FILAMENT_TEST_RESOURCES_TEST_MATERIAL_COMPRESSED_SIZE);
+    ASSERT_EQ(MaterialParser::ParseResult::SUCCESS, spirvParser.parse());
+    filaflat::ShaderContent spirv;
+    ASSERT_TRUE(spirvParser.getShader(spirv, backend::ShaderModel::MOBILE, Variant(0),
+            backend::ShaderStage::VERTEX));
+    ASSERT_GE(spirv.size(), sizeof(uint32_t));
+    uint32_t magic;
+    memcpy(&magic, spirv.data(), sizeof(magic));
+    EXPECT_EQ(0x07230203u, magic);
+#endif
+}
+
+TEST(MaterialParser, LoadCompressed) {
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+    ASSERT_NE(nullptr, engine);
+    Material* material = Material::Builder()
+            .package(FILAMENT_TEST_RESOURCES_TEST_MATERIAL_DATA,
+                    FILAMENT_TEST_RESOURCES_TEST_MATERIAL_SIZE)
+            .build(*engine);
+    Material* compressedMaterial = Material::Builder()
+            .package(FILAMENT_TEST_RESOURCES_TEST_MATERIAL_COMPRESSED_DATA,
+                    FILAMENT_TEST_RESOURCES_TEST_MATERIAL_COMPRESSED_SIZE)
+            .build(*engine);
+    ASSERT_NE(nullptr, material);
+    ASSERT_NE(nullptr, compressedMaterial);
+    EXPECT_STREQ(material->getName(), compressedMaterial->getName());
+    EXPECT_EQ(material->getParameterCount(), compressedMaterial->getParameterCount());
+    EXPECT_EQ(material->getShading(), compressedMaterial->getShading());
+    engine->destroy(compressedMaterial);
+    engine->destroy(material);
+    Engine::destroy(&engine);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
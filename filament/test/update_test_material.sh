@@ -7,15 +7,18 @@ set -ex
 # See filament_test_material_parser.cpp.
 
 OUTPUT="filament/test/test_material.filamat"
+COMPRESSED_OUTPUT="filament/test/test_material_compressed.filamat"
 
 ./build.sh -p desktop release matc
 MATC=out/cmake-release/tools/matc/matc
 ${MATC} --platform all --api all -o ${OUTPUT} samples/materials/sandboxLit.mat
+${MATC} --platform all --api all --compress -o ${COMPRESSED_OUTPUT} samples/materials/sandboxLit.mat
 
 set +x
 
 echo "===================================================================="
-echo "Test material: filament/test/test_material.filamat has been updated."
+echo "Test materials: filament/test/test_material.filamat and"
+echo "filament/test/test_material_compressed.filamat have been updated."
 echo "Re-build and run test_material_parser and to verify."
 echo "Then commit and push changes."
 echo "===================================================================="
@@ -92,8 +92,17 @@ enum UTILS_PUBLIC ChunkType : uint64_t {
 
     DictionaryText = charTo64bitNum("DIC_TEXT"),
     DictionarySpirv = charTo64bitNum("DIC_SPIR"),
+
+    // LZ4-compressed forms of DictionaryText and DictionarySpirv, see filamat's Lz4BlockWriter.
+    // A material holds either form of a dictionary, never both.
+    DictionaryTextLz4 = charTo64bitNum("DIC_TLZ4"),
+    DictionarySpirvLz4 = charTo64bitNum("DIC_SLZ4"),
 };
 
+// Maximum uncompressed size of an LZ4 block in a dictionary chunk. This bounds the amount of
+// memory needed to decode a dictionary, since each block is decoded independently.
+static constexpr uint32_t DICTIONARY_LZ4_BLOCK_SIZE = 65536;
+
 } // namespace filamat
 
 #endif // TNT_FILAMAT_MATERIAL_CHUNK_TYPES_H
@@ -22,6 +22,16 @@
 namespace filaflat {
 
 struct DictionaryReader {
+    // Returns the tag of the LZ4-compressed form of a dictionary (DictionaryText or
+    // DictionarySpirv), or Unknown.
+    static ChunkContainer::Type getLz4Tag(ChunkContainer::Type dictionaryTag) noexcept;
+
+    // Returns whether the container holds the given dictionary, compressed or not.
+    static bool hasDictionary(ChunkContainer const& container,
+            ChunkContainer::Type dictionaryTag) noexcept;
+
+    // Reads the given dictionary (DictionaryText or DictionarySpirv), from its LZ4-compressed
+    // form if that's how the container holds it.
     static bool unflatten(ChunkContainer const& container,
             ChunkContainer::Type dictionaryTag,
             BlobDictionary& dictionary);
@@ -19,6 +19,8 @@
 #include <filaflat/ChunkContainer.h>
 #include <filaflat/Unflattener.h>
 
+#include "Lz4BlockReader.h"
+
 #if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
 #include <utils/Log.h>
 #include <smolv.h>
@@ -30,72 +32,143 @@ using namespace filamat;
 
 namespace filaflat {
 
-bool DictionaryReader::unflatten(ChunkContainer const& container,
-        ChunkContainer::Type dictionaryTag,
-        BlobDictionary& dictionary) {
+static bool decodeSpirv(const char* compressed, size_t compressedSize, BlobDictionary& dictionary) {
+#if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
+    size_t spirvSize = smolv::GetDecodedBufferSize(compressed, compressedSize);
+    if (spirvSize == 0) {
+        return false;
+    }
+    ShaderContent spirv(spirvSize);
+    if (!smolv::Decode(compressed, compressedSize, spirv.data(), spirvSize)) {
+        return false;
+    }
+    dictionary.emplace_back(std::move(spirv));
+    return true;
+#else
+    return false;
+#endif
+}
 
-    auto [start, end] = container.getChunkRange(dictionaryTag);
-    Unflattener unflattener(start, end);
+static bool unflattenSpirv(Unflattener& unflattener, BlobDictionary& dictionary) {
+    uint32_t compressionScheme;
+    if (!unflattener.read(&compressionScheme)) {
+        return false;
+    }
+    // For now, 1 is the only acceptable compression scheme.
+    assert(compressionScheme == 1);
 
-    if (dictionaryTag == ChunkType::DictionarySpirv) {
-        uint32_t compressionScheme;
-        if (!unflattener.read(&compressionScheme)) {
+    uint32_t blobCount;
+    if (!unflattener.read(&blobCount)) {
+        return false;
+    }
+
+    dictionary.reserve(blobCount);
+    for (uint32_t i = 0; i < blobCount; i++) {
+        unflattener.skipAlignmentPadding();
+
+        const char* compressed;
+        size_t compressedSize;
+        if (!unflattener.read(&compressed, &compressedSize)) {
             return false;
         }
-        // For now, 1 is the only acceptable compression scheme.
-        assert(compressionScheme == 1);
 
-        uint32_t blobCount;
-        if (!unflattener.read(&blobCount)) {
+        assert_invariant((intptr_t(compressed) % 8) == 0);
+
+        if (!decodeSpirv(compressed, compressedSize, dictionary)) {
             return false;
         }
+    }
+    return true;
+}
 
-        dictionary.reserve(blobCount);
-        for (uint32_t i = 0; i < blobCount; i++) {
-            unflattener.skipAlignmentPadding();
+static bool unflattenSpirvLz4(Unflattener& unflattener, BlobDictionary& dictionary) {
+    Lz4BlockReader reader(unflattener);
+    uint32_t blobCount;
+    if (!reader.init() || !reader.read(&blobCount)) {
+        return false;
+    }
 
-            const char* compressed;
-            size_t compressedSize;
-            if (!unflattener.read(&compressed, &compressedSize)) {
-                return false;
-            }
+    dictionary.reserve(blobCount);
+    ShaderContent compressed;
+    for (uint32_t i = 0; i < blobCount; i++) {
+        if (!reader.readBlob(&compressed)) {
+            return false;
+        }
+        if (!decodeSpirv((const char*)compressed.data(), compressed.size(), dictionary)) {
+            return false;
+        }
+    }
+    return true;
+}
 
-            assert_invariant((intptr_t(compressed) % 8) == 0);
+static bool unflattenText(Unflattener& unflattener, BlobDictionary& dictionary) {
+    uint32_t stringCount = 0;
+    if (!unflattener.read(&stringCount)) {
+        return false;
+    }
 
-#if defined (FILAMENT_DRIVER_SUPPORTS_VULKAN)
-            size_t spirvSize = smolv::GetDecodedBufferSize(compressed, compressedSize);
-            if (spirvSize == 0) {
-                return false;
-            }
-            ShaderContent spirv(spirvSize);
-            if (!smolv::Decode(compressed, compressedSize, spirv.data(), spirvSize)) {
-                return false;
-            }
-            dictionary.emplace_back(std::move(spirv));
-#else
+    dictionary.reserve(stringCount);
+    for (uint32_t i = 0; i < stringCount; i++) {
+        const char* str;
+        if (!unflattener.read(&str)) {
             return false;
-#endif
-
         }
-        return true;
-    } else if (dictionaryTag == ChunkType::DictionaryText) {
-        uint32_t stringCount = 0;
-        if (!unflattener.read(&stringCount)) {
+        // BlobDictionary hold binary chunks and does not care if the data holds text, it is
+        // therefore crucial to include the trailing null.
+        dictionary.emplace_back(strlen(str) + 1);
+        memcpy(dictionary.back().data(), str, dictionary.back().size());
+    }
+    return true;
+}
+
+static bool unflattenTextLz4(Unflattener& unflattener, BlobDictionary& dictionary) {
+    Lz4BlockReader reader(unflattener);
+    uint32_t stringCount = 0;
+    if (!reader.init() || !reader.read(&stringCount)) {
+        return false;
+    }
+
+    dictionary.reserve(stringCount);
+    for (uint32_t i = 0; i < stringCount; i++) {
+        // the trailing null is included, see above
+        dictionary.emplace_back();
+        if (!reader.readString(&dictionary.back())) {
             return false;
         }
+    }
+    return true;
+}
 
-        dictionary.reserve(stringCount);
-        for (uint32_t i = 0; i < stringCount; i++) {
-            const char* str;
-            if (!unflattener.read(&str)) {
-                return false;
-            }
-            // BlobDictionary hold binary chunks and does not care if the data holds text, it is
-            // therefore crucial to include the trailing null.
-            dictionary.emplace_back(strlen(str) + 1);
-            memcpy(dictionary.back().data(), str, dictionary.back().size());
-        }
-        return true;
+ChunkContainer::Type DictionaryReader::getLz4Tag(ChunkContainer::Type dictionaryTag) noexcept {
+    switch (dictionaryTag) {
+        case ChunkType::DictionaryText:
+            return ChunkType::DictionaryTextLz4;
+        case ChunkType::DictionarySpirv:
+            return ChunkType::DictionarySpirvLz4;
+        default:
+            return ChunkType::Unknown;
+    }
+}
+
+bool DictionaryReader::hasDictionary(ChunkContainer const& container,
+        ChunkContainer::Type dictionaryTag) noexcept {
+    return container.hasChunk(dictionaryTag) || container.hasChunk(getLz4Tag(dictionaryTag));
+}
+
+bool DictionaryReader::unflatten(ChunkContainer const& container,
+        ChunkContainer::Type dictionaryTag,
+        BlobDictionary& dictionary) {
+
+    const bool lz4 = !container.hasChunk(dictionaryTag);
+    auto [start, end] = container.getChunkRange(lz4 ? getLz4Tag(dictionaryTag) : dictionaryTag);
+    Unflattener unflattener(start, end);
+
+    if (dictionaryTag == ChunkType::DictionarySpirv) {
+        return lz4 ? unflattenSpirvLz4(unflattener, dictionary)
+                   : unflattenSpirv(unflattener, dictionary);
+    } else if (dictionaryTag == ChunkType::DictionaryText) {
+        return lz4 ? unflattenTextLz4(unflattener, dictionary)
+                   : unflattenText(unflattener, dictionary);
     }
 
     return false;
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Lz4BlockReader.h"
+
+#include <filament/MaterialChunkType.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <string.h>
+
+using namespace filamat;
+
+namespace filaflat {
+
+bool Lz4BlockReader::init() noexcept {
+    if (!mUnflattener.read(&mBlockCount)) {
+        return false;
+    }
+    mBlock = std::make_unique<uint8_t[]>(DICTIONARY_LZ4_BLOCK_SIZE);
+    return true;
+}
+
+bool Lz4BlockReader::nextBlock() noexcept {
+    if (mBlockIndex >= mBlockCount) {
+        return false;
+    }
+    mBlockIndex++;
+
+    uint32_t size;
+    const char* data;
+    size_t dataSize;
+    if (!mUnflattener.read(&size) || !mUnflattener.read(&data, &dataSize)) {
+        return false;
+    }
+    if (size > DICTIONARY_LZ4_BLOCK_SIZE || dataSize > size) {
+        return false;
+    }
+    if (dataSize == size) {
+        // incompressible blocks are stored as is
+        memcpy(mBlock.get(), data, size);
+    } else if (!decompress((const uint8_t*)data, dataSize, mBlock.get(), size)) {
+        return false;
+    }
+    mCursor = 0;
+    mSize = size;
+    return true;
+}
+
+bool Lz4BlockReader::read(uint8_t* dst, size_t size) noexcept {
+    while (size) {
+        if (mCursor == mSize && !nextBlock()) {
+            return false;
+        }
+        const size_t n = std::min(size, mSize - mCursor);
+        memcpy(dst, mBlock.get() + mCursor, n);
+        mCursor += n;
+        dst += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool Lz4BlockReader::read(uint32_t* out) noexcept {
+    uint8_t bytes[4];
+    if (!read(bytes, sizeof(bytes))) {
+        return false;
+    }
+    *out = uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 |
+           uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+    return true;
+}
+
+bool Lz4BlockReader::readString(ShaderContent* out) noexcept {
+    // fast path: the string is fully contained in the current block
+    if (mCursor < mSize) {
+        const uint8_t* const start = mBlock.get() + mCursor;
+        const uint8_t* const end = (const uint8_t*)memchr(start, 0, mSize - mCursor);
+        if (end) {
+            const size_t size = end - start + 1;
+            *out = ShaderContent(size);
+            memcpy(out->data(), start, size);
+            mCursor += size;
+            return true;
+        }
+    }
+
+    // slow path: the string straddles blocks
+    std::vector<uint8_t> str;
+    do {
+        if (mCursor == mSize && !nextBlock()) {
+            return false;
+        }
+        str.push_back(mBlock[mCursor++]);
+    } while (str.back() != 0);
+    *out = ShaderContent(str.size());
+    memcpy(out->data(), str.data(), str.size());
+    return true;
+}
+
+bool Lz4BlockReader::readBlob(ShaderContent* out) noexcept {
+    uint32_t size;
+    if (!read(&size)) {
+        return false;
+    }
+    *out = ShaderContent(size);
+    return read(out->data(), size);
+}
+
+// See https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+bool Lz4BlockReader::decompress(const uint8_t* src, size_t srcSize,
+        uint8_t* dst, size_t dstSize) noexcept {
+    const uint8_t* ip = src;
+    const uint8_t* const ipEnd = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const opEnd = dst + dstSize;
+
+    auto readLength = [&ip, ipEnd](size_t* length) {
+        uint8_t b;
+        do {
+            if (ip == ipEnd) {
+                return false;
+            }
+            b = *ip++;
+            *length += b;
+        } while (b == 255);
+        return true;
+    };
+
+    while (ip < ipEnd) {
+        const uint8_t token = *ip++;
+
+        size_t literalCount = token >> 4u;
+        if (literalCount == 15 && !readLength(&literalCount)) {
+            return false;
+        }
+        if (literalCount > size_t(ipEnd - ip) || literalCount > size_t(opEnd - op)) {
+            return false;
+        }
+        memcpy(op, ip, literalCount);
+        ip += literalCount;
+        op += literalCount;
+
+        if (ip == ipEnd) {
+            // the last sequence only has literals
+            break;
+        }
+
+        if (ipEnd - ip < 2) {
+            return false;
+        }
+        const size_t offset = size_t(ip[0]) | size_t(ip[1]) << 8u;
+        ip += 2;
+        if (offset == 0 || offset > size_t(op - dst)) {
+            return false;
+        }
+
+        size_t matchLength = token & 0xfu;
+        if (matchLength == 15 && !readLength(&matchLength)) {
+            return false;
+        }
+        matchLength += 4;
+        if (matchLength > size_t(opEnd - op)) {
+            return false;
+        }
+
+        // the match can overlap the output, so it must be copied forward byte by byte
+        const uint8_t* match = op - offset;
+        for (size_t i = 0; i < matchLength; i++) {
+            *op++ = *match++;
+        }
+    }
+    return op == opEnd;
+}
+
+} // namespace filaflat
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAFLAT_LZ4_BLOCK_READER_H
+#define TNT_FILAFLAT_LZ4_BLOCK_READER_H
+
+#include <filaflat/ChunkContainer.h>
+#include <filaflat/Unflattener.h>
+
+#include <memory>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filaflat {
+
+// Incrementally decodes a stream written by filamat's Lz4BlockWriter. Blocks are decoded one at
+// a time as data is read, so at most one block (DICTIONARY_LZ4_BLOCK_SIZE bytes) of decompressed
+// data is held in memory.
+class Lz4BlockReader {
+public:
+    explicit Lz4BlockReader(Unflattener& unflattener) noexcept : mUnflattener(unflattener) {}
+
+    // Must be called before any read. Returns false if the stream header is invalid.
+    bool init() noexcept;
+
+    bool read(uint32_t* out) noexcept;
+
+    // Reads a null-terminated string, the terminator is included in the output.
+    bool readString(ShaderContent* out) noexcept;
+
+    // Reads a blob written with Lz4BlockWriter::writeBlob().
+    bool readBlob(ShaderContent* out) noexcept;
+
+    // Decompresses an LZ4 block. Returns false if the block is malformed or if it doesn't
+    // decompress to exactly dstSize bytes.
+    static bool decompress(const uint8_t* src, size_t srcSize,
+            uint8_t* dst, size_t dstSize) noexcept;
+
+private:
+    bool read(uint8_t* dst, size_t size) noexcept;
+    bool nextBlock() noexcept;
+
+    Unflattener& mUnflattener;
+    std::unique_ptr<uint8_t[]> mBlock;
+    uint32_t mBlockCount = 0;
+    uint32_t mBlockIndex = 0;
+    size_t mCursor = 0;
+    size_t mSize = 0;
+};
+
+} // namespace filaflat
+
+#endif // TNT_FILAFLAT_LZ4_BLOCK_READER_H
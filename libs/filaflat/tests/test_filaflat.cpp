@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <filaflat/ChunkContainer.h>
+#include <filaflat/DictionaryReader.h>
+
+#include <filament/MaterialChunkType.h>
+
+#include "Lz4BlockReader.h"
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+using namespace filaflat;
+using namespace filamat;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes bytes(std::string const& s) {
+    return { s.begin(), s.end() };
+}
+
+void append(Bytes& dst, Bytes const& src) {
+    dst.insert(dst.end(), src.begin(), src.end());
+}
+
+void appendUint32(Bytes& dst, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        dst.push_back(uint8_t(v >> (i * 8)));
+    }
+}
+
+void appendUint64(Bytes& dst, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        dst.push_back(uint8_t(v >> (i * 8)));
+    }
+}
+
+bool decompress(Bytes const& src, Bytes& dst) {
+    return Lz4BlockReader::decompress(src.data(), src.size(), dst.data(), dst.size());
+}
+
+// A block of a dictionary stream (see filamat's Lz4BlockWriter), uncompressedSize is the size of
+// data once decompressed. data is stored as is when its size is uncompressedSize.
+void appendBlock(Bytes& dst, uint32_t uncompressedSize, Bytes const& data) {
+    appendUint32(dst, uncompressedSize);
+    appendUint64(dst, data.size());
+    append(dst, data);
+}
+
+// Builds a package with a single chunk.
+Bytes package(ChunkType type, Bytes const& content) {
+    Bytes result;
+    appendUint64(result, type);
+    appendUint32(result, uint32_t(content.size()));
+    append(result, content);
+    return result;
+}
+
+bool unflatten(Bytes const& package, ChunkType tag, BlobDictionary& dictionary) {
+    ChunkContainer container(package.data(), package.size());
+    return container.parse() && DictionaryReader::unflatten(container, tag, dictionary);
+}
+
+// The strings "a" and "bc", as stored in a text dictionary.
+Bytes textDictionary() {
+    Bytes result;
+    appendUint32(result, 2);
+    append(result, bytes(std::string("a\0bc\0", 5)));
+    return result;
+}
+
+} // namespace
+
+TEST(Lz4BlockReader, Literals) {
+    Bytes const src = { 0x50, 'h', 'e', 'l', 'l', 'o' };
+    Bytes dst(5);
+    EXPECT_TRUE(decompress(src, dst));
+    EXPECT_EQ(bytes("hello"), dst);
+}
+
+TEST(Lz4BlockReader, LongLiterals) {
+    // 15 literals in the token, 5 more in the extension byte
+    Bytes src = { 0xf0, 5 };
+    append(src, bytes("abcdefghijklmnopqrst"));
+    Bytes dst(20);
+    EXPECT_TRUE(decompress(src, dst));
+    EXPECT_EQ(bytes("abcdefghijklmnopqrst"), dst);
+}
+
+TEST(Lz4BlockReader, OverlappingMatch) {
+    // "ab", then a match of 6 bytes at offset 2, then the last literal
+    Bytes const src = { 0x22, 'a', 'b', 2, 0, 0x10, '!' };
+    Bytes dst(9);
+    EXPECT_TRUE(decompress(src, dst));
+    EXPECT_EQ(bytes("abababab!"), dst);
+}
+
+TEST(Lz4BlockReader, LongMatch) {
+    // "x", then a match of 4 + 15 + 255 + 1 bytes at offset 1
+    Bytes const src = { 0x1f, 'x', 1, 0, 255, 1, 0x10, '!' };
+    Bytes dst(1 + 275 + 1);
+    EXPECT_TRUE(decompress(src, dst));
+    EXPECT_EQ(std::string(276, 'x') + "!", std::string(dst.begin(), dst.end()));
+}
+
+TEST(Lz4BlockReader, CorruptBlocks) {
+    Bytes dst(9);
+    // the output is shorter than expected
+    EXPECT_FALSE(decompress({ 0x50, 'h', 'e', 'l', 'l', 'o' }, dst));
+    // the output is longer than expected
+    EXPECT_FALSE(decompress({ 0xf0, 0, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l',
+            'm', 'n', 'o' }, dst));
+    // the literals go past the end of the input
+    EXPECT_FALSE(decompress({ 0x90, 'a', 'b' }, dst));
+    // the literal length extension is missing
+    EXPECT_FALSE(decompress({ 0xf0 }, dst));
+    // the offset is truncated
+    EXPECT_FALSE(decompress({ 0x22, 'a', 'b', 2 }, dst));
+    // the offset is zero
+    EXPECT_FALSE(decompress({ 0x22, 'a', 'b', 0, 0, 0x10, '!' }, dst));
+    // the offset points before the start of the output
+    EXPECT_FALSE(decompress({ 0x22, 'a', 'b', 3, 0, 0x10, '!' }, dst));
+    // the match goes past the end of the output
+    EXPECT_FALSE(decompress({ 0x2f, 'a', 'b', 2, 0, 0, 0x10, '!' }, dst));
+    // the match length extension is missing
+    EXPECT_FALSE(decompress({ 0x2f, 'a', 'b', 2, 0 }, dst));
+}
+
+TEST(DictionaryReader, Text) {
+    BlobDictionary dictionary;
+    ASSERT_TRUE(unflatten(package(ChunkType::DictionaryText, textDictionary()),
+            ChunkType::DictionaryText, dictionary));
+    ASSERT_EQ(2, dictionary.size());
+    EXPECT_STREQ("a", (const char*) dictionary[0].data());
+    EXPECT_STREQ("bc", (const char*) dictionary[1].data());
+}
+
+TEST(DictionaryReader, TextLz4) {
+    // the same dictionary, stored as is in a single block
+    Bytes const stream = textDictionary();
+    Bytes content;
+    appendUint32(content, 1);
+    appendBlock(content, stream.size(), stream);
+
+    Bytes const data = package(ChunkType::DictionaryTextLz4, content);
+    ChunkContainer container(data.data(), data.size());
+    ASSERT_TRUE(container.parse());
+    EXPECT_TRUE(DictionaryReader::hasDictionary(container, ChunkType::DictionaryText));
+    EXPECT_FALSE(DictionaryReader::hasDictionary(container, ChunkType::DictionarySpirv));
+
+    BlobDictionary dictionary;
+    ASSERT_TRUE(DictionaryReader::unflatten(container, ChunkType::DictionaryText, dictionary));
+    ASSERT_EQ(2, dictionary.size());
+    EXPECT_STREQ("a", (const char*) dictionary[0].data());
+    EXPECT_STREQ("bc", (const char*) dictionary[1].data());
+}
+
+TEST(DictionaryReader, TextLz4AcrossBlocks) {
+    // the string count and the first string straddle blocks, the last block is compressed
+    Bytes content;
+    appendUint32(content, 3);
+    appendBlock(content, 2, { 2, 0 });
+    appendBlock(content, 3, { 0, 0, 'a' });
+    appendBlock(content, 18, { 0x3a, 0, 'b', 'c', 2, 0, 0x10, 0 });
+    BlobDictionary dictionary;
+    ASSERT_TRUE(unflatten(package(ChunkType::DictionaryTextLz4, content),
+            ChunkType::DictionaryText, dictionary));
+    ASSERT_EQ(2, dictionary.size());
+    EXPECT_STREQ("a", (const char*) dictionary[0].data());
+    EXPECT_STREQ("bcbcbcbcbcbcbcbc", (const char*) dictionary[1].data());
+    EXPECT_EQ(17, dictionary[1].size());
+}
+
+TEST(DictionaryReader, CorruptTextLz4) {
+    Bytes const stream = textDictionary();
+    BlobDictionary dictionary;
+
+    // there are fewer strings than announced
+    Bytes content;
+    Bytes missingString = stream;
+    missingString[0] = 3;
+    appendUint32(content, 1);
+    appendBlock(content, missingString.size(), missingString);
+    EXPECT_FALSE(unflatten(package(ChunkType::DictionaryTextLz4, content),
+            ChunkType::DictionaryText, dictionary));
+
+    // the stream is truncated: the last string isn't terminated
+    content.clear();
+    appendUint32(content, 1);
+    appendBlock(content, stream.size() - 1, Bytes(stream.begin(), stream.end() - 1));
+    dictionary.clear();
+    EXPECT_FALSE(unflatten(package(ChunkType::DictionaryTextLz4, content),
+            ChunkType::DictionaryText, dictionary));
+
+    // the block is larger than DICTIONARY_LZ4_BLOCK_SIZE
+    content.clear();
+    appendUint32(content, 1);
+    appendBlock(content, DICTIONARY_LZ4_BLOCK_SIZE + 1, { 0x10, 'a' });
+    dictionary.clear();
+    EXPECT_FALSE(unflatten(package(ChunkType::DictionaryTextLz4, content),
+            ChunkType::DictionaryText, dictionary));
+
+    // the compressed data is larger than the block
+    content.clear();
+    appendUint32(content, 1);
+    appendBlock(content, 2, { 0x20, 'a', 0 });
+    dictionary.clear();
+    EXPECT_FALSE(unflatten(package(ChunkType::DictionaryTextLz4, content),
+            ChunkType::DictionaryText, dictionary));
+
+    // the block doesn't decompress
+    content.clear();
+    appendUint32(content, 1);
+    appendBlock(content, 8, { 0x22, 'a', 'b', 0, 0, 0x10, '!' });
+    dictionary.clear();
+    EXPECT_FALSE(unflatten(package(ChunkType::DictionaryTextLz4, content),
+            ChunkType::DictionaryText, dictionary));
+
+    // the chunk is truncated
+    content.clear();
+    appendUint32(content, 1);
+    appendBlock(content, stream.size(), stream);
+    content.resize(content.size() - 2);
+    dictionary.clear();
+    EXPECT_FALSE(unflatten(package(ChunkType::DictionaryTextLz4, content),
+            ChunkType::DictionaryText, dictionary));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filamat/MaterialBuilder.h>
+#include <filamat/Package.h>
+
+#include <filaflat/ChunkContainer.h>
+#include <filaflat/DictionaryReader.h>
+
+#include <utils/JobSystem.h>
+
+using namespace filamat;
+
+// Compares the size and decoding time of the compressed and uncompressed shader dictionaries of
+// a lit material.
+
+static Package const& getPackage(bool compressed) {
+    auto build = [](bool compressed) {
+        MaterialBuilder::init();
+        utils::JobSystem jobSystem;
+        jobSystem.adopt();
+        MaterialBuilder builder;
+        builder.name("benchmark")
+                .material("void material(inout MaterialInputs material) {\n"
+                          "    prepareMaterial(material);\n"
+                          "    material.baseColor = materialParams.baseColor;\n"
+                          "}\n")
+                .parameter("baseColor", MaterialBuilder::UniformType::FLOAT4)
+                .targetApi(MaterialBuilder::TargetApi::OPENGL | MaterialBuilder::TargetApi::VULKAN)
+                .platform(MaterialBuilder::Platform::MOBILE)
+                .compressShaders(compressed);
+        Package package = builder.build(jobSystem);
+        jobSystem.emancipate();
+        MaterialBuilder::shutdown();
+        return package;
+    };
+    static Package const uncompressedPackage = build(false);
+    static Package const compressedPackage = build(true);
+    return compressed ? compressedPackage : uncompressedPackage;
+}
+
+static void unflattenDictionary(benchmark::State& state, ChunkType type) {
+    Package const& package = getPackage(state.range(0));
+    filaflat::ChunkContainer container(package.getData(), package.getSize());
+    filaflat::ChunkContainer::ChunkDesc desc{};
+    ChunkType const chunkType = state.range(0) ? filaflat::DictionaryReader::getLz4Tag(type) : type;
+    if (!container.parse() || !container.hasChunk(chunkType, &desc)) {
+        state.SkipWithError("missing dictionary chunk");
+        return;
+    }
+    for (auto _ : state) {
+        filaflat::BlobDictionary dictionary;
+        if (!filaflat::DictionaryReader::unflatten(container, type, dictionary)) {
+            state.SkipWithError("dictionary can't be decoded");
+            break;
+        }
+        benchmark::DoNotOptimize(dictionary.data());
+    }
+    state.counters["chunkSize"] = double(desc.size);
+    state.counters["packageSize"] = double(package.getSize());
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(desc.size));
+}
+
+static void BM_DictionaryText(benchmark::State& state) {
+    unflattenDictionary(state, ChunkType::DictionaryText);
+}
+
+static void BM_DictionarySpirv(benchmark::State& state) {
+    unflattenDictionary(state, ChunkType::DictionarySpirv);
+}
+
+// argument: 0 = current format, 1 = LZ4 compressed
+BENCHMARK(BM_DictionaryText)->Arg(0)->Arg(1);
+BENCHMARK(BM_DictionarySpirv)->Arg(0)->Arg(1);
@@ -135,6 +135,7 @@ protected:
     Optimization mOptimization = Optimization::PERFORMANCE;
     bool mPrintShaders = false;
     bool mGenerateDebugInfo = false;
+    bool mCompressShaders = false;
     bool mIncludeEssl1 = true;
     utils::bitset32 mShaderModels;
     struct CodeGenParams {
@@ -570,6 +571,10 @@ public:
     //! If true, will include debugging information in generated SPIRV.
     MaterialBuilder& generateDebugInfo(bool generateDebugInfo) noexcept;
 
+    //! If true, the shader dictionaries are compressed with LZ4 to reduce the package size.
+    //! Such packages can't be loaded by releases of Filament that predate this option.
+    MaterialBuilder& compressShaders(bool compressShaders) noexcept;
+
     //! Specifies a list of variants that should be filtered out during code generation.
     MaterialBuilder& variantFilter(filament::UserVariantFilterMask variantFilter) noexcept;
 
@@ -593,6 +598,18 @@ public:
     //! specify compute kernel group size
     MaterialBuilder& groupSize(filament::math::uint3 groupSize) noexcept;
 
+    struct ShaderCompilationStats {
+        //! number of shaders that went through the post-processor
+        uint32_t shaderCount = 0;
+        //! number of shaders whose post-processed output was reused from an identical shader
+        uint32_t cacheHits = 0;
+    };
+
+    //! Returns statistics about the shaders compiled by the last call to build()
+    ShaderCompilationStats getShaderCompilationStats() const noexcept {
+        return mShaderCompilationStats;
+    }
+
     /**
      * Build the material. If you are using the Filament engine with this library, you should use
      * the job system provided by Engine.
@@ -769,7 +786,7 @@ private:
     bool generateShaders(
             utils::JobSystem& jobSystem,
             const std::vector<filamat::Variant>& variants, ChunkContainer& container,
-            const MaterialInfo& info) const noexcept;
+            const MaterialInfo& info, ShaderCompilationStats* outStats) const noexcept;
 
     bool hasCustomVaryings() const noexcept;
     bool needsStandardDepthProgram() const noexcept;
@@ -878,6 +895,8 @@ private:
     filament::UserVariantFilterMask mVariantFilter = {};
 
     bool mNoSamplerValidation = false;
+
+    ShaderCompilationStats mShaderCompilationStats;
 };
 
 } // namespace filamat
@@ -53,6 +53,8 @@
 #include <utils/Hash.h>
 
 #include <atomic>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -528,6 +530,11 @@ MaterialBuilder& MaterialBuilder::generateDebugInfo(bool generateDebugInfo) noex
     return *this;
 }
 
+MaterialBuilder& MaterialBuilder::compressShaders(bool compressShaders) noexcept {
+    mCompressShaders = compressShaders;
+    return *this;
+}
+
 MaterialBuilder& MaterialBuilder::variantFilter(UserVariantFilterMask variantFilter) noexcept {
     mVariantFilter = variantFilter;
     return *this;
@@ -787,7 +794,8 @@ static void showErrorMessage(const char* materialName, filament::Variant variant
 }
 
 bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Variant>& variants,
-        ChunkContainer& container, const MaterialInfo& info) const noexcept {
+        ChunkContainer& container, const MaterialInfo& info,
+        ShaderCompilationStats* outStats) const noexcept {
     // Create a postprocessor to optimize / compile to Spir-V if necessary.
 
     uint32_t flags = 0;
@@ -805,6 +813,22 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
     BlobDictionary spirvDictionary;
     // End: must be protected by lock
 
+    // Post-processing is by far the most expensive step, and many variants generate the exact
+    // same source (e.g. vertex shaders don't depend on fragment-only variant bits). The
+    // post-processor outputs are memoized here, keyed by the hash of the source and the target.
+    // The cache is bypassed when printing shaders, so that all shaders are still printed, and
+    // for Metal (see below).
+    struct PostProcessedShader {
+        std::string source;
+        std::string glsl;
+        std::vector<uint32_t> spirv;
+    };
+    Mutex cacheLock;
+    std::unordered_map<size_t, PostProcessedShader> postProcessCache; // protected by cacheLock
+    std::atomic_uint32_t cacheHits{ 0 };
+    std::atomic_uint32_t shaderCount{ 0 };
+    bool const useCache = !mPrintShaders;
+
     ShaderGenerator sg(mProperties, mVariables, mOutputs, mDefines, mConstants,
             mMaterialFragmentCode.getResolved(), mMaterialFragmentCode.getLineOffset(),
             mMaterialVertexCode.getResolved(), mMaterialVertexCode.getLineOffset(),
@@ -833,6 +857,10 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
         const bool targetApiNeedsMsl = targetApi == TargetApi::METAL;
         const bool targetApiNeedsGlsl = targetApi == TargetApi::OPENGL;
 
+        // Metal isn't memoized: its cross-compiler gathers the sampler interface blocks based on
+        // the variant, so the variant would have to be part of the key, leaving almost no hits.
+        const bool useCacheForTarget = useCache && !targetApiNeedsMsl;
+
         // Set when a job fails
         JobSystem::Job* parent = jobSystem.createJob();
 
@@ -902,15 +930,62 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
                     config.glsl.subpassInputToColorLocation.emplace_back(0, 0);
                 }
 
-                bool const ok = postProcessor.process(shader, config, pGlsl, pSpirv, pMsl);
-                if (!ok) {
-                    showErrorMessage(mMaterialName.c_str_safe(), v.variant, targetApi, v.stage,
-                                     featureLevel, shader);
-                    cancelJobs = true;
-                    if (mPrintShaders) {
-                        slog.e << shader << io::endl;
+                shaderCount.fetch_add(1, std::memory_order_relaxed);
+
+                uint32_t const target =
+                        uint32_t(targetApi) |
+                        uint32_t(targetLanguage) << 8u |
+                        uint32_t(v.stage) << 10u |
+                        uint32_t(shaderModel) << 12u |
+                        uint32_t(featureLevel) << 16u |
+                        uint32_t(config.usesClipDistance) << 20u;
+                size_t cacheKey = std::hash<std::string>{}(shader);
+                hash::combine(cacheKey, target);
+
+                bool cached = false;
+                if (useCacheForTarget) {
+                    std::unique_lock<Mutex> const lock(cacheLock);
+                    auto const pos = postProcessCache.find(cacheKey);
+                    if (pos != postProcessCache.end() && pos->second.source == shader) {
+                        PostProcessedShader const& entry = pos->second;
+                        if (pGlsl) {
+                            *pGlsl = entry.glsl;
+                        }
+                        if (pSpirv) {
+                            *pSpirv = entry.spirv;
+                        }
+                        cached = true;
+                    }
+                }
+
+                if (cached) {
+                    cacheHits.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    // process() may overwrite the source (pGlsl can alias it)
+                    std::string source = useCacheForTarget ? shader : std::string{};
+
+                    bool const ok = postProcessor.process(shader, config, pGlsl, pSpirv, pMsl);
+                    if (!ok) {
+                        showErrorMessage(mMaterialName.c_str_safe(), v.variant, targetApi, v.stage,
+                                featureLevel, shader);
+                        cancelJobs = true;
+                        if (mPrintShaders) {
+                            slog.e << shader << io::endl;
+                        }
+                        return;
+                    }
+
+                    if (useCacheForTarget) {
+                        PostProcessedShader entry{ .source = std::move(source) };
+                        if (pGlsl) {
+                            entry.glsl = *pGlsl;
+                        }
+                        if (pSpirv) {
+                            entry.spirv = *pSpirv;
+                        }
+                        std::unique_lock<Mutex> const lock(cacheLock);
+                        postProcessCache.emplace(cacheKey, std::move(entry));
                     }
-                    return;
                 }
 
                 if (targetApi == TargetApi::OPENGL) {
@@ -975,6 +1050,11 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
         return false;
     }
 
+    if (outStats) {
+        outStats->shaderCount = shaderCount.load(std::memory_order_relaxed);
+        outStats->cacheHits = cacheHits.load(std::memory_order_relaxed);
+    }
+
     // Sort the variants.
     auto compare = [](const auto& a, const auto& b) {
         static_assert(sizeof(decltype(a.variant.key)) == 1);
@@ -1005,7 +1085,8 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
 
     // Emit dictionary chunk (TextDictionaryReader and DictionaryTextChunk)
     const auto& dictionaryChunk = container.push<filamat::DictionaryTextChunk>(
-            std::move(textDictionary), ChunkType::DictionaryText);
+            std::move(textDictionary),
+            mCompressShaders ? ChunkType::DictionaryTextLz4 : ChunkType::DictionaryText);
 
     // Emit GLSL chunk (MaterialTextChunk).
     if (!glslEntries.empty()) {
@@ -1022,7 +1103,8 @@ bool MaterialBuilder::generateShaders(JobSystem& jobSystem, const std::vector<Va
     // Emit SPIRV chunks (SpirvDictionaryReader and MaterialSpirvChunk).
     if (!spirvEntries.empty()) {
         const bool stripInfo = !mGenerateDebugInfo;
-        container.push<filamat::DictionarySpirvChunk>(std::move(spirvDictionary), stripInfo);
+        container.push<filamat::DictionarySpirvChunk>(std::move(spirvDictionary), stripInfo,
+                mCompressShaders);
         container.push<MaterialSpirvChunk>(std::move(spirvEntries));
     }
 
@@ -1102,6 +1184,8 @@ error:
         return Package::invalidPackage();
     }
 
+    mShaderCompilationStats = {};
+
     // Force post process materials to be unlit. This prevents imposing a lot of extraneous
     // data, code, and expectations for materials which do not need them.
     if (mMaterialDomain == MaterialDomain::POST_PROCESS) {
@@ -1194,7 +1278,7 @@ error:
             break;
     }
 
-    success = generateShaders(jobSystem, variants, container, info);
+    success = generateShaders(jobSystem, variants, container, info, &mShaderCompilationStats);
     if (!success) {
         // Return an empty package to signal a failure to build the material.
         goto error;
@@ -16,25 +16,36 @@
 
 #include "DictionarySpirvChunk.h"
 
+#include "Lz4BlockWriter.h"
+
 #include <smolv.h>
 
 namespace filamat {
 
-DictionarySpirvChunk::DictionarySpirvChunk(BlobDictionary&& dictionary, bool stripDebugInfo) :
-        Chunk(ChunkType::DictionarySpirv), mDictionary(std::move(dictionary)), mStripDebugInfo(stripDebugInfo) {
+DictionarySpirvChunk::DictionarySpirvChunk(BlobDictionary&& dictionary, bool stripDebugInfo,
+        bool compress) :
+        Chunk(compress ? ChunkType::DictionarySpirvLz4 : ChunkType::DictionarySpirv),
+        mDictionary(std::move(dictionary)),
+        mStripDebugInfo(stripDebugInfo), mCompress(compress) {
 }
 
 void DictionarySpirvChunk::flatten(Flattener& f) {
 
-    // For now, 1 is the only acceptable compression scheme.
-    f.writeUint32(1);
+    // the LZ4 stream has no compression scheme and no alignment padding
+    Lz4BlockWriter writer;
+    if (mCompress) {
+        writer.writeUint32(mDictionary.getBlobCount());
+    } else {
+        // For now, 1 is the only acceptable compression scheme.
+        f.writeUint32(1);
+        f.writeUint32(mDictionary.getBlobCount());
+    }
 
     uint32_t flags = 0;
     if (mStripDebugInfo) {
         flags |= smolv::kEncodeFlagStripDebugInfo;
     }
 
-    f.writeUint32(mDictionary.getBlobCount());
     for (size_t i = 0 ; i < mDictionary.getBlobCount() ; i++) {
         std::string_view spirv = mDictionary.getBlob(i);
         smolv::ByteArray compressed;
@@ -42,8 +53,16 @@ void DictionarySpirvChunk::flatten(Flattener& f) {
             utils::slog.e << "Error with SPIRV compression" << utils::io::endl;
         }
 
-        f.writeAlignmentPadding();
-        f.writeBlob((const char*) compressed.data(), compressed.size());
+        if (mCompress) {
+            writer.writeBlob((const char*) compressed.data(), compressed.size());
+        } else {
+            f.writeAlignmentPadding();
+            f.writeBlob((const char*) compressed.data(), compressed.size());
+        }
+    }
+
+    if (mCompress) {
+        writer.flatten(f);
     }
 }
 
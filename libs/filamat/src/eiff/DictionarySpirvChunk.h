@@ -28,7 +28,10 @@ namespace filamat {
 
 class DictionarySpirvChunk final : public Chunk {
 public:
-    explicit DictionarySpirvChunk(BlobDictionary&& dictionary, bool stripDebugInfo);
+    // When compress is true, the smol-v blobs are further compressed with LZ4 and the chunk type
+    // is DictionarySpirvLz4.
+    explicit DictionarySpirvChunk(BlobDictionary&& dictionary, bool stripDebugInfo,
+            bool compress = false);
     ~DictionarySpirvChunk() = default;
 
 private:
@@ -36,6 +39,7 @@ private:
 
     BlobDictionary mDictionary;
     bool mStripDebugInfo;
+    bool mCompress;
 };
 
 } // namespace filamat
@@ -16,6 +16,8 @@
 
 #include "DictionaryTextChunk.h"
 
+#include "Lz4BlockWriter.h"
+
 namespace filamat {
 
 DictionaryTextChunk::DictionaryTextChunk(LineDictionary&& dictionary, ChunkType chunkType) :
@@ -23,6 +25,16 @@ DictionaryTextChunk::DictionaryTextChunk(LineDictionary&& dictionary, ChunkType
 }
 
 void DictionaryTextChunk::flatten(Flattener& f) {
+    if (getType() == ChunkType::DictionaryTextLz4) {
+        Lz4BlockWriter writer;
+        writer.writeUint32(mDictionary.getLineCount());
+        for (size_t i = 0 ; i < mDictionary.getLineCount() ; i++) {
+            writer.writeString(mDictionary.getString(i));
+        }
+        writer.flatten(f);
+        return;
+    }
+
     // NumStrings
     f.writeUint32(mDictionary.getLineCount());
 
@@ -28,6 +28,7 @@ namespace filamat {
 
 class DictionaryTextChunk final : public Chunk {
 public:
+    // chunkType is DictionaryText, or DictionaryTextLz4 to compress the strings with LZ4.
     DictionaryTextChunk(LineDictionary&& dictionary, ChunkType chunkType);
     ~DictionaryTextChunk() = default;
 
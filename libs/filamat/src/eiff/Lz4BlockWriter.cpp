@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Lz4BlockWriter.h"
+
+#include <filament/MaterialChunkType.h>
+
+#include <algorithm>
+
+#include <string.h>
+
+namespace filamat {
+
+void Lz4BlockWriter::writeUint32(uint32_t i) {
+    mData.push_back(static_cast<uint8_t>( i        & 0xff));
+    mData.push_back(static_cast<uint8_t>((i >> 8)  & 0xff));
+    mData.push_back(static_cast<uint8_t>((i >> 16) & 0xff));
+    mData.push_back(static_cast<uint8_t>( i >> 24));
+}
+
+void Lz4BlockWriter::writeString(std::string_view str) {
+    mData.insert(mData.end(), str.begin(), str.end());
+    mData.push_back(0);
+}
+
+void Lz4BlockWriter::writeBlob(const char* blob, size_t nbytes) {
+    writeUint32(uint32_t(nbytes));
+    mData.insert(mData.end(), blob, blob + nbytes);
+}
+
+void Lz4BlockWriter::flatten(Flattener& f) const {
+    constexpr size_t BLOCK_SIZE = DICTIONARY_LZ4_BLOCK_SIZE;
+    const size_t blockCount = (mData.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    f.writeUint32(uint32_t(blockCount));
+
+    std::vector<uint8_t> compressed;
+    for (size_t offset = 0; offset < mData.size(); offset += BLOCK_SIZE) {
+        const uint8_t* const src = mData.data() + offset;
+        const size_t size = std::min(BLOCK_SIZE, mData.size() - offset);
+        f.writeUint32(uint32_t(size));
+        if (compress(src, size, compressed) < size) {
+            f.writeBlob((const char*)compressed.data(), compressed.size());
+        } else {
+            // incompressible data is stored as is
+            f.writeBlob((const char*)src, size);
+        }
+    }
+}
+
+// See https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+size_t Lz4BlockWriter::compress(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& dst) {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t LAST_LITERALS = 5;     // the last 5 bytes are always literals
+    constexpr size_t MF_LIMIT = 12;         // the last match must start 12 bytes before the end
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr uint32_t HASH_BITS = 12;
+    constexpr uint32_t NONE = UINT32_MAX;
+
+    dst.clear();
+
+    auto read32 = [src](size_t i) {
+        uint32_t v;
+        memcpy(&v, src + i, sizeof(v));
+        return v;
+    };
+
+    auto writeLength = [&dst](size_t length) {
+        while (length >= 255) {
+            dst.push_back(255);
+            length -= 255;
+        }
+        dst.push_back(uint8_t(length));
+    };
+
+    auto writeSequence = [&](size_t anchor, size_t literalCount, size_t offset, size_t matchLength) {
+        const size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+        dst.push_back(uint8_t(std::min(literalCount, size_t(15)) << 4u |
+                              std::min(matchCode, size_t(15))));
+        if (literalCount >= 15) {
+            writeLength(literalCount - 15);
+        }
+        dst.insert(dst.end(), src + anchor, src + anchor + literalCount);
+        if (matchLength) {
+            dst.push_back(uint8_t(offset & 0xff));
+            dst.push_back(uint8_t(offset >> 8));
+            if (matchCode >= 15) {
+                writeLength(matchCode - 15);
+            }
+        }
+    };
+
+    size_t anchor = 0;
+    if (srcSize > MF_LIMIT) {
+        std::vector<uint32_t> table(1u << HASH_BITS, NONE);
+        const size_t matchLimit = srcSize - LAST_LITERALS;
+        size_t ip = 0;
+        while (ip + MF_LIMIT <= srcSize) {
+            const uint32_t sequence = read32(ip);
+            const uint32_t h = (sequence * 2654435761u) >> (32 - HASH_BITS);
+            const uint32_t ref = table[h];
+            table[h] = uint32_t(ip);
+            if (ref == NONE || ip - ref > MAX_OFFSET || read32(ref) != sequence) {
+                ip++;
+                continue;
+            }
+            size_t length = MIN_MATCH;
+            while (ip + length < matchLimit && src[ref + length] == src[ip + length]) {
+                length++;
+            }
+            writeSequence(anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    // the last sequence only has literals
+    writeSequence(anchor, srcSize - anchor, 0, 0);
+    return dst.size();
+}
+
+} // namespace filamat
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMAT_LZ4_BLOCK_WRITER_H
+#define TNT_FILAMAT_LZ4_BLOCK_WRITER_H
+
+#include "Flattener.h"
+
+#include <string_view>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filamat {
+
+// Accumulates a byte stream and flattens it as a sequence of independent LZ4 blocks of at most
+// DICTIONARY_LZ4_BLOCK_SIZE bytes (uncompressed), so that it can be decoded incrementally.
+//
+// Flattened layout:
+//     uint32_t blockCount
+//     blockCount times:
+//         uint32_t uncompressedSize
+//         blob     data (LZ4 block, or stored as is if it's the same size as uncompressedSize)
+class Lz4BlockWriter {
+public:
+    void writeUint32(uint32_t i);
+    void writeString(std::string_view str);
+    void writeBlob(const char* blob, size_t nbytes);
+
+    void flatten(Flattener& f) const;
+
+    // Compresses src into dst using the LZ4 block format. Returns the compressed size.
+    static size_t compress(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& dst);
+
+private:
+    std::vector<uint8_t> mData;
+};
+
+} // namespace filamat
+
+#endif // TNT_FILAMAT_LZ4_BLOCK_WRITER_H
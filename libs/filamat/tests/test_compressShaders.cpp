@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "eiff/ChunkContainer.h"
+#include "eiff/DictionaryTextChunk.h"
+#include "eiff/Flattener.h"
+#include "eiff/LineDictionary.h"
+
+#include <filamat/MaterialBuilder.h>
+#include <filamat/Package.h>
+
+#include <filaflat/ChunkContainer.h>
+#include <filaflat/DictionaryReader.h>
+
+#include <utils/JobSystem.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <string.h>
+
+using namespace filamat;
+
+namespace {
+
+std::vector<uint8_t> flattenTextDictionary(std::string const& text, ChunkType type) {
+    LineDictionary lines;
+    lines.addText(text);
+    filamat::ChunkContainer container;
+    container.push<DictionaryTextChunk>(std::move(lines), type);
+    std::vector<uint8_t> result(container.getSize());
+    Flattener f(result.data());
+    container.flatten(f);
+    return result;
+}
+
+// Checks that both forms of the text dictionary hold the lines of text, and returns the size of
+// the compressed form.
+size_t checkTextDictionary(std::string const& text) {
+    std::vector<uint8_t> const uncompressed =
+            flattenTextDictionary(text, ChunkType::DictionaryText);
+    std::vector<uint8_t> const compressed =
+            flattenTextDictionary(text, ChunkType::DictionaryTextLz4);
+
+    filaflat::ChunkContainer uncompressedContainer(uncompressed.data(), uncompressed.size());
+    filaflat::ChunkContainer compressedContainer(compressed.data(), compressed.size());
+    EXPECT_TRUE(uncompressedContainer.parse());
+    EXPECT_TRUE(compressedContainer.parse());
+    EXPECT_TRUE(compressedContainer.hasChunk(ChunkType::DictionaryTextLz4));
+    EXPECT_FALSE(compressedContainer.hasChunk(ChunkType::DictionaryText));
+
+    filaflat::BlobDictionary expected;
+    filaflat::BlobDictionary actual;
+    EXPECT_TRUE(filaflat::DictionaryReader::unflatten(
+            uncompressedContainer, ChunkType::DictionaryText, expected));
+    EXPECT_TRUE(filaflat::DictionaryReader::unflatten(
+            compressedContainer, ChunkType::DictionaryText, actual));
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < std::min(expected.size(), actual.size()); i++) {
+        EXPECT_EQ(std::string_view((const char*) expected[i].data(), expected[i].size()),
+                std::string_view((const char*) actual[i].data(), actual[i].size()));
+    }
+    return compressed.size();
+}
+
+filaflat::BlobDictionary getDictionary(Package const& package, ChunkType type) {
+    filaflat::ChunkContainer container(package.getData(), package.getSize());
+    filaflat::BlobDictionary dictionary;
+    EXPECT_TRUE(container.parse());
+    EXPECT_TRUE(filaflat::DictionaryReader::hasDictionary(container, type));
+    filaflat::DictionaryReader::unflatten(container, type, dictionary);
+    return dictionary;
+}
+
+} // namespace
+
+TEST(CompressShaders, TextDictionary) {
+    // well over DICTIONARY_LZ4_BLOCK_SIZE, so that lines straddle blocks
+    std::string text;
+    for (int i = 0; text.size() < 4 * DICTIONARY_LZ4_BLOCK_SIZE; i++) {
+        text += "    highp vec4 variable" + std::to_string(i) + " = texture(sampler, uv);\n";
+    }
+    size_t const compressedSize = checkTextDictionary(text);
+    EXPECT_LT(compressedSize, text.size() / 2);
+}
+
+TEST(CompressShaders, IncompressibleTextDictionary) {
+    // random lines don't compress, the blocks are stored as is
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> character(' ', '~');
+    std::string text;
+    while (text.size() < 2 * DICTIONARY_LZ4_BLOCK_SIZE) {
+        for (int i = 0; i < 100; i++) {
+            text += char(character(gen));
+        }
+        text += '\n';
+    }
+    size_t const compressedSize = checkTextDictionary(text);
+    EXPECT_LT(compressedSize, text.size() + 64);
+}
+
+TEST(CompressShaders, Material) {
+    auto build = [](bool compressShaders) {
+        utils::JobSystem jobSystem;
+        jobSystem.adopt();
+        MaterialBuilder builder;
+        builder.name("compressShaders")
+                .material("void material(inout MaterialInputs material) {\n"
+                          "    prepareMaterial(material);\n"
+                          "    material.baseColor = materialParams.baseColor;\n"
+                          "}\n")
+                .parameter("baseColor", MaterialBuilder::UniformType::FLOAT4)
+                .targetApi(MaterialBuilder::TargetApi::OPENGL | MaterialBuilder::TargetApi::VULKAN)
+                .platform(MaterialBuilder::Platform::MOBILE)
+                .compressShaders(compressShaders);
+        Package package = builder.build(jobSystem);
+        jobSystem.emancipate();
+        return package;
+    };
+
+    MaterialBuilder::init();
+    Package const uncompressed = build(false);
+    Package const compressed = build(true);
+    MaterialBuilder::shutdown();
+
+    ASSERT_TRUE(uncompressed.isValid());
+    ASSERT_TRUE(compressed.isValid());
+    EXPECT_LT(compressed.getSize(), uncompressed.getSize());
+
+    for (ChunkType type : { ChunkType::DictionaryText, ChunkType::DictionarySpirv }) {
+        filaflat::BlobDictionary const expected = getDictionary(uncompressed, type);
+        filaflat::BlobDictionary const actual = getDictionary(compressed, type);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ(expected[i].size(), actual[i].size());
+            EXPECT_EQ(0, memcmp(expected[i].data(), actual[i].data(), expected[i].size()));
+        }
+    }
+}
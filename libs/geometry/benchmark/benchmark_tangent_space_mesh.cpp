@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <geometry/TangentSpaceMesh.h>
+
+#include <math/scalar.h>
+#include <math/vec2.h>
+#include <math/vec3.h>
+#include <math/vec4.h>
+
+#include <utils/JobSystem.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace filament::geometry;
+using namespace filament::math;
+
+using Algorithm = TangentSpaceMesh::Algorithm;
+
+// Computes the tangent space of a UV sphere of about a million vertices, with and without a
+// JobSystem. The second argument of each benchmark is the number of JobSystem threads, where 0
+// means that no JobSystem is used.
+class TangentSpaceMeshFixture : public benchmark::Fixture {
+protected:
+    static constexpr uint32_t SEGMENTS = 1000;
+
+    std::vector<float3> positions;
+    std::vector<float3> normals;
+    std::vector<float4> tangents;
+    std::vector<float2> uvs;
+    std::vector<uint3> triangles;
+    std::unique_ptr<utils::JobSystem> js;
+
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (positions.empty()) {
+            for (uint32_t j = 0; j <= SEGMENTS; ++j) {
+                for (uint32_t i = 0; i <= SEGMENTS; ++i) {
+                    float2 const uv{ float(i) / SEGMENTS, float(j) / SEGMENTS };
+                    float const theta = uv.y * F_PI;
+                    float const phi = uv.x * 2.0f * F_PI;
+                    float3 const n{ std::sin(theta) * std::cos(phi), std::cos(theta),
+                            std::sin(theta) * std::sin(phi) };
+                    positions.push_back(n);
+                    normals.push_back(n);
+                    tangents.push_back({ -std::sin(phi), 0.0f, std::cos(phi), 1.0f });
+                    uvs.push_back(uv);
+                }
+            }
+            for (uint32_t j = 0; j < SEGMENTS; ++j) {
+                for (uint32_t i = 0; i < SEGMENTS; ++i) {
+                    uint32_t const a = j * (SEGMENTS + 1) + i;
+                    uint32_t const b = a + SEGMENTS + 1;
+                    triangles.push_back({ a, b, a + 1 });
+                    triangles.push_back({ a + 1, b, b + 1 });
+                }
+            }
+        }
+        if (state.range(1) > 0) {
+            js = std::make_unique<utils::JobSystem>(state.range(1));
+            js->adopt();
+        }
+    }
+
+    void TearDown(const benchmark::State&) override {
+        if (js) {
+            js->emancipate();
+            js.reset();
+        }
+    }
+
+    void run(benchmark::State& state, bool withNormals, bool withTangents) {
+        Algorithm const algorithm = Algorithm(state.range(0));
+        for (auto _ : state) {
+            TangentSpaceMesh::Builder builder;
+            builder.vertexCount(positions.size())
+                    .positions(positions.data())
+                            .triangleCount(triangles.size())
+                    .triangles(triangles.data())
+                    .algorithm(algorithm)
+                    .jobSystem(js.get());
+            if (withNormals) {
+                builder.normals(normals.data());
+            }
+            // Tangents are only used when mikktspace cannot be, i.e. without UVs.
+            if (withTangents) {
+                builder.tangents(tangents.data());
+            } else {
+                builder.uvs(uvs.data());
+            }
+            TangentSpaceMesh* mesh = builder.build();
+            benchmark::DoNotOptimize(mesh);
+            TangentSpaceMesh::destroy(mesh);
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(positions.size()));
+    }
+};
+
+BENCHMARK_DEFINE_F(TangentSpaceMeshFixture, NormalsOnly)(benchmark::State& state) {
+    run(state, true, false);
+}
+
+BENCHMARK_DEFINE_F(TangentSpaceMeshFixture, FlatShading)(benchmark::State& state) {
+    run(state, false, false);
+}
+
+BENCHMARK_DEFINE_F(TangentSpaceMeshFixture, TangentsProvided)(benchmark::State& state) {
+    run(state, true, true);
+}
+
+static void normalsOnlyArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "algorithm", "threads" });
+    for (Algorithm algorithm : { Algorithm::MIKKTSPACE, Algorithm::LENGYEL,
+            Algorithm::HUGHES_MOLLER, Algorithm::FRISVAD }) {
+        for (int64_t threads : { 0, 4, 8 }) {
+            b->Args({ int64_t(algorithm), threads });
+        }
+    }
+}
+
+static void defaultArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "algorithm", "threads" });
+    for (int64_t threads : { 0, 4, 8 }) {
+        b->Args({ int64_t(Algorithm::DEFAULT), threads });
+    }
+}
+
+BENCHMARK_REGISTER_F(TangentSpaceMeshFixture, NormalsOnly)
+        ->Apply(normalsOnlyArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(TangentSpaceMeshFixture, FlatShading)
+        ->Apply(defaultArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(TangentSpaceMeshFixture, TangentsProvided)
+        ->Apply(defaultArgs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_GEOMETRY_MESHMERGER_H
+#define TNT_GEOMETRY_MESHMERGER_H
+
+#include <math/mat4.h>
+#include <math/vec2.h>
+#include <math/vec3.h>
+#include <math/vec4.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+namespace geometry {
+
+struct MeshMergerInput;
+struct MeshMergerOutput;
+
+/**
+ * This class merges static meshes that share a material into a few large meshes, to reduce the
+ * number of draw calls of scenes made of many small objects.
+ *
+ * The transform of each input mesh is applied to its vertices during the merge, so the output is
+ * in the common space of the inputs, e.g. world space. To keep frustum culling effective, the
+ * triangles of each material are split spatially into clusters of at most
+ * Builder::maxClusterTriangles() triangles, and each cluster has its own bounding box. Each cluster
+ * is typically uploaded as a renderable.
+ *
+ * Tangent frames are output as normals and tangents. Clients that need Filament-style TANGENTS
+ * quaternions can compute them from the output with TangentSpaceMesh.
+ */
+class MeshMerger {
+public:
+    /**
+     * Optional vertex attributes. Within a material, the output has an attribute if any of the
+     * input meshes has it, and vertices of meshes that lack it get a default value:
+     * (0, 0, 1) for normals, (1, 0, 0, 1) for tangents, zero for UVs and white for colors.
+     */
+    enum class Attribute : uint8_t {
+        NORMALS = 0x0,      //!< float3, transformed by the inverse transpose of the transform
+        TANGENTS = 0x1,     //!< float4, xyz is transformed and w is the handedness
+        UV0 = 0x2,          //!< float2, copied
+        UV1 = 0x3,          //!< float2, copied
+        COLORS = 0x4,       //!< float4, copied
+    };
+
+    /**
+     * Describes an input mesh. All arrays are tightly packed, have vertexCount elements (or
+     * triangleCount elements for the triangles), and must stay valid until build() returns.
+     */
+    struct Mesh {
+        uint32_t material = 0;                          //!< meshes are merged by material
+        math::mat4f transform;                          //!< applied to the vertices
+        size_t vertexCount = 0;
+        math::float3 const* positions = nullptr;        //!< required
+        math::float3 const* normals = nullptr;
+        math::float4 const* tangents = nullptr;
+        math::float2 const* uv0 = nullptr;
+        math::float2 const* uv1 = nullptr;
+        math::float4 const* colors = nullptr;
+        size_t triangleCount = 0;
+        math::uint3 const* triangles32 = nullptr;       //!< either this or triangles16
+        math::ushort3 const* triangles16 = nullptr;
+    };
+
+    class Builder {
+    public:
+        Builder() noexcept;
+        ~Builder() noexcept;
+
+        /**
+         * Move constructor
+         */
+        Builder(Builder&& that) noexcept;
+
+        /**
+         * Move constructor
+         */
+        Builder& operator=(Builder&& that) noexcept;
+
+        Builder(Builder const&) = delete;
+        Builder& operator=(Builder const&) = delete;
+
+        /**
+         * Adds a mesh to merge.
+         *
+         * @param mesh The input mesh
+         * @return Builder
+         */
+        Builder& mesh(Mesh const& mesh) noexcept;
+
+        /**
+         * Sets the maximum number of triangles in an output cluster. Smaller clusters cull better,
+         * larger clusters need fewer draw calls. The default is 16384.
+         *
+         * @param count The maximum number of triangles, must be at least 1
+         * @return Builder
+         */
+        Builder& maxClusterTriangles(size_t count) noexcept;
+
+        /**
+         * Merges the meshes. The resulting object is owned by the callee, who must call
+         * MeshMerger::destroy on the object once they are finished with it.
+         *
+         * The state of the Builder will be reset after each call to build().
+         *
+         * @return A MeshMerger
+         */
+        MeshMerger* build();
+
+    private:
+        MeshMerger* mMerger = nullptr;
+    };
+
+    /**
+     * Destroy the merger object
+     * @param merger A pointer to a MeshMerger ready to be destroyed
+     */
+    static void destroy(MeshMerger* merger) noexcept;
+
+    MeshMerger(MeshMerger const&) = delete;
+    MeshMerger& operator=(MeshMerger const&) = delete;
+
+    /**
+     * @return The number of output clusters
+     */
+    size_t getClusterCount() const noexcept;
+
+    /**
+     * @param cluster Index of the cluster
+     * @return The material shared by all the meshes that were merged into the cluster
+     */
+    uint32_t getMaterial(size_t cluster) const noexcept;
+
+    /**
+     * @param cluster Index of the cluster
+     * @return The number of vertices in the cluster
+     */
+    size_t getVertexCount(size_t cluster) const noexcept;
+
+    /**
+     * @param cluster Index of the cluster
+     * @return The number of triangles in the cluster
+     */
+    size_t getTriangleCount(size_t cluster) const noexcept;
+
+    /**
+     * Gets the axis-aligned bounding box of the cluster.
+     *
+     * @param cluster Index of the cluster
+     * @param min Receives the minimum corner
+     * @param max Receives the maximum corner
+     */
+    void getBoundingBox(size_t cluster, math::float3* min, math::float3* max) const noexcept;
+
+    /**
+     * @param cluster Index of the cluster
+     * @param attribute The attribute of interest
+     * @return Whether the cluster has the given attribute
+     */
+    bool hasAttribute(size_t cluster, Attribute attribute) const noexcept;
+
+    /**
+     * Get output vertex positions.
+     * Assumes the `out` param is at least of getVertexCount() length (while accounting for
+     * `stride`).
+     *
+     * @param cluster Index of the cluster
+     * @param out     Client-allocated array that will be used for copying out positions.
+     * @param stride  Stride for iterating through `out`
+     */
+    void getPositions(size_t cluster, math::float3* out, size_t stride = 0) const noexcept;
+
+    /**
+     * Get an output attribute, which must be of the type of the given pointer.
+     * Assumes the `out` param is at least of getVertexCount() length (while accounting for
+     * `stride`). If the cluster does not have the attribute, we will throw an exception.
+     *
+     * @param cluster   Index of the cluster
+     * @param attribute The attribute of interest
+     * @param out       Client-allocated array that will be used for copying out the attribute.
+     * @param stride    Stride for iterating through `out`
+     */
+    void getAttribute(size_t cluster, Attribute attribute, math::float2* out,
+            size_t stride = 0) const;
+    void getAttribute(size_t cluster, Attribute attribute, math::float3* out,
+            size_t stride = 0) const;
+    void getAttribute(size_t cluster, Attribute attribute, math::float4* out,
+            size_t stride = 0) const;
+
+    /**
+     * Get output triangles.
+     * This method assumes that the `out` param provided by the client is at least of
+     * getTriangleCount() length.
+     *
+     * @param cluster Index of the cluster
+     * @param out     Client's array for the output triangles in unsigned 32-bit indices.
+     */
+    void getTriangles(size_t cluster, math::uint3* out) const noexcept;
+
+    /**
+     * Get output triangles.
+     * This method assumes that the `out` param provided by the client is at least of
+     * getTriangleCount() length. The cluster must have at most 65536 vertices, otherwise we will
+     * throw an exception.
+     *
+     * @param cluster Index of the cluster
+     * @param out     Client's array for the output triangles in unsigned 16-bit indices.
+     */
+    void getTriangles(size_t cluster, math::ushort3* out) const;
+
+private:
+    MeshMerger() noexcept;
+    ~MeshMerger() noexcept;
+
+    MeshMergerInput* mInput;
+    MeshMergerOutput* mOutput;
+
+    friend class Builder;
+};
+
+} // namespace geometry
+} // namespace filament
+
+#endif //TNT_GEOMETRY_MESHMERGER_H
@@ -23,6 +23,10 @@
 
 #include <variant>
 
+namespace utils {
+class JobSystem;
+} // namespace utils
+
 namespace filament {
 namespace geometry {
 
@@ -223,6 +227,20 @@ public:
          */
         Builder& algorithm(Algorithm algorithm) noexcept;
 
+        /**
+         * Splits the computation into chunks of vertices or triangles that run concurrently on the
+         * given JobSystem. build() still returns once the computation is complete, and the results
+         * are identical to those computed without a JobSystem. Algorithm::MIKKTSPACE always runs
+         * on the calling thread.
+         *
+         * build() must be called from a thread that belongs to the JobSystem, e.g. from a job or
+         * from a thread adopted with JobSystem::adopt().
+         *
+         * @param jobSystem The JobSystem to use, or nullptr to run on the calling thread (default)
+         * @return Builder
+         */
+        Builder& jobSystem(utils::JobSystem* jobSystem) noexcept;
+
         /**
          * Computes the tangent space mesh. The resulting mesh object is owned by the callee. The
          * callee must call TangentSpaceMesh::destroy on the object once they are finished with it.
@@ -0,0 +1,478 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/MeshMerger.h>
+
+#include <math/mat3.h>
+#include <math/vec3.h>
+
+#include <utils/Panic.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <limits.h>
+
+namespace filament {
+namespace geometry {
+
+using namespace filament::math;
+
+using Attribute = MeshMerger::Attribute;
+using Builder = MeshMerger::Builder;
+using Mesh = MeshMerger::Mesh;
+
+namespace {
+
+constexpr size_t DEFAULT_MAX_CLUSTER_TRIANGLES = 16384;
+
+constexpr float3 DEFAULT_NORMAL = { 0, 0, 1 };
+constexpr float4 DEFAULT_TANGENT = { 1, 0, 0, 1 };
+constexpr float2 DEFAULT_UV = { 0, 0 };
+constexpr float4 DEFAULT_COLOR = { 1, 1, 1, 1 };
+
+constexpr uint8_t bit(Attribute attribute) noexcept {
+    return uint8_t(1u << uint8_t(attribute));
+}
+
+// The vertices of all the meshes that share a material, in the common space of the inputs.
+struct MergedVertices {
+    uint8_t attributes = 0;
+    std::vector<float3> positions;
+    std::vector<float3> normals;
+    std::vector<float4> tangents;
+    std::vector<float2> uv0;
+    std::vector<float2> uv1;
+    std::vector<float4> colors;
+};
+
+} // anonymous namespace
+
+struct MeshMergerInput {
+    std::vector<Mesh> meshes;
+    size_t maxClusterTriangles = DEFAULT_MAX_CLUSTER_TRIANGLES;
+};
+
+struct MeshMergerOutput {
+    struct Cluster {
+        uint32_t material = 0;
+        uint8_t attributes = 0;
+        float3 min;
+        float3 max;
+        MergedVertices vertices;
+        std::vector<uint3> triangles;
+    };
+    std::vector<Cluster> clusters;
+};
+
+namespace {
+
+using Cluster = MeshMergerOutput::Cluster;
+
+template<typename T>
+void append(std::vector<T>& out, T const* in, size_t count, T defaultValue) {
+    if (in) {
+        out.insert(out.end(), in, in + count);
+    } else {
+        out.insert(out.end(), count, defaultValue);
+    }
+}
+
+// Appends the vertices of a mesh to the merged vertices, transformed by the mesh's transform, and
+// its triangles, rebased on the merged vertices.
+void appendMesh(Mesh const& mesh, MergedVertices& merged, std::vector<uint3>& triangles) {
+    size_t const base = merged.positions.size();
+    size_t const count = mesh.vertexCount;
+    uint8_t const attributes = merged.attributes;
+
+    mat4f const& transform = mesh.transform;
+    mat3f const upperLeft = transform.upperLeft();
+    bool const mirrored = det(upperLeft) < 0.0f;
+
+    // The cofactor matrix flips normals when mirroring, which would make them disagree with the
+    // flipped winding below.
+    mat3f const normalTransform =
+            mat3f::getTransformForNormals(upperLeft) * (mirrored ? -1.0f : 1.0f);
+
+    merged.positions.resize(base + count);
+    for (size_t i = 0; i < count; ++i) {
+        merged.positions[base + i] = (transform * float4{ mesh.positions[i], 1.0f }).xyz;
+    }
+
+    if (attributes & bit(Attribute::NORMALS)) {
+        append(merged.normals, mesh.normals, count, DEFAULT_NORMAL);
+        if (mesh.normals) {
+            for (size_t i = base; i < base + count; ++i) {
+                merged.normals[i] = normalize(normalTransform * merged.normals[i]);
+            }
+        }
+    }
+
+    if (attributes & bit(Attribute::TANGENTS)) {
+        append(merged.tangents, mesh.tangents, count, DEFAULT_TANGENT);
+        if (mesh.tangents) {
+            float const handedness = mirrored ? -1.0f : 1.0f;
+            for (size_t i = base; i < base + count; ++i) {
+                float4& tangent = merged.tangents[i];
+                tangent = { normalize(upperLeft * tangent.xyz), tangent.w * handedness };
+            }
+        }
+    }
+
+    if (attributes & bit(Attribute::UV0)) {
+        append(merged.uv0, mesh.uv0, count, DEFAULT_UV);
+    }
+    if (attributes & bit(Attribute::UV1)) {
+        append(merged.uv1, mesh.uv1, count, DEFAULT_UV);
+    }
+    if (attributes & bit(Attribute::COLORS)) {
+        append(merged.colors, mesh.colors, count, DEFAULT_COLOR);
+    }
+
+    // Mirroring transforms reverse the orientation of the triangles, so their winding is flipped
+    // to keep them front facing.
+    triangles.reserve(triangles.size() + mesh.triangleCount);
+    for (size_t i = 0; i < mesh.triangleCount; ++i) {
+        uint3 tri = mesh.triangles32 ? mesh.triangles32[i] : uint3(mesh.triangles16[i]);
+        if (mirrored) {
+            std::swap(tri.y, tri.z);
+        }
+        triangles.push_back(tri + uint32_t(base));
+    }
+}
+
+// Splits the triangles of a material into spatially coherent clusters, as a bounding volume
+// hierarchy would: ranges that are too large are split at the median centroid along their longest
+// axis, until every range fits in a cluster.
+class ClusterBuilder {
+public:
+    ClusterBuilder(uint32_t material, MergedVertices const& vertices,
+            std::vector<uint3> const& triangles, size_t maxClusterTriangles,
+            std::vector<Cluster>& clusters)
+            : mMaterial(material), mVertices(vertices), mTriangles(triangles),
+              mMaxClusterTriangles(maxClusterTriangles), mClusters(clusters),
+              mRemap(vertices.positions.size(), UNMAPPED) {
+        mOrder.resize(triangles.size());
+        mCentroids.resize(triangles.size());
+        float3 const* positions = vertices.positions.data();
+        for (size_t i = 0, n = triangles.size(); i < n; ++i) {
+            uint3 const tri = triangles[i];
+            mOrder[i] = uint32_t(i);
+            mCentroids[i] = (positions[tri.x] + positions[tri.y] + positions[tri.z]) / 3.0f;
+        }
+    }
+
+    void build() {
+        if (!mOrder.empty()) {
+            split(0, mOrder.size());
+        }
+    }
+
+private:
+    static constexpr uint32_t UNMAPPED = std::numeric_limits<uint32_t>::max();
+
+    void split(size_t begin, size_t end) {
+        size_t const count = end - begin;
+        if (count <= mMaxClusterTriangles) {
+            emit(begin, end);
+            return;
+        }
+
+        float3 lo = std::numeric_limits<float>::max();
+        float3 hi = std::numeric_limits<float>::lowest();
+        for (size_t i = begin; i < end; ++i) {
+            lo = min(lo, mCentroids[mOrder[i]]);
+            hi = max(hi, mCentroids[mOrder[i]]);
+        }
+        float3 const extent = hi - lo;
+        int const axis = extent.x >= extent.y && extent.x >= extent.z ? 0 :
+                extent.y >= extent.z ? 1 : 2;
+
+        size_t const middle = begin + count / 2;
+        float3 const* centroids = mCentroids.data();
+        std::nth_element(mOrder.begin() + begin, mOrder.begin() + middle, mOrder.begin() + end,
+                [centroids, axis](uint32_t a, uint32_t b) {
+                    return centroids[a][axis] < centroids[b][axis];
+                });
+
+        split(begin, middle);
+        split(middle, end);
+    }
+
+    template<typename T>
+    static void gather(std::vector<T>& out, std::vector<T> const& in,
+            std::vector<uint32_t> const& vertices) {
+        if (in.empty()) {
+            return;
+        }
+        out.resize(vertices.size());
+        for (size_t i = 0, n = vertices.size(); i < n; ++i) {
+            out[i] = in[vertices[i]];
+        }
+    }
+
+    void emit(size_t begin, size_t end) {
+        Cluster& cluster = mClusters.emplace_back();
+        cluster.material = mMaterial;
+        cluster.attributes = mVertices.attributes;
+        cluster.triangles.resize(end - begin);
+
+        // Keep the original order of the triangles within the cluster, which is usually better
+        // for the post-transform vertex cache than the order of the split.
+        std::sort(mOrder.begin() + begin, mOrder.begin() + end);
+
+        // Compact the vertices that are referenced by the cluster.
+        std::vector<uint32_t> vertices;
+        for (size_t i = begin; i < end; ++i) {
+            uint3 const tri = mTriangles[mOrder[i]];
+            uint3 out;
+            for (int j = 0; j < 3; ++j) {
+                uint32_t& index = mRemap[tri[j]];
+                if (index == UNMAPPED) {
+                    index = uint32_t(vertices.size());
+                    vertices.push_back(tri[j]);
+                }
+                out[j] = index;
+            }
+            cluster.triangles[i - begin] = out;
+        }
+        for (uint32_t vertex : vertices) {
+            mRemap[vertex] = UNMAPPED;
+        }
+
+        MergedVertices& out = cluster.vertices;
+        out.attributes = mVertices.attributes;
+        gather(out.positions, mVertices.positions, vertices);
+        gather(out.normals, mVertices.normals, vertices);
+        gather(out.tangents, mVertices.tangents, vertices);
+        gather(out.uv0, mVertices.uv0, vertices);
+        gather(out.uv1, mVertices.uv1, vertices);
+        gather(out.colors, mVertices.colors, vertices);
+
+        cluster.min = std::numeric_limits<float>::max();
+        cluster.max = std::numeric_limits<float>::lowest();
+        for (float3 const& position : out.positions) {
+            cluster.min = min(cluster.min, position);
+            cluster.max = max(cluster.max, position);
+        }
+    }
+
+    uint32_t const mMaterial;
+    MergedVertices const& mVertices;
+    std::vector<uint3> const& mTriangles;
+    size_t const mMaxClusterTriangles;
+    std::vector<Cluster>& mClusters;
+    std::vector<uint32_t> mRemap;
+    std::vector<uint32_t> mOrder;
+    std::vector<float3> mCentroids;
+};
+
+template<typename T>
+void copyOut(std::vector<T> const& in, T* out, size_t stride) {
+    stride = stride ? stride : sizeof(T);
+    for (T const& value : in) {
+        *out = value;
+        out = (T*) (((uint8_t*) out) + stride);
+    }
+}
+
+} // anonymous namespace
+
+Builder::Builder() noexcept
+        :mMerger(new MeshMerger()) {}
+
+Builder::~Builder() noexcept {
+    delete mMerger;
+}
+
+Builder::Builder(Builder&& that) noexcept {
+    std::swap(mMerger, that.mMerger);
+}
+
+Builder& Builder::operator=(Builder&& that) noexcept {
+    std::swap(mMerger, that.mMerger);
+    return *this;
+}
+
+Builder& Builder::mesh(Mesh const& mesh) noexcept {
+    mMerger->mInput->meshes.push_back(mesh);
+    return *this;
+}
+
+Builder& Builder::maxClusterTriangles(size_t count) noexcept {
+    mMerger->mInput->maxClusterTriangles = count;
+    return *this;
+}
+
+MeshMerger* Builder::build() {
+    MeshMergerInput const* input = mMerger->mInput;
+    ASSERT_PRECONDITION(input->maxClusterTriangles > 0, "Clusters must have at least 1 triangle");
+    for (Mesh const& mesh : input->meshes) {
+        ASSERT_PRECONDITION(!mesh.vertexCount || mesh.positions, "Must provide input positions");
+        ASSERT_PRECONDITION(!mesh.triangles32 || !mesh.triangles16,
+                "Cannot provide both uint32 triangles and uint16 triangles");
+        ASSERT_PRECONDITION(!mesh.triangleCount || mesh.triangles32 || mesh.triangles16,
+                "Must provide input triangles");
+    }
+
+    // Group the meshes by material. An ordered map keeps the output independent of the order of
+    // the input meshes' materials.
+    std::map<uint32_t, std::vector<Mesh const*>> materials;
+    for (Mesh const& mesh : input->meshes) {
+        materials[mesh.material].push_back(&mesh);
+    }
+
+    std::vector<Cluster>& clusters = mMerger->mOutput->clusters;
+    for (auto const& [material, meshes] : materials) {
+        MergedVertices vertices;
+        size_t vertexCount = 0;
+        size_t triangleCount = 0;
+        for (Mesh const* mesh : meshes) {
+            vertices.attributes |=
+                    (mesh->normals ? bit(Attribute::NORMALS) : 0) |
+                    (mesh->tangents ? bit(Attribute::TANGENTS) : 0) |
+                    (mesh->uv0 ? bit(Attribute::UV0) : 0) |
+                    (mesh->uv1 ? bit(Attribute::UV1) : 0) |
+                    (mesh->colors ? bit(Attribute::COLORS) : 0);
+            vertexCount += mesh->vertexCount;
+            triangleCount += mesh->triangleCount;
+        }
+        ASSERT_PRECONDITION(vertexCount <= std::numeric_limits<uint32_t>::max(),
+                "Too many vertices for material %u", material);
+
+        vertices.positions.reserve(vertexCount);
+        std::vector<uint3> triangles;
+        triangles.reserve(triangleCount);
+        for (Mesh const* mesh : meshes) {
+            appendMesh(*mesh, vertices, triangles);
+        }
+
+        ClusterBuilder(material, vertices, triangles, input->maxClusterTriangles, clusters).build();
+    }
+
+    auto mergerPtr = mMerger;
+    // Reset the state.
+    mMerger = new MeshMerger();
+
+    return mergerPtr;
+}
+
+void MeshMerger::destroy(MeshMerger* merger) noexcept {
+    delete merger;
+}
+
+MeshMerger::MeshMerger() noexcept
+        :mInput(new MeshMergerInput()), mOutput(new MeshMergerOutput()) {
+}
+
+MeshMerger::~MeshMerger() noexcept {
+    delete mOutput;
+    delete mInput;
+}
+
+size_t MeshMerger::getClusterCount() const noexcept {
+    return mOutput->clusters.size();
+}
+
+uint32_t MeshMerger::getMaterial(size_t cluster) const noexcept {
+    return mOutput->clusters[cluster].material;
+}
+
+size_t MeshMerger::getVertexCount(size_t cluster) const noexcept {
+    return mOutput->clusters[cluster].vertices.positions.size();
+}
+
+size_t MeshMerger::getTriangleCount(size_t cluster) const noexcept {
+    return mOutput->clusters[cluster].triangles.size();
+}
+
+void MeshMerger::getBoundingBox(size_t cluster, float3* min, float3* max) const noexcept {
+    Cluster const& c = mOutput->clusters[cluster];
+    *min = c.min;
+    *max = c.max;
+}
+
+bool MeshMerger::hasAttribute(size_t cluster, Attribute attribute) const noexcept {
+    return mOutput->clusters[cluster].attributes & bit(attribute);
+}
+
+void MeshMerger::getPositions(size_t cluster, float3* out, size_t stride) const noexcept {
+    copyOut(mOutput->clusters[cluster].vertices.positions, out, stride);
+}
+
+void MeshMerger::getAttribute(size_t cluster, Attribute attribute, float2* out,
+        size_t stride) const {
+    ASSERT_PRECONDITION(hasAttribute(cluster, attribute), "Cluster does not have the attribute");
+    MergedVertices const& vertices = mOutput->clusters[cluster].vertices;
+    switch (attribute) {
+        case Attribute::UV0:
+            copyOut(vertices.uv0, out, stride);
+            break;
+        case Attribute::UV1:
+            copyOut(vertices.uv1, out, stride);
+            break;
+        default:
+            PANIC_PRECONDITION("Incorrect attribute data type");
+    }
+}
+
+void MeshMerger::getAttribute(size_t cluster, Attribute attribute, float3* out,
+        size_t stride) const {
+    ASSERT_PRECONDITION(hasAttribute(cluster, attribute), "Cluster does not have the attribute");
+    MergedVertices const& vertices = mOutput->clusters[cluster].vertices;
+    switch (attribute) {
+        case Attribute::NORMALS:
+            copyOut(vertices.normals, out, stride);
+            break;
+        default:
+            PANIC_PRECONDITION("Incorrect attribute data type");
+    }
+}
+
+void MeshMerger::getAttribute(size_t cluster, Attribute attribute, float4* out,
+        size_t stride) const {
+    ASSERT_PRECONDITION(hasAttribute(cluster, attribute), "Cluster does not have the attribute");
+    MergedVertices const& vertices = mOutput->clusters[cluster].vertices;
+    switch (attribute) {
+        case Attribute::TANGENTS:
+            copyOut(vertices.tangents, out, stride);
+            break;
+        case Attribute::COLORS:
+            copyOut(vertices.colors, out, stride);
+            break;
+        default:
+            PANIC_PRECONDITION("Incorrect attribute data type");
+    }
+}
+
+void MeshMerger::getTriangles(size_t cluster, uint3* out) const noexcept {
+    std::vector<uint3> const& triangles = mOutput->clusters[cluster].triangles;
+    std::copy(triangles.begin(), triangles.end(), out);
+}
+
+void MeshMerger::getTriangles(size_t cluster, ushort3* out) const {
+    ASSERT_PRECONDITION(getVertexCount(cluster) <= USHRT_MAX + 1,
+            "Cannot output triangles of a cluster with more than 65536 vertices in uint16");
+    for (uint3 const& tri : mOutput->clusters[cluster].triangles) {
+        *out++ = ushort3(tri);
+    }
+}
+
+} // namespace geometry
+} // namespace filament
@@ -22,9 +22,12 @@
 #include <math/mat3.h>
 #include <math/norm.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 #include <utils/Panic.h>
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 
 namespace filament {
@@ -83,6 +86,33 @@ std::string_view to_string(AlgorithmImpl const algorithm) noexcept {
     }
 }
 
+// With a JobSystem, vertices and triangles are processed in chunks of this size.
+constexpr size_t const CHUNK_SIZE = 4096;
+
+// Normals are processed in batches of this size, stored as structures of arrays so that the
+// frame kernels can be vectorized by the compiler.
+constexpr size_t const BATCH_SIZE = 16;
+
+// Calls work(start, count) on chunks of [0, count), concurrently if a JobSystem is provided. Each
+// element is always computed the same way, so the results do not depend on the JobSystem.
+template<typename Work>
+void parallelFor(utils::JobSystem* js, size_t count, Work const& work) {
+    if (!js || count <= CHUNK_SIZE) {
+        work(0, count);
+        return;
+    }
+    auto chunk = [&work](uint32_t start, uint32_t count) { work(start, count); };
+    utils::JobSystem::Job* job = utils::jobs::parallel_for(*js, nullptr, 0, uint32_t(count),
+            std::cref(chunk), utils::jobs::CountSplitter<CHUNK_SIZE>());
+    js->runAndWait(job);
+}
+
+struct FrameBatch {
+    float nx[BATCH_SIZE], ny[BATCH_SIZE], nz[BATCH_SIZE];
+    float tx[BATCH_SIZE], ty[BATCH_SIZE], tz[BATCH_SIZE];
+    float bx[BATCH_SIZE], by[BATCH_SIZE], bz[BATCH_SIZE];
+};
+
 inline bool isInputType(uint8_t const inputType, uint8_t const checkType) noexcept {
     return ((inputType & checkType) == checkType);
 }
@@ -182,51 +212,76 @@ inline std::pair<float3, float3> frisvadKernel(float3 const& n) {
     return {b, t};
 }
 
-void frisvadMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output)
-        noexcept {
-    size_t const vertexCount = input->vertexCount;
-    quatf* quats = output->tspace().allocate(vertexCount);
-
-    float3 const* UTILS_RESTRICT normals = input->normals();
-    size_t const nstride = input->normalsStride();
+// Branchless version of frisvadKernel() over a batch, which gives the same results.
+void frisvadBatch(FrameBatch& batch) noexcept {
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        float const nx = batch.nx[i];
+        float const ny = batch.ny[i];
+        float const nz = batch.nz[i];
+        bool const singular = ny < -1.0f + std::numeric_limits<float>::epsilon();
+        float const va = 1.0f / (1.0f + ny);
+        float const vb = -nz * nx * va;
+        batch.tx[i] = singular ? -1.0f : vb;
+        batch.ty[i] = singular ?  0.0f : -nz;
+        batch.tz[i] = singular ?  0.0f : 1.0f - nz * nz * va;
+        batch.bx[i] = singular ?  0.0f : 1.0f - nx * nx * va;
+        batch.by[i] = singular ?  0.0f : -nx;
+        batch.bz[i] = singular ? -1.0f : vb;
+    }
+}
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 const n = *normals;
-        auto const [b, t] = frisvadKernel(n);
-        quats[qindex] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
-        normals = pointerAdd(normals, 1, nstride);
+void hughesMollerBatch(FrameBatch& batch) noexcept {
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        float const nx = batch.nx[i];
+        float const ny = batch.ny[i];
+        float const nz = batch.nz[i];
+        bool const useXY = std::abs(nx) > std::abs(nz) + std::numeric_limits<float>::epsilon();
+        float tx = useXY ? -ny : 0.0f;
+        float ty = useXY ?  nx : -nz;
+        float tz = useXY ? 0.0f : ny;
+        float const r = 1.0f / std::sqrt(tx * tx + ty * ty + tz * tz);
+        tx *= r;
+        ty *= r;
+        tz *= r;
+        batch.tx[i] = tx;
+        batch.ty[i] = ty;
+        batch.tz[i] = tz;
+        batch.bx[i] = ny * tz - nz * ty;
+        batch.by[i] = nz * tx - nx * tz;
+        batch.bz[i] = nx * ty - ny * tx;
     }
-    output->vertexCount = input->vertexCount;
-    output->triangleCount = input->triangleCount;
-    output->passthrough(input->attributeData, {AttributeImpl::UV0, AttributeImpl::POSITIONS});
-    output->passthrough(input->attributeData, input->getAuxAttributes());
-    output->triangles32.borrow(input->triangles32);
-    output->triangles16.borrow(input->triangles16);
 }
 
-void hughesMollerMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output)
-        noexcept {
+// Computes a tangent frame for each normal with the given batch kernel.
+void normalsOnlyMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output,
+        void (*kernel)(FrameBatch&) noexcept) noexcept {
     size_t const vertexCount = input->vertexCount;
     quatf* quats = output->tspace().allocate(vertexCount);
 
     float3 const* UTILS_RESTRICT normals = input->normals();
     size_t const nstride = input->normalsStride();
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 const n = *normals;
-        float3 b, t;
-
-        if (abs(n.x) > abs(n.z) + std::numeric_limits<float>::epsilon()) {
-            t = float3{-n.y, n.x, 0.0f};
-        } else {
-            t = float3{0.0f, -n.z, n.y};
+    parallelFor(input->jobSystem, vertexCount, [=](size_t start, size_t count) {
+        FrameBatch batch;
+        for (size_t first = start, end = start + count; first < end; first += BATCH_SIZE) {
+            size_t const n = std::min(BATCH_SIZE, end - first);
+            for (size_t i = 0; i < BATCH_SIZE; ++i) {
+                // The lanes past the end of the chunk get a valid normal, and are not stored.
+                float3 const v = i < n ? *pointerAdd(normals, first + i, nstride) : float3{0, 0, 1};
+                batch.nx[i] = v.x;
+                batch.ny[i] = v.y;
+                batch.nz[i] = v.z;
+            }
+            kernel(batch);
+            for (size_t i = 0; i < n; ++i) {
+                float3 const t{ batch.tx[i], batch.ty[i], batch.tz[i] };
+                float3 const b{ batch.bx[i], batch.by[i], batch.bz[i] };
+                float3 const nrm{ batch.nx[i], batch.ny[i], batch.nz[i] };
+                quats[first + i] = mat3f::packTangentFrame({t, b, nrm}, sizeof(int32_t));
+            }
         }
-        t = normalize(t);
-        b = cross(n, t);
+    });
 
-        quats[qindex] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
-        normals = pointerAdd(normals, 1, nstride);
-    }
     output->vertexCount = input->vertexCount;
     output->triangleCount = input->triangleCount;
     output->passthrough(input->attributeData, {AttributeImpl::UV0, AttributeImpl::POSITIONS});
@@ -235,6 +290,16 @@ void hughesMollerMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutp
     output->triangles16.borrow(input->triangles16);
 }
 
+void frisvadMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output)
+        noexcept {
+    normalsOnlyMethod(input, output, frisvadBatch);
+}
+
+void hughesMollerMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output)
+        noexcept {
+    normalsOnlyMethod(input, output, hughesMollerBatch);
+}
+
 void flatShadingMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output)
         noexcept {
     bool const isTriangle16 = input->triangles16 != nullptr;
@@ -309,66 +374,67 @@ void flatShadingMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutpu
     size_t const outTriangleCount = triangleCount;
     uint3* outTriangles = output->triangles32.allocate(outTriangleCount);
 
-    size_t vindex = 0;
-    for (size_t tindex = 0; tindex < triangleCount; ++tindex) {
-        uint3 tri = isTriangle16 ?
-                uint3(*(ushort3*)(pointerAdd(triangles, tindex, tstride))) :
-                *(uint3*)(pointerAdd(triangles, tindex, tstride));
-
-        float3 const pa = *pointerAdd(positions, tri.x, pstride);
-        float3 const pb = *pointerAdd(positions, tri.y, pstride);
-        float3 const pc = *pointerAdd(positions, tri.z, pstride);
-
-        uint32_t i0 = vindex++, i1 = vindex++, i2 = vindex++;
-        outTriangles[tindex] = uint3{i0, i1, i2};
-
-        outPositions[i0] = pa;
-        outPositions[i1] = pb;
-        outPositions[i2] = pc;
-
-        float3 const n = normalize(cross(pc - pb, pa - pb));
-        const auto [t, b] = frisvadKernel(n);
-
-        quatf const tspace = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
-        quats[i0] = tspace;
-        quats[i1] = tspace;
-        quats[i2] = tspace;
-
-        // We need to make sure that the aux data is ported to the new mesh
-        for (auto& [indata, outdata, attrib, stride]: outAttributes) {
-            if (std::holds_alternative<float2 const*>(indata)) {
-                float2* out = std::get<float2*>(outdata);
-                float2 const* in = std::get<float2 const*>(indata);
-                out[i0] = *pointerAdd(in, tri.x, stride);
-                out[i1] = *pointerAdd(in, tri.y, stride);
-                out[i2] = *pointerAdd(in, tri.z, stride);
-            } else if (std::holds_alternative<float3 const*>(indata)) {
-                float3* out = std::get<float3*>(outdata);
-                float3 const* in = std::get<float3 const*>(indata);
-                out[i0] = *pointerAdd(in, tri.x, stride);
-                out[i1] = *pointerAdd(in, tri.y, stride);
-                out[i2] = *pointerAdd(in, tri.z, stride);
-            } else if (std::holds_alternative<float4 const*>(indata)) {
-                float4* out = std::get<float4*>(outdata);
-                float4 const* in = std::get<float4 const*>(indata);
-                out[i0] = *pointerAdd(in, tri.x, stride);
-                out[i1] = *pointerAdd(in, tri.y, stride);
-                out[i2] = *pointerAdd(in, tri.z, stride);
-            } else if (std::holds_alternative<ushort3 const*>(indata)) {
-                ushort3* out = std::get<ushort3*>(outdata);
-                ushort3 const* in = std::get<ushort3 const*>(indata);
-                out[i0] = *pointerAdd(in, tri.x, stride);
-                out[i1] = *pointerAdd(in, tri.y, stride);
-                out[i2] = *pointerAdd(in, tri.z, stride);
-            } else if (std::holds_alternative<ushort4 const*>(indata)) {
-                ushort4* out = std::get<ushort4*>(outdata);
-                ushort4 const* in = std::get<ushort4 const*>(indata);
-                out[i0] = *pointerAdd(in, tri.x, stride);
-                out[i1] = *pointerAdd(in, tri.y, stride);
-                out[i2] = *pointerAdd(in, tri.z, stride);
+    parallelFor(input->jobSystem, triangleCount, [&](size_t start, size_t count) {
+        for (size_t tindex = start; tindex < start + count; ++tindex) {
+            uint3 tri = isTriangle16 ?
+                    uint3(*(ushort3*)(pointerAdd(triangles, tindex, tstride))) :
+                    *(uint3*)(pointerAdd(triangles, tindex, tstride));
+
+            float3 const pa = *pointerAdd(positions, tri.x, pstride);
+            float3 const pb = *pointerAdd(positions, tri.y, pstride);
+            float3 const pc = *pointerAdd(positions, tri.z, pstride);
+
+            uint32_t const i0 = uint32_t(tindex * 3), i1 = i0 + 1, i2 = i0 + 2;
+            outTriangles[tindex] = uint3{i0, i1, i2};
+
+            outPositions[i0] = pa;
+            outPositions[i1] = pb;
+            outPositions[i2] = pc;
+
+            float3 const n = normalize(cross(pc - pb, pa - pb));
+            const auto [t, b] = frisvadKernel(n);
+
+            quatf const tspace = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+            quats[i0] = tspace;
+            quats[i1] = tspace;
+            quats[i2] = tspace;
+
+            // We need to make sure that the aux data is ported to the new mesh
+            for (auto const& [indata, outdata, attrib, stride]: outAttributes) {
+                if (std::holds_alternative<float2 const*>(indata)) {
+                    float2* out = std::get<float2*>(outdata);
+                    float2 const* in = std::get<float2 const*>(indata);
+                    out[i0] = *pointerAdd(in, tri.x, stride);
+                    out[i1] = *pointerAdd(in, tri.y, stride);
+                    out[i2] = *pointerAdd(in, tri.z, stride);
+                } else if (std::holds_alternative<float3 const*>(indata)) {
+                    float3* out = std::get<float3*>(outdata);
+                    float3 const* in = std::get<float3 const*>(indata);
+                    out[i0] = *pointerAdd(in, tri.x, stride);
+                    out[i1] = *pointerAdd(in, tri.y, stride);
+                    out[i2] = *pointerAdd(in, tri.z, stride);
+                } else if (std::holds_alternative<float4 const*>(indata)) {
+                    float4* out = std::get<float4*>(outdata);
+                    float4 const* in = std::get<float4 const*>(indata);
+                    out[i0] = *pointerAdd(in, tri.x, stride);
+                    out[i1] = *pointerAdd(in, tri.y, stride);
+                    out[i2] = *pointerAdd(in, tri.z, stride);
+                } else if (std::holds_alternative<ushort3 const*>(indata)) {
+                    ushort3* out = std::get<ushort3*>(outdata);
+                    ushort3 const* in = std::get<ushort3 const*>(indata);
+                    out[i0] = *pointerAdd(in, tri.x, stride);
+                    out[i1] = *pointerAdd(in, tri.y, stride);
+                    out[i2] = *pointerAdd(in, tri.z, stride);
+                } else if (std::holds_alternative<ushort4 const*>(indata)) {
+                    ushort4* out = std::get<ushort4*>(outdata);
+                    ushort4 const* in = std::get<ushort4 const*>(indata);
+                    out[i0] = *pointerAdd(in, tri.x, stride);
+                    out[i1] = *pointerAdd(in, tri.y, stride);
+                    out[i2] = *pointerAdd(in, tri.z, stride);
+                }
             }
         }
-    }
+    });
 
     output->vertexCount = outVertexCount;
     output->triangleCount = outTriangleCount;
@@ -385,20 +451,22 @@ void tangentsProvidedMethod(TangentSpaceMeshInput const* input, TangentSpaceMesh
     float4 const* tanvec = input->tangents();
     size_t const tstride = input->tangentsStride();
 
-    for (size_t qindex = 0; qindex < vertexCount; ++qindex) {
-        float3 const& n = *pointerAdd(normal, qindex, nstride);
-        float4 const& t4 = *pointerAdd(tanvec, qindex, nstride);
-        float3 tv = t4.xyz;
-        float3 b = t4.w > 0 ? cross(tv, n) : cross(n, tv);
+    parallelFor(input->jobSystem, vertexCount, [=](size_t start, size_t count) {
+        for (size_t qindex = start; qindex < start + count; ++qindex) {
+            float3 const& n = *pointerAdd(normal, qindex, nstride);
+            float4 const& t4 = *pointerAdd(tanvec, qindex, tstride);
+            float3 tv = t4.xyz;
+            float3 b = t4.w > 0 ? cross(tv, n) : cross(n, tv);
 
-        // Some assets do not provide perfectly orthogonal tangents and normals, so we adjust the
-        // tangent to enforce orthonormality. We would rather honor the exact normal vector than
-        // the exact tangent vector since the latter is only used for bump mapping and anisotropic
-        // lighting.
-        tv = t4.w > 0 ? cross(n, b) : cross(b, n);
+            // Some assets do not provide perfectly orthogonal tangents and normals, so we adjust
+            // the tangent to enforce orthonormality. We would rather honor the exact normal vector
+            // than the exact tangent vector since the latter is only used for bump mapping and
+            // anisotropic lighting.
+            tv = t4.w > 0 ? cross(n, b) : cross(b, n);
 
-        quats[qindex] = mat3f::packTangentFrame({tv, b, n});
-    }
+            quats[qindex] = mat3f::packTangentFrame({tv, b, n});
+        }
+    });
 
     output->vertexCount = vertexCount;
     output->triangleCount = input->triangleCount;
@@ -408,6 +476,7 @@ void tangentsProvidedMethod(TangentSpaceMeshInput const* input, TangentSpaceMesh
     output->triangles16.borrow(input->triangles16);
 }
 
+// The mikktspace library has no support for concurrency, so this ignores the JobSystem.
 void mikktspaceMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* output) {
     MikktspaceImpl impl(input);
     impl.run(output);
@@ -435,65 +504,79 @@ void lengyelMethod(TangentSpaceMeshInput const* input, TangentSpaceMeshOutput* o
     auto uvs = input->uvs();
     auto normals = input->normals();
 
+    // The directions of each triangle are computed concurrently, then summed per vertex in
+    // triangle order, so that the sums do not depend on the JobSystem.
+    std::vector<float3> sdirs(triangleCount);
+    std::vector<float3> tdirs(triangleCount);
+    parallelFor(input->jobSystem, triangleCount, [&](size_t start, size_t count) {
+        for (size_t a = start; a < start + count; ++a) {
+            uint3 tri = triangles16 ? uint3(triangles16[a]) : triangles32[a];
+            assert_invariant(tri.x < vertexCount && tri.y < vertexCount && tri.z < vertexCount);
+            float3 const& v1 = *pointerAdd(positions, tri.x, positionStride);
+            float3 const& v2 = *pointerAdd(positions, tri.y, positionStride);
+            float3 const& v3 = *pointerAdd(positions, tri.z, positionStride);
+            float2 const& w1 = *pointerAdd(uvs, tri.x, uvStride);
+            float2 const& w2 = *pointerAdd(uvs, tri.y, uvStride);
+            float2 const& w3 = *pointerAdd(uvs, tri.z, uvStride);
+            float const x1 = v2.x - v1.x;
+            float const x2 = v3.x - v1.x;
+            float const y1 = v2.y - v1.y;
+            float const y2 = v3.y - v1.y;
+            float const z1 = v2.z - v1.z;
+            float const z2 = v3.z - v1.z;
+            float const s1 = w2.x - w1.x;
+            float const s2 = w3.x - w1.x;
+            float const t1 = w2.y - w1.y;
+            float const t2 = w3.y - w1.y;
+            float const d = s1 * t2 - s2 * t1;
+            float3 sdir, tdir;
+            // In general we can't guarantee smooth tangents when the UV's are non-smooth, but let's
+            // at least avoid divide-by-zero and fall back to normals-only method.
+            if (d == 0.0) {
+                float3 const& n1 = *pointerAdd(normals, tri.x, normalStride);
+                sdir = randomPerp(n1);
+                tdir = cross(n1, sdir);
+            } else {
+                sdir = {t2 * x1 - t1 * x2, t2 * y1 - t1 * y2, t2 * z1 - t1 * z2};
+                tdir = {s1 * x2 - s2 * x1, s1 * y2 - s2 * y1, s1 * z2 - s2 * z1};
+                float const r = 1.0f / d;
+                sdir *= r;
+                tdir *= r;
+            }
+            sdirs[a] = sdir;
+            tdirs[a] = tdir;
+        }
+    });
+
     std::vector<float3> tan1(vertexCount, float3{0.0f});
     std::vector<float3> tan2(vertexCount, float3{0.0f});
     for (size_t a = 0; a < triangleCount; ++a) {
         uint3 tri = triangles16 ? uint3(triangles16[a]) : triangles32[a];
-        assert_invariant(tri.x < vertexCount && tri.y < vertexCount && tri.z < vertexCount);
-        float3 const& v1 = *pointerAdd(positions, tri.x, positionStride);
-        float3 const& v2 = *pointerAdd(positions, tri.y, positionStride);
-        float3 const& v3 = *pointerAdd(positions, tri.z, positionStride);
-        float2 const& w1 = *pointerAdd(uvs, tri.x, uvStride);
-        float2 const& w2 = *pointerAdd(uvs, tri.y, uvStride);
-        float2 const& w3 = *pointerAdd(uvs, tri.z, uvStride);
-        float const x1 = v2.x - v1.x;
-        float const x2 = v3.x - v1.x;
-        float const y1 = v2.y - v1.y;
-        float const y2 = v3.y - v1.y;
-        float const z1 = v2.z - v1.z;
-        float const z2 = v3.z - v1.z;
-        float const s1 = w2.x - w1.x;
-        float const s2 = w3.x - w1.x;
-        float const t1 = w2.y - w1.y;
-        float const t2 = w3.y - w1.y;
-        float const d = s1 * t2 - s2 * t1;
-        float3 sdir, tdir;
-        // In general we can't guarantee smooth tangents when the UV's are non-smooth, but let's at
-        // least avoid divide-by-zero and fall back to normals-only method.
-        if (d == 0.0) {
-            float3 const& n1 = *pointerAdd(normals, tri.x, normalStride);
-            sdir = randomPerp(n1);
-            tdir = cross(n1, sdir);
-        } else {
-            sdir = {t2 * x1 - t1 * x2, t2 * y1 - t1 * y2, t2 * z1 - t1 * z2};
-            tdir = {s1 * x2 - s2 * x1, s1 * y2 - s2 * y1, s1 * z2 - s2 * z1};
-            float const r = 1.0f / d;
-            sdir *= r;
-            tdir *= r;
-        }
-        tan1[tri.x] += sdir;
-        tan1[tri.y] += sdir;
-        tan1[tri.z] += sdir;
-        tan2[tri.x] += tdir;
-        tan2[tri.y] += tdir;
-        tan2[tri.z] += tdir;
+        tan1[tri.x] += sdirs[a];
+        tan1[tri.y] += sdirs[a];
+        tan1[tri.z] += sdirs[a];
+        tan2[tri.x] += tdirs[a];
+        tan2[tri.y] += tdirs[a];
+        tan2[tri.z] += tdirs[a];
     }
 
     quatf* quats = output->tspace().allocate(vertexCount);
-    for (size_t a = 0; a < vertexCount; a++) {
-        float3 const& n = *pointerAdd(normals, a, normalStride);
-        float3 const& t1 = tan1[a];
-        float3 const& t2 = tan2[a];
+    parallelFor(input->jobSystem, vertexCount, [&](size_t start, size_t count) {
+        for (size_t a = start; a < start + count; a++) {
+            float3 const& n = *pointerAdd(normals, a, normalStride);
+            float3 const& t1 = tan1[a];
+            float3 const& t2 = tan2[a];
 
-        // Gram-Schmidt orthogonalize
-        float3 const t = normalize(t1 - n * dot(n, t1));
+            // Gram-Schmidt orthogonalize
+            float3 const t = normalize(t1 - n * dot(n, t1));
 
-        // Calculate handedness
-        float const w = (dot(cross(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
+            // Calculate handedness
+            float const w = (dot(cross(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
 
-        float3 b = w < 0 ? cross(t, n) : cross(n, t);
-        quats[a] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
-    }
+            float3 b = w < 0 ? cross(t, n) : cross(n, t);
+            quats[a] = mat3f::packTangentFrame({t, b, n}, sizeof(int32_t));
+        }
+    });
 
     output->vertexCount = vertexCount;
     output->triangleCount = triangleCount;
@@ -571,6 +654,11 @@ Builder& Builder::algorithm(Algorithm algo) noexcept {
     return *this;
 }
 
+Builder& Builder::jobSystem(utils::JobSystem* jobSystem) noexcept {
+    mMesh->mInput->jobSystem = jobSystem;
+    return *this;
+}
+
 TangentSpaceMesh* Builder::build() {
     ASSERT_PRECONDITION(!mMesh->mInput->triangles32 || !mMesh->mInput->triangles16,
             "Cannot provide both uint32 triangles and uint16 triangles");
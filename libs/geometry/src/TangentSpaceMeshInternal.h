@@ -327,6 +327,8 @@ struct TangentSpaceMeshInput {
     AttributeMap attributeData;
 
     Algorithm algorithm;
+
+    utils::JobSystem* jobSystem = nullptr;
 };
 
 struct TangentSpaceMeshOutput {
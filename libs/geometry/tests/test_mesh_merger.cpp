@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <geometry/MeshMerger.h>
+
+#include <math/mat4.h>
+#include <math/vec3.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+class MeshMergerTest : public testing::Test {};
+
+using namespace filament::geometry;
+using namespace filament::math;
+
+namespace {
+
+using Attribute = MeshMerger::Attribute;
+
+std::vector<float3> const QUAD_VERTS {
+        float3{0, 0, 0},
+        float3{1, 0, 0},
+        float3{1, 1, 0},
+        float3{0, 1, 0},
+};
+
+std::vector<float3> const QUAD_NORMALS {
+        float3{0, 0, 1},
+        float3{0, 0, 1},
+        float3{0, 0, 1},
+        float3{0, 0, 1},
+};
+
+std::vector<ushort3> const QUAD_TRIANGLES {
+        ushort3{0, 1, 2},
+        ushort3{0, 2, 3},
+};
+
+MeshMerger::Mesh quad(uint32_t material, mat4f const& transform) {
+    MeshMerger::Mesh mesh;
+    mesh.material = material;
+    mesh.transform = transform;
+    mesh.vertexCount = QUAD_VERTS.size();
+    mesh.positions = QUAD_VERTS.data();
+    mesh.normals = QUAD_NORMALS.data();
+    mesh.triangleCount = QUAD_TRIANGLES.size();
+    mesh.triangles16 = QUAD_TRIANGLES.data();
+    return mesh;
+}
+
+} // anonymous namespace
+
+TEST_F(MeshMergerTest, SameMaterial) {
+    MeshMerger* merger = MeshMerger::Builder()
+            .mesh(quad(0, mat4f::translation(float3{ 0, 0, 0 })))
+            .mesh(quad(0, mat4f::translation(float3{ 10, 0, 0 })))
+            .build();
+
+    ASSERT_EQ(merger->getClusterCount(), 1);
+    EXPECT_EQ(merger->getMaterial(0), 0);
+    EXPECT_EQ(merger->getVertexCount(0), 8);
+    EXPECT_EQ(merger->getTriangleCount(0), 4);
+
+    float3 min, max;
+    merger->getBoundingBox(0, &min, &max);
+    EXPECT_EQ(min, (float3{ 0, 0, 0 }));
+    EXPECT_EQ(max, (float3{ 11, 1, 0 }));
+
+    std::vector<float3> positions(merger->getVertexCount(0));
+    merger->getPositions(0, positions.data());
+    std::vector<uint3> triangles(merger->getTriangleCount(0));
+    merger->getTriangles(0, triangles.data());
+    EXPECT_EQ(positions[triangles[3].z], (float3{ 10, 1, 0 }));
+
+    MeshMerger::destroy(merger);
+}
+
+TEST_F(MeshMergerTest, DifferentMaterials) {
+    MeshMerger* merger = MeshMerger::Builder()
+            .mesh(quad(7, mat4f()))
+            .mesh(quad(3, mat4f()))
+            .mesh(quad(7, mat4f::translation(float3{ 0, 5, 0 })))
+            .build();
+
+    ASSERT_EQ(merger->getClusterCount(), 2);
+    EXPECT_EQ(merger->getMaterial(0), 3);
+    EXPECT_EQ(merger->getTriangleCount(0), 2);
+    EXPECT_EQ(merger->getMaterial(1), 7);
+    EXPECT_EQ(merger->getTriangleCount(1), 4);
+
+    MeshMerger::destroy(merger);
+}
+
+TEST_F(MeshMergerTest, SpatialSplit) {
+    MeshMerger::Builder builder;
+    for (int i = 0; i < 8; ++i) {
+        builder.mesh(quad(0, mat4f::translation(float3{ i * 10, 0, 0 })));
+    }
+    MeshMerger* merger = builder.maxClusterTriangles(4).build();
+
+    // Each cluster gets two neighboring quads, so that the bounding boxes do not overlap.
+    ASSERT_EQ(merger->getClusterCount(), 4);
+    for (size_t c = 0; c < merger->getClusterCount(); ++c) {
+        EXPECT_EQ(merger->getTriangleCount(c), 4);
+        EXPECT_EQ(merger->getVertexCount(c), 8);
+        float3 min, max;
+        merger->getBoundingBox(c, &min, &max);
+        EXPECT_FLOAT_EQ(max.x - min.x, 11.0f);
+    }
+
+    MeshMerger::destroy(merger);
+}
+
+TEST_F(MeshMergerTest, Attributes) {
+    MeshMerger::Mesh withColors = quad(0, mat4f::rotation(F_PI_2, float3{ 1, 0, 0 }));
+    std::vector<float4> colors(QUAD_VERTS.size(), float4{ 1, 0, 0, 1 });
+    withColors.colors = colors.data();
+
+    MeshMerger* merger = MeshMerger::Builder()
+            .mesh(withColors)
+            .mesh(quad(0, mat4f()))
+            .build();
+
+    ASSERT_EQ(merger->getClusterCount(), 1);
+    EXPECT_TRUE(merger->hasAttribute(0, Attribute::NORMALS));
+    EXPECT_TRUE(merger->hasAttribute(0, Attribute::COLORS));
+    EXPECT_FALSE(merger->hasAttribute(0, Attribute::TANGENTS));
+    EXPECT_FALSE(merger->hasAttribute(0, Attribute::UV0));
+
+    std::vector<float3> normals(merger->getVertexCount(0));
+    merger->getAttribute(0, Attribute::NORMALS, normals.data());
+    EXPECT_NEAR(normals[0].y, -1.0f, 1e-6f);
+    EXPECT_NEAR(normals[4].z, 1.0f, 1e-6f);
+
+    // The quad without colors gets the default color.
+    std::vector<float4> outColors(merger->getVertexCount(0));
+    merger->getAttribute(0, Attribute::COLORS, outColors.data());
+    EXPECT_EQ(outColors[0], (float4{ 1, 0, 0, 1 }));
+    EXPECT_EQ(outColors[4], (float4{ 1, 1, 1, 1 }));
+
+    MeshMerger::destroy(merger);
+}
+
+TEST_F(MeshMergerTest, MirroredWinding) {
+    MeshMerger* merger = MeshMerger::Builder()
+            .mesh(quad(0, mat4f::scaling(float3{ -1, 1, 1 })))
+            .build();
+
+    ASSERT_EQ(merger->getClusterCount(), 1);
+    std::vector<float3> positions(merger->getVertexCount(0));
+    merger->getPositions(0, positions.data());
+    std::vector<ushort3> triangles(merger->getTriangleCount(0));
+    merger->getTriangles(0, triangles.data());
+
+    // The triangles still face +Z, and so do the normals.
+    for (ushort3 const& tri : triangles) {
+        float3 const n = cross(positions[tri.y] - positions[tri.x],
+                positions[tri.z] - positions[tri.x]);
+        EXPECT_GT(n.z, 0.0f);
+    }
+    std::vector<float3> normals(merger->getVertexCount(0));
+    merger->getAttribute(0, Attribute::NORMALS, normals.data());
+    EXPECT_NEAR(normals[0].z, 1.0f, 1e-6f);
+
+    MeshMerger::destroy(merger);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -21,10 +21,13 @@
 
 #include <gtest/gtest.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 
 #include <vector>
 
+#include <string.h>
+
 class TangentSpaceMeshTest : public testing::Test {};
 
 using namespace filament::geometry;
@@ -427,6 +430,117 @@ TEST_F(TangentSpaceMeshTest, Lengyel) {
     TangentSpaceMesh::destroy(mesh);
 }
 
+namespace {
+
+// A UV sphere with enough vertices and triangles to be split into several jobs.
+struct Sphere {
+    std::vector<float3> positions;
+    std::vector<float3> normals;
+    std::vector<float4> tangents;
+    std::vector<float2> uvs;
+    std::vector<uint3> triangles;
+};
+
+Sphere makeSphere(uint32_t segments) {
+    Sphere sphere;
+    for (uint32_t j = 0; j <= segments; ++j) {
+        for (uint32_t i = 0; i <= segments; ++i) {
+            float2 const uv{ float(i) / float(segments), float(j) / float(segments) };
+            float const theta = uv.y * F_PI;
+            float const phi = uv.x * 2.0f * F_PI;
+            float3 const n{ std::sin(theta) * std::cos(phi), std::cos(theta),
+                    std::sin(theta) * std::sin(phi) };
+            sphere.positions.push_back(n);
+            sphere.normals.push_back(n);
+            sphere.tangents.push_back({ -std::sin(phi), 0.0f, std::cos(phi), 1.0f });
+            sphere.uvs.push_back(uv);
+        }
+    }
+    for (uint32_t j = 0; j < segments; ++j) {
+        for (uint32_t i = 0; i < segments; ++i) {
+            uint32_t const a = j * (segments + 1) + i;
+            uint32_t const b = a + segments + 1;
+            sphere.triangles.push_back({ a, b, a + 1 });
+            sphere.triangles.push_back({ a + 1, b, b + 1 });
+        }
+    }
+    return sphere;
+}
+
+std::vector<quatf> computeQuats(Sphere const& sphere, TangentSpaceMesh::Algorithm algorithm,
+        bool withNormals, bool withTangents, utils::JobSystem* js) {
+    TangentSpaceMesh::Builder builder;
+    builder.vertexCount(sphere.positions.size())
+            .positions(sphere.positions.data())
+            .triangleCount(sphere.triangles.size())
+            .triangles(sphere.triangles.data())
+            .algorithm(algorithm)
+            .jobSystem(js);
+    if (withNormals) {
+        builder.normals(sphere.normals.data());
+    }
+    // Tangents are only used when mikktspace cannot be, i.e. without UVs.
+    if (withTangents) {
+        builder.tangents(sphere.tangents.data());
+    } else {
+        builder.uvs(sphere.uvs.data());
+    }
+    TangentSpaceMesh* mesh = builder.build();
+    std::vector<quatf> quats(mesh->getVertexCount());
+    mesh->getQuats(quats.data());
+    TangentSpaceMesh::destroy(mesh);
+    return quats;
+}
+
+} // anonymous namespace
+
+TEST_F(TangentSpaceMeshTest, JobSystemMatchesSerial) {
+    utils::JobSystem js;
+    js.adopt();
+
+    Sphere const sphere = makeSphere(128);
+    struct {
+        TangentSpaceMesh::Algorithm algorithm;
+        bool withNormals;
+        bool withTangents;
+    } const cases[] = {
+            { TangentSpaceMesh::Algorithm::FRISVAD, true, false },
+            { TangentSpaceMesh::Algorithm::HUGHES_MOLLER, true, false },
+            { TangentSpaceMesh::Algorithm::LENGYEL, true, false },
+            { TangentSpaceMesh::Algorithm::DEFAULT, false, false },    // flat shading
+            { TangentSpaceMesh::Algorithm::DEFAULT, true, true },      // tangents provided
+    };
+    for (auto const& c : cases) {
+        std::vector<quatf> const serial =
+                computeQuats(sphere, c.algorithm, c.withNormals, c.withTangents, nullptr);
+        std::vector<quatf> const parallel =
+                computeQuats(sphere, c.algorithm, c.withNormals, c.withTangents, &js);
+        ASSERT_EQ(serial.size(), parallel.size());
+        EXPECT_EQ(memcmp(serial.data(), parallel.data(), serial.size() * sizeof(quatf)), 0);
+    }
+
+    js.emancipate();
+}
+
+TEST_F(TangentSpaceMeshTest, FrisvadSingularity) {
+    // Normals pointing down are handled separately by Frisvad's method. This also covers the
+    // batches that are only partially filled.
+    std::vector<float3> const normals(19, float3{ 0, -1, 0 });
+    TangentSpaceMesh* mesh = TangentSpaceMesh::Builder()
+            .vertexCount(normals.size())
+            .normals(normals.data())
+            .algorithm(TangentSpaceMesh::Algorithm::FRISVAD)
+            .build();
+
+    std::vector<quatf> quats(mesh->getVertexCount());
+    mesh->getQuats(quats.data());
+    for (quatf const& q : quats) {
+        EXPECT_PRED2(isAlmostEqual3, q * NORMAL_AXIS, (float3{ 0, -1, 0 }));
+        EXPECT_PRED2(isAlmostEqual3, q * TANGENT_AXIS, (float3{ -1, 0, 0 }));
+    }
+    TangentSpaceMesh::destroy(mesh);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filament/Engine.h>
+
+#include <gltfio/Animator.h>
+#include <gltfio/AssetLoader.h>
+#include <gltfio/FilamentAsset.h>
+#include <gltfio/FilamentInstance.h>
+#include <gltfio/MaterialProvider.h>
+#include <gltfio/ResourceLoader.h>
+
+#include <utils/EntityManager.h>
+#include <utils/NameComponentManager.h>
+#include <utils/Path.h>
+
+#include "materials/uberarchive.h"
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <stdint.h>
+#include <string.h>
+
+using namespace filament;
+using namespace filament::gltfio;
+using namespace utils;
+
+static constexpr const char* ANIMATED_MORPH_CUBE_GLB = "AnimatedMorphCube.glb";
+static constexpr const char* BUSTER_DRONE_GLTF = "BusterDrone/scene.gltf";
+
+// Compares the time it takes to load an asset from glTF with the time it takes to load it from
+// a baked cache recorded by a previous load.
+class GltfLoadFixture : public benchmark::Fixture {
+protected:
+    Engine* engine = nullptr;
+    MaterialProvider* materials = nullptr;
+    NameComponentManager* names = nullptr;
+    AssetLoader* assetLoader = nullptr;
+    ResourceLoader* resourceLoader = nullptr;
+    std::vector<uint8_t> content;
+    std::vector<uint64_t> bakedCache;
+    size_t bakedCacheSize = 0;
+
+public:
+    void SetUp(const benchmark::State&) override {
+        engine = Engine::Builder().backend(Engine::Backend::NOOP).build();
+        materials = createUbershaderProvider(engine,
+                UBERARCHIVE_DEFAULT_DATA, UBERARCHIVE_DEFAULT_SIZE);
+        names = new NameComponentManager(EntityManager::get());
+        assetLoader = AssetLoader::create({ engine, materials, names });
+
+        Path const path = Path::getCurrentExecutable().getParent() + ANIMATED_MORPH_CUBE_GLB;
+        resourceLoader = new ResourceLoader({ engine, path.c_str(), false });
+        std::ifstream in(path.c_str(), std::ifstream::binary);
+        content.assign(std::istreambuf_iterator<char>(in), {});
+
+        // Record the baked cache once. It is copied into 8-byte aligned storage, as if it was
+        // memory-mapped from a file.
+        resourceLoader->enableBakedCacheRecording(true);
+        load();
+        resourceLoader->enableBakedCacheRecording(false);
+        const uint8_t* data = resourceLoader->getBakedCache(&bakedCacheSize);
+        bakedCache.resize((bakedCacheSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        memcpy(bakedCache.data(), data, bakedCacheSize);
+    }
+
+    void TearDown(const benchmark::State&) override {
+        delete resourceLoader;
+        AssetLoader::destroy(&assetLoader);
+        materials->destroyMaterials();
+        delete materials;
+        delete names;
+        Engine::destroy(&engine);
+    }
+
+    bool load() {
+        FilamentAsset* asset = assetLoader->createAsset(content.data(), content.size());
+        const bool success = asset && resourceLoader->loadResources(asset);
+        if (asset) {
+            assetLoader->destroyAsset(asset);
+        }
+        // Let the backend consume the uploads, so that they are accounted for in each iteration.
+        engine->flushAndWait();
+        return success;
+    }
+};
+
+BENCHMARK_DEFINE_F(GltfLoadFixture, coldLoad)(benchmark::State& state) {
+    for (auto _ : state) {
+        if (!load()) {
+            state.SkipWithError("unable to load the asset");
+            break;
+        }
+    }
+}
+
+BENCHMARK_DEFINE_F(GltfLoadFixture, bakedLoad)(benchmark::State& state) {
+    for (auto _ : state) {
+        resourceLoader->setBakedCache({ bakedCache.data(), bakedCacheSize });
+        if (!load() || !resourceLoader->isBakedCacheUsed()) {
+            state.SkipWithError("unable to load the asset from the baked cache");
+            break;
+        }
+    }
+    state.counters["cacheBytes"] = double(bakedCacheSize);
+}
+
+BENCHMARK_REGISTER_F(GltfLoadFixture, coldLoad)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(GltfLoadFixture, bakedLoad)->Unit(benchmark::kMicrosecond);
+
+// Animates N instances of an asset that has a hundred animated nodes, either one animator at a time
+// or all of them at once on the JobSystem.
+class AnimatorFixture : public benchmark::Fixture {
+protected:
+    Engine* engine = nullptr;
+    MaterialProvider* materials = nullptr;
+    NameComponentManager* names = nullptr;
+    AssetLoader* assetLoader = nullptr;
+    ResourceLoader* resourceLoader = nullptr;
+    FilamentAsset* asset = nullptr;
+    std::vector<Animator*> animators;
+    std::vector<size_t> animationIndices;
+    std::vector<float> times;
+
+public:
+    void SetUp(const benchmark::State& state) override {
+        engine = Engine::Builder().backend(Engine::Backend::NOOP).build();
+        materials = createUbershaderProvider(engine,
+                UBERARCHIVE_DEFAULT_DATA, UBERARCHIVE_DEFAULT_SIZE);
+        names = new NameComponentManager(EntityManager::get());
+        assetLoader = AssetLoader::create({ engine, materials, names });
+
+        Path const path = Path::getCurrentExecutable().getParent() + BUSTER_DRONE_GLTF;
+        std::ifstream in(path.c_str(), std::ifstream::binary);
+        std::vector<uint8_t> content{ std::istreambuf_iterator<char>(in), {} };
+
+        const size_t count = size_t(state.range(0));
+        std::vector<FilamentInstance*> instances(count);
+        asset = assetLoader->createInstancedAsset(content.data(), content.size(),
+                instances.data(), count);
+        resourceLoader = new ResourceLoader({ engine, path.c_str(), false });
+        if (!asset || !resourceLoader->loadResources(asset)) {
+            return;
+        }
+
+        // Each instance plays the animation with its own phase, as in a crowd.
+        for (size_t i = 0; i < count; i++) {
+            animators.push_back(instances[i]->getAnimator());
+            animationIndices.push_back(0);
+            times.push_back(float(i) * 0.1f);
+        }
+    }
+
+    void TearDown(const benchmark::State&) override {
+        animators.clear();
+        animationIndices.clear();
+        times.clear();
+        if (asset) {
+            assetLoader->destroyAsset(asset);
+        }
+        delete resourceLoader;
+        AssetLoader::destroy(&assetLoader);
+        materials->destroyMaterials();
+        delete materials;
+        delete names;
+        Engine::destroy(&engine);
+    }
+
+    void advance() {
+        for (float& time : times) {
+            time += 1.0f / 60.0f;
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(AnimatorFixture, applyAnimation)(benchmark::State& state) {
+    if (animators.empty()) {
+        state.SkipWithError("unable to load the asset");
+        return;
+    }
+    for (auto _ : state) {
+        for (size_t i = 0, n = animators.size(); i < n; i++) {
+            animators[i]->applyAnimation(animationIndices[i], times[i]);
+        }
+        advance();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(animators.size()));
+}
+
+BENCHMARK_DEFINE_F(AnimatorFixture, applyAnimations)(benchmark::State& state) {
+    if (animators.empty()) {
+        state.SkipWithError("unable to load the asset");
+        return;
+    }
+    for (auto _ : state) {
+        Animator::applyAnimations(animators.data(), animationIndices.data(), times.data(),
+                animators.size());
+        advance();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(animators.size()));
+}
+
+BENCHMARK_REGISTER_F(AnimatorFixture, applyAnimation)
+        ->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(AnimatorFixture, applyAnimations)
+        ->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond);
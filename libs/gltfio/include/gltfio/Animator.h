@@ -47,15 +47,44 @@ public:
      */
     void applyAnimation(size_t animationIndex, float time) const;
 
+    /**
+     * Applies an animation to each of the given animators, as if applyAnimation() was called on
+     * each of them, but evaluates the animators concurrently on the JobSystem of their engine.
+     *
+     * This is intended for many instances of the same asset, e.g. a crowd of characters that each
+     * have their own FilamentInstance. All animators must belong to the same engine, and must not
+     * animate the same entities.
+     *
+     * @param animators Array of animators, e.g. from FilamentInstance::getAnimator().
+     * @param animationIndices Zero-based index for the \c animation of interest, for each animator.
+     * @param times Elapsed time of interest in seconds, for each animator.
+     * @param count Number of animators.
+     */
+    static void applyAnimations(Animator* const* animators, size_t const* animationIndices,
+            float const* times, size_t count);
+
     /**
      * Computes root-to-node transforms for all bone nodes, then passes
      * the results into filament::RenderableManager::setBones.
      * Uses filament::TransformManager and filament::RenderableManager.
      *
+     * Only the bones whose joint or target has moved since the previous update are recomputed and
+     * uploaded. Skins are processed concurrently on the JobSystem when there are several of them.
+     *
      * NOTE: this operation is independent of \c animation.
      */
     void updateBoneMatrices();
 
+    /**
+     * Updates the bone matrices of several animators at once, as if updateBoneMatrices() was called
+     * on each of them, but with the skins of all animators processed concurrently. All animators
+     * must belong to the same engine.
+     *
+     * @param animators Array of animators, e.g. from FilamentInstance::getAnimator().
+     * @param count Number of animators.
+     */
+    static void updateBoneMatrices(Animator* const* animators, size_t count);
+
     /**
      * Applies a blended transform to the union of nodes affected by two animations.
      * Used for cross-fading from a previous skinning-based animation or rigid body animation.
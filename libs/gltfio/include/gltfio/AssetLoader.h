@@ -62,6 +62,20 @@ struct AssetConfiguration {
 
     //! Optional default node name for anonymous nodes
     char* defaultNodeName = nullptr;
+
+    //! Draws the nodes of an instance that share a mesh with a single renderable that has one GPU
+    //! instance per node, instead of a renderable per node. The nodes keep their transform
+    //! components, and the renderables that draw them are listed with the other entities of the
+    //! instance. Nodes that are skinned or have morph targets are not affected.
+    //!
+    //! A renderable draws at most Engine::getMaxAutomaticInstances() nodes, larger groups are
+    //! split across several renderables, each with its own InstanceBuffer.
+    //!
+    //! \warning The GPU instances don't follow their nodes by themselves. Animator updates them,
+    //! but after moving any of these nodes (or their ancestors) with the TransformManager, the
+    //! application must call FilamentInstance::updateInstancedMeshes(), otherwise the nodes are
+    //! drawn, and culled, at their previous position.
+    bool automaticInstancing = false;
 };
 
 /**
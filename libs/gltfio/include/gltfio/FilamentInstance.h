@@ -151,6 +151,16 @@ public:
      */
     Aabb getBoundingBox() const noexcept;
 
+    /**
+     * Pushes the world transforms of the nodes that are drawn as GPU instances into their
+     * InstanceBuffer, and updates the bounding box of the renderable that draws them.
+     *
+     * This must be called after moving such nodes, or their ancestors, by other means than
+     * Animator, which does this automatically. Only the nodes that moved since the previous call
+     * are recomputed. See AssetConfiguration::automaticInstancing.
+     */
+    void updateInstancedMeshes();
+
     /** Gets all material instances. These are already bound to renderables. */
     const MaterialInstance* const* getMaterialInstances() const noexcept;
 
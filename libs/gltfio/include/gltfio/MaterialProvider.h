@@ -201,6 +201,10 @@ MaterialProvider* createJitShaderProvider(Engine* engine, bool optimizeShaders =
 /**
  * Creates a material provider that loads a small set of pre-built materials.
  *
+ * The archive is typically compressed and decompressed into a private buffer. Archives created with
+ * \c uberz \c --uncompressed are used in place instead (if they are 8-byte aligned), in which case
+ * the archive must outlive the provider.
+ *
  * @return New material provider that can quickly load a material from a cache.
  *
  * @see createJitShaderProvider
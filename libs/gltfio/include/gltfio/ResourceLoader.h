@@ -22,6 +22,7 @@
 #include <filament/VertexBuffer.h>
 
 #include <utils/compiler.h>
+#include <utils/Entity.h>
 
 namespace filament {
     class Engine;
@@ -154,6 +155,68 @@ public:
      */
     void asyncCancelLoad();
 
+    /**
+     * Limits the amount of texture data that asynchronous loads decode simultaneously.
+     *
+     * By default (0) every texture is submitted to its TextureProvider as soon as the load
+     * begins. With a budget, textures are submitted in priority order (see
+     * #asyncSetScreenCoverage) and only while the estimated size of the textures being decoded
+     * stays within the budget, which bounds peak memory usage and lets the most visible
+     * renderables appear first. At least one texture is always decoded, regardless of its size.
+     *
+     * Textures that have not been submitted yet are simply dropped by #asyncCancelLoad, or when
+     * the asset is destroyed during the load.
+     */
+    void setDecodeMemoryBudget(size_t bytes);
+
+    /**
+     * Supplies the fraction of the screen covered by the given renderable, typically computed by
+     * the application from the renderable's bounding box.
+     *
+     * When a decode budget is set, the textures used by the renderables with the largest coverage
+     * are decoded first. This can be called at any time during an asynchronous load, the new
+     * priorities are taken into account on the next call to #asyncUpdateLoad.
+     */
+    void asyncSetScreenCoverage(utils::Entity renderable, float coverage);
+
+    /**
+     * Enables or disables the recording of a baked cache during subsequent loads.
+     *
+     * A baked cache holds the processed vertex, index, morph target, tangent and skin data of an
+     * asset, i.e. after Draco and meshopt decoding, type conversions and tangent generation.
+     * Supplying it to a later load of the same asset with #setBakedCache skips all of that work.
+     *
+     * Recording copies every upload, so it should only be enabled when the cache is needed.
+     */
+    void enableBakedCacheRecording(bool enabled);
+
+    /**
+     * Returns the baked cache recorded by the most recent call to #loadResources or
+     * #asyncBeginLoad, or null if recording was not enabled.
+     *
+     * The returned blob is owned by the loader and stays valid until the next load or until the
+     * loader is destroyed. Clients typically write it to storage.
+     */
+    const uint8_t* getBakedCache(size_t* size) const;
+
+    /**
+     * Supplies a baked cache for the next call to #loadResources or #asyncBeginLoad.
+     *
+     * The cache is used in place: its content is uploaded to the GPU without copies, so it is
+     * well suited to memory-mapped files. The buffer must be aligned to 8 bytes, its callback is
+     * invoked once the Engine no longer references it.
+     *
+     * The cache is ignored if it was baked for a different asset or with a different
+     * MaterialProvider, in which case the asset is processed normally. Clients are responsible
+     * for discarding the cache when the binary resources of the asset change.
+     */
+    void setBakedCache(BufferDescriptor&& cache);
+
+    /**
+     * Returns true if the most recent load used the cache supplied with #setBakedCache.
+     */
+    bool isBakedCacheUsed() const;
+
 private:
     bool loadResources(FFilamentAsset* asset, bool async);
     void normalizeSkinningWeights(FFilamentAsset* asset) const;
@@ -26,6 +26,7 @@
 #include <filament/RenderableManager.h>
 #include <filament/TransformManager.h>
 
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 
 #include <math/mat4.h>
@@ -34,6 +35,7 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -45,14 +47,26 @@ using namespace utils;
 
 namespace filament::gltfio {
 
-using TimeValues = map<float, size_t>;
+using TimeValues = vector<float>;
 using SourceValues = vector<float>;
 using BoneVector = vector<mat4f>;
 
 struct Sampler {
-    TimeValues times;
+    TimeValues times;           // sorted and unique
+    vector<size_t> keyframes;   // index of the source values for each time
     SourceValues values;
     enum { LINEAR, STEP, CUBIC } interpolation;
+    enum { SCALAR, VEC3, VEC4 } type = SCALAR;
+
+    // Result of the last evaluation. The cursor is the position of the first keyframe at or after
+    // the last evaluated time, which is where the next search starts from.
+    size_t cursor = 0;
+    size_t prevIndex = 0;
+    size_t nextIndex = 0;
+    float t = 0.0f;
+    float3 value;               // translation or scale
+    quatf rotation;
+    vector<float> weights;
 };
 
 struct Channel {
@@ -76,19 +90,25 @@ struct AnimatorImpl {
     RenderableManager* renderableManager;
     TransformManager* transformManager;
     TrsTransformManager* trsTransformManager;
-    vector<float> weights;
     FixedCapacityVector<mat4f> crossFade;
+    vector<uint32_t> lerpSamplers;
+    vector<float> lerpFrom;
+    vector<float> lerpTo;
+    vector<float> lerpWeights;
     void addChannels(const FixedCapacityVector<Entity>& nodeMap, const cgltf_animation& srcAnim,
             Animation& dst);
-    void applyAnimation(const Channel& channel, float t, size_t prevIndex, size_t nextIndex);
+    void evaluateSamplers(Animation& anim, float time);
+    void applyTransforms(size_t animationIndex, float time);
+    void applyMorphWeights(size_t animationIndex);
     void stashCrossFade();
     void applyCrossFade(float alpha);
+    void updateInstancedMeshes();
     void resetBoneMatrices(FFilamentInstance* instance);
-    void updateBoneMatrices(FFilamentInstance* instance);
+    void updateBoneMatrices(FFilamentInstance* const* instances, size_t count);
 };
 
 static void createSampler(const cgltf_animation_sampler& src, Sampler& dst) {
-    // Copy the time values into a red-black tree.
+    // Sort the time values through a red-black tree, then flatten it for fast searches.
     const cgltf_accessor* timelineAccessor = src.input;
     const uint8_t* timelineBlob = nullptr;
     const float* timelineFloats = nullptr;
@@ -100,22 +120,32 @@ static void createSampler(const cgltf_animation_sampler& src, Sampler& dst) {
         timelineFloats = (const float*) (timelineBlob + timelineAccessor->offset +
                 timelineAccessor->buffer_view->offset);
     }
+    map<float, size_t> times;
     for (size_t i = 0, len = timelineAccessor->count; i < len; ++i) {
-        dst.times[timelineFloats[i]] = i;
+        times[timelineFloats[i]] = i;
+    }
+    dst.times.reserve(times.size());
+    dst.keyframes.reserve(times.size());
+    for (const auto& [time, index] : times) {
+        dst.times.push_back(time);
+        dst.keyframes.push_back(index);
     }
 
     // Convert source data to float.
     const cgltf_accessor* valuesAccessor = src.output;
     switch (valuesAccessor->type) {
         case cgltf_type_scalar:
+            dst.type = Sampler::SCALAR;
             dst.values.resize(valuesAccessor->count);
             cgltf_accessor_unpack_floats(src.output, &dst.values[0], valuesAccessor->count);
             break;
         case cgltf_type_vec3:
+            dst.type = Sampler::VEC3;
             dst.values.resize(valuesAccessor->count * 3);
             cgltf_accessor_unpack_floats(src.output, &dst.values[0], valuesAccessor->count * 3);
             break;
         case cgltf_type_vec4:
+            dst.type = Sampler::VEC4;
             dst.values.resize(valuesAccessor->count * 4);
             cgltf_accessor_unpack_floats(src.output, &dst.values[0], valuesAccessor->count * 4);
             break;
@@ -160,6 +190,19 @@ static void setTransformType(const cgltf_animation_channel& src, Channel& dst) {
     }
 }
 
+static bool isSamplerCompatible(const Channel& channel) {
+    switch (channel.transformType) {
+        case Channel::TRANSLATION:
+        case Channel::SCALE:
+            return channel.sourceData->type == Sampler::VEC3;
+        case Channel::ROTATION:
+            return channel.sourceData->type == Sampler::VEC4;
+        case Channel::WEIGHTS:
+            return channel.sourceData->type == Sampler::SCALAR;
+    }
+    return false;
+}
+
 static bool validateAnimation(const cgltf_animation& anim) {
     for (cgltf_size j = 0; j < anim.channels_count; ++j) {
         const cgltf_animation_channel& channel = anim.channels[j];
@@ -222,7 +265,7 @@ Animator::Animator(FFilamentAsset const* asset, FFilamentInstance* instance) {
             Sampler& dstSampler = dstAnim.samplers[j];
             createSampler(srcSampler, dstSampler);
             if (dstSampler.times.size() > 1) {
-                float maxtime = (--dstSampler.times.end())->first;
+                float maxtime = dstSampler.times.back();
                 dstAnim.duration = std::max(dstAnim.duration, maxtime);
             }
         }
@@ -242,6 +285,7 @@ void Animator::applyCrossFade(size_t previousAnimIndex, float previousAnimTime,
     mImpl->stashCrossFade();
     applyAnimation(previousAnimIndex, previousAnimTime);
     mImpl->applyCrossFade(alpha);
+    mImpl->updateInstancedMeshes();
 }
 
 void Animator::addInstance(FFilamentInstance* instance) {
@@ -263,51 +307,42 @@ size_t Animator::getAnimationCount() const {
 }
 
 void Animator::applyAnimation(size_t animationIndex, float time) const {
-    const Animation& anim = mImpl->animations[animationIndex];
-    time = fmod(time, anim.duration);
     TransformManager& transformManager = *mImpl->transformManager;
     transformManager.openLocalTransformTransaction();
-    for (const auto& channel : anim.channels) {
-        const Sampler* sampler = channel.sourceData;
-        if (sampler->times.size() < 2) {
-            continue;
-        }
-
-        const TimeValues& times = sampler->times;
-
-        // Find the first keyframe after the given time, or the keyframe that matches it exactly.
-        TimeValues::const_iterator iter = times.lower_bound(time);
+    mImpl->applyTransforms(animationIndex, time);
+    mImpl->applyMorphWeights(animationIndex);
+    transformManager.commitLocalTransformTransaction();
+    mImpl->updateInstancedMeshes();
+}
 
-        // Compute the interpolant (between 0 and 1) and determine the keyframe pair.
-        float t = 0.0f;
-        size_t nextIndex;
-        size_t prevIndex;
-        if (iter == times.end()) {
-            nextIndex = times.size() - 1;
-            prevIndex = nextIndex;
-        } else if (iter == times.begin()) {
-            nextIndex = 0;
-            prevIndex = 0;
-        } else {
-            TimeValues::const_iterator prev = iter; --prev;
-            nextIndex = iter->second;
-            prevIndex = prev->second;
-            const float nextTime = iter->first;
-            const float prevTime = prev->first;
-            float deltaTime = nextTime - prevTime;
-            assert(deltaTime >= 0);
-            if (deltaTime > 0) {
-                t = (time - prevTime) / deltaTime;
-            }
-        }
+void Animator::applyAnimations(Animator* const* animators, size_t const* animationIndices,
+        float const* times, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    const AnimatorImpl* first = animators[0]->mImpl;
+    TransformManager& transformManager = *first->transformManager;
+    JobSystem& js = first->asset->mEngine->getJobSystem();
 
-        if (sampler->interpolation == Sampler::STEP) {
-            t = 0.0f;
+    // Local transforms are independent from each other while the transaction is open, so the
+    // animators can write them concurrently. Morph weights go through the driver and are applied
+    // afterwards on this thread.
+    transformManager.openLocalTransformTransaction();
+    auto work = [animators, animationIndices, times](uint32_t start, uint32_t count) {
+        for (uint32_t i = start; i < start + count; i++) {
+            animators[i]->mImpl->applyTransforms(animationIndices[i], times[i]);
         }
-
-        mImpl->applyAnimation(channel, t, prevIndex, nextIndex);
+    };
+    auto* job = jobs::parallel_for(js, nullptr, 0, uint32_t(count),
+            std::cref(work), jobs::CountSplitter<4>());
+    js.runAndWait(job);
+    for (size_t i = 0; i < count; i++) {
+        animators[i]->mImpl->applyMorphWeights(animationIndices[i]);
     }
     transformManager.commitLocalTransformTransaction();
+    for (size_t i = 0; i < count; i++) {
+        animators[i]->mImpl->updateInstancedMeshes();
+    }
 }
 
 void Animator::resetBoneMatrices() {
@@ -326,14 +361,30 @@ void Animator::resetBoneMatrices() {
 void Animator::updateBoneMatrices() {
     // If this is a single-instance animator, then update only this instance.
     if (mImpl->instance) {
-        mImpl->updateBoneMatrices(mImpl->instance);
+        mImpl->updateBoneMatrices(&mImpl->instance, 1);
         return;
     }
 
     // If this is a broadcast animator, then update all instances.
-    for (FFilamentInstance* instance : mImpl->asset->mInstances) {
-        mImpl->updateBoneMatrices(instance);
+    const auto& instances = mImpl->asset->mInstances;
+    mImpl->updateBoneMatrices(instances.data(), instances.size());
+}
+
+void Animator::updateBoneMatrices(Animator* const* animators, size_t count) {
+    if (count == 0) {
+        return;
     }
+    vector<FFilamentInstance*> instances;
+    for (size_t i = 0; i < count; i++) {
+        const AnimatorImpl* impl = animators[i]->mImpl;
+        if (impl->instance) {
+            instances.push_back(impl->instance);
+        } else {
+            instances.insert(instances.end(),
+                    impl->asset->mInstances.begin(), impl->asset->mInstances.end());
+        }
+    }
+    animators[0]->mImpl->updateBoneMatrices(instances.data(), instances.size());
 }
 
 float Animator::getAnimationDuration(size_t animationIndex) const {
@@ -424,73 +475,108 @@ void AnimatorImpl::addChannels(const FixedCapacityVector<Entity>& nodeMap,
         dstChannel.sourceData = samplers + (srcChannel.sampler - srcSamplers);
         dstChannel.targetEntity = targetEntity;
         setTransformType(srcChannel, dstChannel);
+        if (UTILS_UNLIKELY(!isSamplerCompatible(dstChannel))) {
+            GLTFIO_WARN("Sampler type does not match the channel path.");
+            continue;
+        }
         dst.channels.push_back(dstChannel);
     }
-}
 
-void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIndex,
-        size_t nextIndex) {
-    const Sampler* sampler = channel.sourceData;
-    const TimeValues& times = sampler->times;
-    TrsTransformManager::Instance trsNode = trsTransformManager->getInstance(channel.targetEntity);
-    TransformManager::Instance node = transformManager->getInstance(channel.targetEntity);
+    // Keep the channels that target the same node next to each other, see applyTransforms().
+    std::stable_sort(dst.channels.begin(), dst.channels.end(),
+            [](const Channel& lhs, const Channel& rhs) {
+                return lhs.targetEntity.getId() < rhs.targetEntity.getId();
+            });
+}
 
-    switch (channel.transformType) {
+// Finds the pair of keyframes that surrounds the given time, and the interpolant between them.
+static void locateKeyframes(Sampler& sampler, float time) {
+    const float* const times = sampler.times.data();
+    const size_t count = sampler.times.size();
 
-        case Channel::SCALE: {
-            float3 scale;
-            const float3* srcVec3 = (const float3*) sampler->values.data();
-            if (sampler->interpolation == Sampler::CUBIC) {
-                float3 vert0 = srcVec3[prevIndex * 3 + 1];
-                float3 tang0 = srcVec3[prevIndex * 3 + 2];
-                float3 tang1 = srcVec3[nextIndex * 3];
-                float3 vert1 = srcVec3[nextIndex * 3 + 1];
-                scale = cubicSpline(vert0, tang0, vert1, tang1, t);
-            } else {
-                scale = ((1 - t) * srcVec3[prevIndex]) + (t * srcVec3[nextIndex]);
-            }
-            trsTransformManager->setScale(trsNode, scale);
-            break;
+    // Find the first keyframe after the given time, or the keyframe that matches it exactly.
+    // Playback is usually monotonic, so this starts from the keyframe found by the previous
+    // evaluation, and only falls back to a binary search when seeking or looping.
+    auto isLowerBound = [times, count, time](size_t i) {
+        return (i == count || time <= times[i]) && (i == 0 || times[i - 1] < time);
+    };
+    size_t cursor = sampler.cursor;
+    if (!isLowerBound(cursor)) {
+        if (cursor < count && isLowerBound(cursor + 1)) {
+            cursor++;
+        } else {
+            cursor = std::lower_bound(times, times + count, time) - times;
+        }
+    }
+    sampler.cursor = cursor;
+
+    // Compute the interpolant (between 0 and 1) and determine the keyframe pair.
+    float t = 0.0f;
+    if (cursor == count) {
+        sampler.nextIndex = count - 1;
+        sampler.prevIndex = sampler.nextIndex;
+    } else if (cursor == 0) {
+        sampler.nextIndex = 0;
+        sampler.prevIndex = 0;
+    } else {
+        sampler.nextIndex = sampler.keyframes[cursor];
+        sampler.prevIndex = sampler.keyframes[cursor - 1];
+        const float nextTime = times[cursor];
+        const float prevTime = times[cursor - 1];
+        float deltaTime = nextTime - prevTime;
+        assert(deltaTime >= 0);
+        if (deltaTime > 0) {
+            t = (time - prevTime) / deltaTime;
         }
+    }
 
-        case Channel::TRANSLATION: {
-            float3 translation;
-            const float3* srcVec3 = (const float3*) sampler->values.data();
-            if (sampler->interpolation == Sampler::CUBIC) {
-                float3 vert0 = srcVec3[prevIndex * 3 + 1];
-                float3 tang0 = srcVec3[prevIndex * 3 + 2];
-                float3 tang1 = srcVec3[nextIndex * 3];
-                float3 vert1 = srcVec3[nextIndex * 3 + 1];
-                translation = cubicSpline(vert0, tang0, vert1, tang1, t);
-            } else {
-                translation = ((1 - t) * srcVec3[prevIndex]) + (t * srcVec3[nextIndex]);
-            }
-            trsTransformManager->setTranslation(trsNode, translation);
+    if (sampler.interpolation == Sampler::STEP) {
+        t = 0.0f;
+    }
+    sampler.t = t;
+}
+
+// Evaluates a sampler that is not part of the linear batch, i.e. cubic splines, rotations and
+// morph weights.
+static void evaluateSampler(Sampler& sampler) {
+    const size_t prevIndex = sampler.prevIndex;
+    const size_t nextIndex = sampler.nextIndex;
+    const float t = sampler.t;
+
+    switch (sampler.type) {
+
+        case Sampler::VEC3: {
+            const float3* srcVec3 = (const float3*) sampler.values.data();
+            assert(sampler.interpolation == Sampler::CUBIC);
+            float3 vert0 = srcVec3[prevIndex * 3 + 1];
+            float3 tang0 = srcVec3[prevIndex * 3 + 2];
+            float3 tang1 = srcVec3[nextIndex * 3];
+            float3 vert1 = srcVec3[nextIndex * 3 + 1];
+            sampler.value = cubicSpline(vert0, tang0, vert1, tang1, t);
             break;
         }
 
-        case Channel::ROTATION: {
-            quatf rotation;
-            const quatf* srcQuat = (const quatf*) sampler->values.data();
-            if (sampler->interpolation == Sampler::CUBIC) {
+        case Sampler::VEC4: {
+            const quatf* srcQuat = (const quatf*) sampler.values.data();
+            if (sampler.interpolation == Sampler::CUBIC) {
                 quatf vert0 = srcQuat[prevIndex * 3 + 1];
                 quatf tang0 = srcQuat[prevIndex * 3 + 2];
                 quatf tang1 = srcQuat[nextIndex * 3];
                 quatf vert1 = srcQuat[nextIndex * 3 + 1];
-                rotation = normalize(cubicSpline(vert0, tang0, vert1, tang1, t));
+                sampler.rotation = normalize(cubicSpline(vert0, tang0, vert1, tang1, t));
             } else {
-                rotation = slerp(srcQuat[prevIndex], srcQuat[nextIndex], t);
+                sampler.rotation = slerp(srcQuat[prevIndex], srcQuat[nextIndex], t);
             }
-            trsTransformManager->setRotation(trsNode, rotation);
             break;
         }
 
-        case Channel::WEIGHTS: {
-            const float* const samplerValues = sampler->values.data();
-            assert(sampler->values.size() % times.size() == 0);
-            const int valuesPerKeyframe = sampler->values.size() / times.size();
+        case Sampler::SCALAR: {
+            const float* const samplerValues = sampler.values.data();
+            assert(sampler.values.size() % sampler.times.size() == 0);
+            const int valuesPerKeyframe = sampler.values.size() / sampler.times.size();
+            vector<float>& weights = sampler.weights;
 
-            if (sampler->interpolation == Sampler::CUBIC) {
+            if (sampler.interpolation == Sampler::CUBIC) {
                 assert(valuesPerKeyframe % 3 == 0);
                 const int numMorphTargets = valuesPerKeyframe / 3;
                 const float* const inTangents = samplerValues;
@@ -513,18 +599,119 @@ void AnimatorImpl::applyAnimation(const Channel& channel, float t, size_t prevIn
                     weights[comp] = (1 - t) * previous + t * current;
                 }
             }
+            break;
+        }
+    }
+}
 
-            auto ci = renderableManager->getInstance(channel.targetEntity);
-            renderableManager->setMorphWeights(ci, weights.data(), weights.size());
-            return;
+void AnimatorImpl::evaluateSamplers(Animation& anim, float time) {
+    // Locate the keyframes of every sampler, and gather the endpoints of linear translations and
+    // scales, which make up most of the channels, into flat arrays.
+    lerpSamplers.clear();
+    lerpFrom.clear();
+    lerpTo.clear();
+    lerpWeights.clear();
+    for (size_t i = 0, n = anim.samplers.size(); i < n; ++i) {
+        Sampler& sampler = anim.samplers[i];
+        if (sampler.times.size() < 2) {
+            continue;
         }
+        locateKeyframes(sampler, time);
+        if (sampler.type == Sampler::VEC3 && sampler.interpolation != Sampler::CUBIC) {
+            const float* from = sampler.values.data() + sampler.prevIndex * 3;
+            const float* to = sampler.values.data() + sampler.nextIndex * 3;
+            lerpSamplers.push_back(i);
+            lerpFrom.insert(lerpFrom.end(), from, from + 3);
+            lerpTo.insert(lerpTo.end(), to, to + 3);
+            lerpWeights.insert(lerpWeights.end(), 3, sampler.t);
+        } else {
+            evaluateSampler(sampler);
+        }
+    }
+
+    // Interpolate the whole batch at once. There are no dependencies between iterations, so the
+    // compiler vectorizes this loop.
+    float* const UTILS_RESTRICT result = lerpFrom.data();
+    const float* const UTILS_RESTRICT to = lerpTo.data();
+    const float* const UTILS_RESTRICT t = lerpWeights.data();
+    for (size_t i = 0, n = lerpFrom.size(); i < n; ++i) {
+        result[i] = (1 - t[i]) * result[i] + t[i] * to[i];
+    }
+    for (size_t i = 0, n = lerpSamplers.size(); i < n; ++i) {
+        anim.samplers[lerpSamplers[i]].value = { result[i * 3], result[i * 3 + 1],
+                result[i * 3 + 2] };
+    }
+}
+
+void AnimatorImpl::applyTransforms(size_t animationIndex, float time) {
+    Animation& anim = animations[animationIndex];
+    time = fmod(time, anim.duration);
+
+    // Samplers are evaluated once, even if they drive several instances.
+    evaluateSamplers(anim, time);
+
+    // Channels are sorted by target, so that the local transform of each node is composed once,
+    // regardless of how many of its components are animated.
+    const Channel* const channels = anim.channels.data();
+    for (size_t i = 0, n = anim.channels.size(); i < n;) {
+        const Entity entity = channels[i].targetEntity;
+        TrsTransformManager::Instance trsNode = trsTransformManager->getInstance(entity);
+        bool dirty = false;
+        for (; i < n && channels[i].targetEntity == entity; ++i) {
+            const Channel& channel = channels[i];
+            const Sampler* sampler = channel.sourceData;
+            if (sampler->times.size() < 2) {
+                continue;
+            }
+            switch (channel.transformType) {
+                case Channel::SCALE:
+                    trsTransformManager->setScale(trsNode, sampler->value);
+                    dirty = true;
+                    break;
+                case Channel::TRANSLATION:
+                    trsTransformManager->setTranslation(trsNode, sampler->value);
+                    dirty = true;
+                    break;
+                case Channel::ROTATION:
+                    trsTransformManager->setRotation(trsNode, sampler->rotation);
+                    dirty = true;
+                    break;
+                case Channel::WEIGHTS:
+                    // See applyMorphWeights().
+                    break;
+            }
+        }
+        if (dirty) {
+            TransformManager::Instance node = transformManager->getInstance(entity);
+            transformManager->setTransform(node, trsTransformManager->getTransform(trsNode));
+        }
+    }
+}
+
+void AnimatorImpl::applyMorphWeights(size_t animationIndex) {
+    for (const Channel& channel : animations[animationIndex].channels) {
+        const Sampler* sampler = channel.sourceData;
+        if (channel.transformType != Channel::WEIGHTS || sampler->times.size() < 2) {
+            continue;
+        }
+        auto ci = renderableManager->getInstance(channel.targetEntity);
+        renderableManager->setMorphWeights(ci, sampler->weights.data(), sampler->weights.size());
     }
+}
 
-    transformManager->setTransform(node, trsTransformManager->getTransform(trsNode));
+// Nodes that are drawn as GPU instances need their transforms pushed to an InstanceBuffer.
+void AnimatorImpl::updateInstancedMeshes() {
+    if (instance) {
+        instance->updateInstancedMeshes();
+        return;
+    }
+    for (FFilamentInstance* assetInstance : asset->mInstances) {
+        assetInstance->updateInstancedMeshes();
+    }
 }
 
 void AnimatorImpl::resetBoneMatrices(FFilamentInstance* instance) {
-    for (const auto& skin : instance->mSkins) {
+    for (auto& skin : instance->mSkins) {
         size_t njoints = skin.joints.size();
         boneMatrices.resize(njoints);
         for (const auto& entity : skin.targets) {
@@ -536,36 +723,119 @@ void AnimatorImpl::resetBoneMatrices(FFilamentInstance* instance) {
                 renderableManager->setBones(renderable, boneMatrices.data(), boneMatrices.size());
             }
         }
+
+        // The next update must upload every bone again.
+        skin.jointTransforms.clear();
+        skin.targetCache.clear();
     }
 }
 
-void AnimatorImpl::updateBoneMatrices(FFilamentInstance* instance) {
-    assert_invariant(instance->mSkins.size() == asset->mSkins.size());
-    size_t skinIndex = 0;
-    for (const auto& skin : instance->mSkins) {
-        const auto& assetSkin = asset->mSkins[skinIndex++];
-        size_t njoints = skin.joints.size();
-        boneMatrices.resize(njoints);
-        for (Entity entity : skin.targets) {
-            auto renderable = renderableManager->getInstance(entity);
-            if (!renderable) {
+// Recomputes the bones of a skin whose joint or target has moved since the last update, and
+// records the ranges that need to be uploaded. This only reads from the transform and renderable
+// managers, so that skins can be processed concurrently.
+static void computeBoneMatrices(TransformManager const& tm, RenderableManager const& rm,
+        FFilamentInstance::Skin& skin, FFilamentAsset::Skin const& assetSkin) {
+    // Bones that are close enough are uploaded together, to limit the number of driver commands.
+    constexpr uint32_t MAX_RANGE_GAP = 8;
+
+    const size_t njoints = skin.joints.size();
+    const bool initialized = skin.jointTransforms.size() == njoints;
+    skin.jointTransforms.resize(njoints);
+    skin.dirtyJoints.resize(njoints);
+    bool anyJointMoved = !initialized;
+    for (size_t boneIndex = 0; boneIndex < njoints; ++boneIndex) {
+        TransformManager::Instance jointInstance = tm.getInstance(skin.joints[boneIndex]);
+        const mat4 globalJointTransform = tm.getWorldTransformAccurate(jointInstance);
+        const bool moved = !initialized || globalJointTransform != skin.jointTransforms[boneIndex];
+        skin.jointTransforms[boneIndex] = globalJointTransform;
+        skin.dirtyJoints[boneIndex] = moved;
+        anyJointMoved = anyJointMoved || moved;
+    }
+
+    for (Entity entity : skin.targets) {
+        FFilamentInstance::SkinTarget& target = skin.targetCache[entity];
+        target.dirtyRanges.clear();
+        if (!rm.getInstance(entity)) {
+            continue;
+        }
+        mat4 globalTransform;
+        auto xformable = tm.getInstance(entity);
+        if (xformable) {
+            globalTransform = tm.getWorldTransformAccurate(xformable);
+        }
+
+        // When the target itself moves, all of its bones change.
+        const bool targetMoved = target.boneMatrices.size() != njoints ||
+                globalTransform != target.worldTransform;
+        if (!targetMoved && !anyJointMoved) {
+            continue;
+        }
+        target.worldTransform = globalTransform;
+        target.boneMatrices.resize(njoints);
+
+        const mat4 inverseGlobalTransform = xformable ? inverse(globalTransform) : mat4();
+        auto& ranges = target.dirtyRanges;
+        for (uint32_t boneIndex = 0; boneIndex < njoints; ++boneIndex) {
+            if (!targetMoved && !skin.dirtyJoints[boneIndex]) {
                 continue;
             }
-            mat4 inverseGlobalTransform;
-            auto xformable = transformManager->getInstance(entity);
-            if (xformable) {
-                inverseGlobalTransform = inverse(transformManager->getWorldTransformAccurate(xformable));
+            const mat4f& inverseBindMatrix = assetSkin.inverseBindMatrices[boneIndex];
+            target.boneMatrices[boneIndex] =
+                    mat4f{ inverseGlobalTransform * skin.jointTransforms[boneIndex] } *
+                    inverseBindMatrix;
+            if (!ranges.empty() &&
+                    boneIndex - (ranges.back().offset + ranges.back().count) <= MAX_RANGE_GAP) {
+                ranges.back().count = boneIndex + 1 - ranges.back().offset;
+            } else {
+                ranges.push_back({ boneIndex, 1 });
             }
-            for (size_t boneIndex = 0; boneIndex < njoints; ++boneIndex) {
-                const auto& joint = skin.joints[boneIndex];
-                const mat4f& inverseBindMatrix = assetSkin.inverseBindMatrices[boneIndex];
-                TransformManager::Instance jointInstance = transformManager->getInstance(joint);
-                mat4 globalJointTransform = transformManager->getWorldTransformAccurate(jointInstance);
-                boneMatrices[boneIndex] =
-                        mat4f{ inverseGlobalTransform * globalJointTransform } *
-                        inverseBindMatrix;
+        }
+    }
+}
+
+void AnimatorImpl::updateBoneMatrices(FFilamentInstance* const* instances, size_t count) {
+    struct SkinRef {
+        FFilamentInstance::Skin* skin;
+        FFilamentAsset::Skin const* assetSkin;
+    };
+    vector<SkinRef> skins;
+    for (size_t i = 0; i < count; ++i) {
+        FFilamentInstance* instance = instances[i];
+        assert_invariant(instance->mSkins.size() == instance->mOwner->mSkins.size());
+        for (size_t skinIndex = 0; skinIndex < instance->mSkins.size(); ++skinIndex) {
+            skins.push_back({ &instance->mSkins[skinIndex], &instance->mOwner->mSkins[skinIndex] });
+        }
+    }
+
+    // The bone matrices are computed concurrently when there are many skins, e.g. when a crowd
+    // of instances is updated at once, but they are uploaded serially.
+    auto work = [this](SkinRef* refs, uint32_t n) {
+        for (uint32_t i = 0; i < n; ++i) {
+            computeBoneMatrices(*transformManager, *renderableManager,
+                    *refs[i].skin, *refs[i].assetSkin);
+        }
+    };
+    if (skins.size() > 1) {
+        JobSystem& js = asset->mEngine->getJobSystem();
+        auto* job = jobs::parallel_for(js, nullptr, skins.data(), uint32_t(skins.size()),
+                std::cref(work), jobs::CountSplitter<4>());
+        js.runAndWait(job);
+    } else {
+        work(skins.data(), uint32_t(skins.size()));
+    }
+
+    for (const SkinRef& ref : skins) {
+        for (Entity entity : ref.skin->targets) {
+            auto iter = ref.skin->targetCache.find(entity);
+            if (iter == ref.skin->targetCache.end() || iter->second.dirtyRanges.empty()) {
+                continue;
+            }
+            const FFilamentInstance::SkinTarget& target = iter->second;
+            auto renderable = renderableManager->getInstance(entity);
+            for (const FFilamentInstance::BoneRange& range : target.dirtyRanges) {
+                renderableManager->setBones(renderable, target.boneMatrices.data() + range.offset,
+                        range.count, range.offset);
             }
-            renderableManager->setBones(renderable, boneMatrices.data(), boneMatrices.size());
         }
     }
 }
@@ -60,26 +60,150 @@ static bool strIsEqual(const CString& a, const char* b) {
 
 void ArchiveCache::load(const void* archiveData, uint64_t archiveByteCount) {
     assert_invariant(mArchive == nullptr && "Do not call load() twice");
-    const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveByteCount);
-    if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
-        PANIC_POSTCONDITION("Decompression error.");
+
+    // Uncompressed archives are used in place when possible, they are never modified since the
+    // offsets are resolved on the fly.
+    uint32_t magic = 0;
+    if (archiveByteCount >= sizeof(magic)) {
+        memcpy(&magic, archiveData, sizeof(magic));
+    }
+    if (magic == ARCHIVE_MAGIC) {
+        if ((uintptr_t(archiveData) % alignof(uint64_t)) == 0) {
+            mArchive = (ReadableArchive const*) archiveData;
+            mOwnsArchive = false;
+        } else {
+            void* basePointer = utils::aligned_alloc(archiveByteCount, 8);
+            memcpy(basePointer, archiveData, archiveByteCount);
+            mArchive = (ReadableArchive const*) basePointer;
+            mOwnsArchive = true;
+        }
+    } else {
+        const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveByteCount);
+        if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
+            PANIC_POSTCONDITION("Decompression error.");
+        }
+        uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
+        ZSTD_decompress(basePointer, decompSize, archiveData, archiveByteCount);
+        mArchive = (ReadableArchive const*) basePointer;
+        mOwnsArchive = true;
     }
-    uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
-    ZSTD_decompress(basePointer, decompSize, archiveData, archiveByteCount);
-    mArchive = (ReadableArchive*) basePointer;
-    convertOffsetsToPointers(mArchive);
     mMaterials = FixedCapacityVector<Material*>(mArchive->specsCount, nullptr);
 }
 
-// This loops though all ubershaders and returns the first one that meets the given requirements.
+ArchiveSpec const& ArchiveCache::getSpec(size_t index) const noexcept {
+    return resolveOffset<ArchiveSpec>(mArchive, mArchive->specsOffset)[index];
+}
+
+Material* ArchiveCache::getOrCreateMaterial(size_t index) {
+    if (mMaterials[index] == nullptr) {
+        ArchiveSpec const& spec = getSpec(index);
+        mMaterials[index] = Material::Builder()
+            .package(resolveOffset<uint8_t>(mArchive, spec.packageOffset), spec.packageByteCount)
+            .build(mEngine);
+    }
+    return mMaterials[index];
+}
+
+// Matches the requirements against the flags of a spec by name, used with archives that do not
+// have a feature index.
+bool ArchiveCache::isSuitable(size_t index, const ArchiveRequirements& reqs) const {
+    const ArchiveSpec& spec = getSpec(index);
+    ArchiveFlag const* flags = resolveOffset<ArchiveFlag>(mArchive, spec.flagsOffset);
+
+    // For each feature required by the mesh, this ubershader is suitable only if it includes a
+    // feature flag for it and the feature flag is either OPTIONAL or REQUIRED.
+    for (const auto& req : reqs.features) {
+        const CString& meshRequirement = req.first;
+        if (req.second == false) {
+            continue;
+        }
+        bool found = false;
+        for (uint64_t j = 0; j < spec.flagsCount && !found; ++j) {
+            const ArchiveFlag& flag = flags[j];
+            if (strIsEqual(meshRequirement, resolveOffset<char>(mArchive, flag.nameOffset))) {
+                if (flag.value != ArchiveFeature::UNSUPPORTED) {
+                    found = true;
+                }
+                break;
+            }
+        }
+        if (!found) {
+            debugSuitability(index, meshRequirement.c_str());
+            return false;
+        }
+    }
+
+    // If this ubershader requires a certain feature to be enabled in the glTF, but the glTF
+    // mesh doesn't have it, then this ubershader is not suitable. This occurs very rarely, so
+    // it intentionally comes after the other suitability check.
+    for (uint64_t j = 0; j < spec.flagsCount; ++j) {
+        ArchiveFlag const& flag = flags[j];
+        if (UTILS_UNLIKELY(flag.value == ArchiveFeature::REQUIRED)) {
+            // This allocates a new CString just to make a robin_map lookup, but this is rare
+            // because almost none of our feature flags are REQUIRED.
+            const char* name = resolveOffset<char>(mArchive, flag.nameOffset);
+            auto iter = reqs.features.find(CString(name));
+            if (iter == reqs.features.end() || iter.value() == false) {
+                debugSuitability(index, name);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Same as above, but using the precomputed masks of an indexed archive.
+bool ArchiveCache::isSuitable(size_t index, uint64_t requestMask) const noexcept {
+    ArchiveSpecMasks const& masks =
+            resolveOffset<ArchiveSpecMasks>(mArchive, mArchive->specMasksOffset)[index];
+    if (requestMask & ~masks.supported) {
+        debugSuitability(index, "unsupported feature.");
+        return false;
+    }
+    if (UTILS_UNLIKELY(masks.required & ~requestMask)) {
+        debugSuitability(index, "missing required feature.");
+        return false;
+    }
+    return true;
+}
+
+// This returns the first ubershader that meets the given requirements. Archives that have a
+// feature index are matched with bitmasks and the result is cached, otherwise this loops though
+// all ubershaders and compares their flags by name.
 Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
     assert_invariant(mArchive && "Please call load() before requesting any materials.");
     if (mArchive == nullptr) {
         return nullptr;
     }
 
+    const bool indexed = mArchive->version >= 1 && mArchive->featureBucketCount > 0;
+    uint64_t requestMask = 0;
+    bool requestIsSatisfiable = true;
+    if (indexed) {
+        for (const auto& req : reqs.features) {
+            if (req.second == false) {
+                continue;
+            }
+            int bit = findFeatureBit(mArchive, req.first.c_str(), req.first.size());
+            if (bit < 0) {
+                // None of the ubershaders has a flag for this feature.
+                requestIsSatisfiable = false;
+                break;
+            }
+            requestMask |= uint64_t(1) << bit;
+        }
+        if (!requestIsSatisfiable) {
+            return nullptr;
+        }
+        auto iter = mSpecIndexCache.find({ requestMask, reqs.shadingModel, reqs.blendingMode });
+        if (iter != mSpecIndexCache.end()) {
+            return iter->second == NO_SPEC ? nullptr : getOrCreateMaterial(iter->second);
+        }
+    }
+
+    uint32_t result = NO_SPEC;
     for (uint64_t i = 0; i < mArchive->specsCount; ++i) {
-        const ArchiveSpec& spec = mArchive->specs[i];
+        const ArchiveSpec& spec = getSpec(i);
         if (spec.blendingMode != INVALID_BLENDING && spec.blendingMode != reqs.blendingMode) {
             debugSuitability(i, "blend mode mismatch.");
             continue;
@@ -88,71 +212,23 @@ Material* ArchiveCache::getMaterial(const ArchiveRequirements& reqs) {
             debugSuitability(i, "material model.");
             continue;
         }
-        bool specIsSuitable = true;
-
-        // For each feature required by the mesh, this ubershader is suitable only if it includes a
-        // feature flag for it and the feature flag is either OPTIONAL or REQUIRED.
-        for (const auto& req : reqs.features) {
-            const CString& meshRequirement = req.first;
-            if (req.second == false) {
-                continue;
-            }
-            bool found = false;
-            for (uint64_t j = 0; j < spec.flagsCount && !found; ++j) {
-                const ArchiveFlag& flag = spec.flags[j];
-                if (strIsEqual(meshRequirement, flag.name)) {
-                    if (flag.value != ArchiveFeature::UNSUPPORTED) {
-                        found = true;
-                    }
-                    break;
-                }
-            }
-            if (!found) {
-                debugSuitability(i, meshRequirement.c_str());
-                specIsSuitable = false;
-                break;
-            }
-        }
-
-        // If this ubershader requires a certain feature to be enabled in the glTF, but the glTF
-        // mesh doesn't have it, then this ubershader is not suitable. This occurs very rarely, so
-        // it intentionally comes after the other suitability check.
-        for (uint64_t j = 0; j < spec.flagsCount && specIsSuitable; ++j) {
-            ArchiveFlag const& flag = spec.flags[j];
-            if (UTILS_UNLIKELY(flag.value == ArchiveFeature::REQUIRED)) {
-                // This allocates a new CString just to make a robin_map lookup, but this is rare
-                // because almost none of our feature flags are REQUIRED.
-                auto iter = reqs.features.find(CString(flag.name));
-                if (iter == reqs.features.end() || iter.value() == false) {
-                    debugSuitability(i, flag.name);
-                    specIsSuitable = false;
-                }
-            }
+        if (indexed ? isSuitable(i, requestMask) : isSuitable(i, reqs)) {
+            result = uint32_t(i);
+            break;
         }
+    }
 
-        if (specIsSuitable) {
-            if (mMaterials[i] == nullptr) {
-                mMaterials[i] = Material::Builder()
-                    .package(spec.package, spec.packageByteCount)
-                    .build(mEngine);
-            }
-
-            return mMaterials[i];
-        }
+    if (indexed) {
+        mSpecIndexCache[{ requestMask, reqs.shadingModel, reqs.blendingMode }] = result;
     }
-    return nullptr;
+    return result == NO_SPEC ? nullptr : getOrCreateMaterial(result);
 }
 
 Material* ArchiveCache::getDefaultMaterial() {
     assert_invariant(mArchive && "Please call load() before requesting any materials.");
     assert_invariant(!mMaterials.empty() && "Archive must have at least one material.");
     if (!mArchive) return nullptr;
-    if (mMaterials[0] == nullptr) {
-        mMaterials[0] = Material::Builder()
-            .package(mArchive->specs[0].package, mArchive->specs[0].packageByteCount)
-            .build(mEngine);
-    }
-    return mMaterials[0];
+    return getOrCreateMaterial(0);
 }
 
 void ArchiveCache::destroyMaterials() {
@@ -164,10 +240,11 @@ FeatureMap ArchiveCache::getFeatureMap(Material* material) const {
     FeatureMap features;
     for (size_t specIndex = 0; specIndex < mMaterials.size(); ++specIndex) {
         if (material == mMaterials[specIndex]) {
-            const ArchiveSpec& spec = mArchive->specs[specIndex];
+            const ArchiveSpec& spec = getSpec(specIndex);
+            ArchiveFlag const* flags = resolveOffset<ArchiveFlag>(mArchive, spec.flagsOffset);
             for (uint64_t j = 0; j < spec.flagsCount; ++j) {
-                const ArchiveFlag& flag = spec.flags[j];
-                features[flag.name] = flag.value;
+                const ArchiveFlag& flag = flags[j];
+                features[resolveOffset<char>(mArchive, flag.nameOffset)] = flag.value;
             }
             break;
         }
@@ -178,7 +255,9 @@ FeatureMap ArchiveCache::getFeatureMap(Material* material) const {
 ArchiveCache::~ArchiveCache() {
     assert_invariant(mMaterials.empty() &&
         "Please call destroyMaterials explicitly to ensure correct destruction order");
-    utils::aligned_free(mArchive);
+    if (mOwnsArchive) {
+        utils::aligned_free((void*) mArchive);
+    }
 }
 
 } // namespace filament::gltfio
@@ -22,6 +22,7 @@
 
 #include <tsl/robin_map.h>
 
+#include <functional>
 #include <string_view>
 
 #include <uberz/ReadableArchive.h>
@@ -50,9 +51,35 @@ namespace filament::gltfio {
         FeatureMap getFeatureMap(Material* material) const;
 
     private:
+        uberz::ArchiveSpec const& getSpec(size_t index) const noexcept;
+        bool isSuitable(size_t index, const ArchiveRequirements& requirements) const;
+        bool isSuitable(size_t index, uint64_t requestMask) const noexcept;
+        Material* getOrCreateMaterial(size_t index);
+
         Engine& mEngine;
         utils::FixedCapacityVector<Material*> mMaterials;
-        uberz::ReadableArchive* mArchive = nullptr;
+        uberz::ReadableArchive const* mArchive = nullptr;
+        bool mOwnsArchive = false;
+
+        // Caches the index of the spec selected for a given set of requirements, keyed by the
+        // feature mask, shading model and blending mode. Only used with indexed archives.
+        struct SpecKey {
+            uint64_t features;
+            Shading shadingModel;
+            BlendingMode blendingMode;
+            bool operator==(SpecKey const& rhs) const noexcept {
+                return features == rhs.features && shadingModel == rhs.shadingModel &&
+                       blendingMode == rhs.blendingMode;
+            }
+        };
+        struct SpecKeyHasher {
+            size_t operator()(SpecKey const& key) const noexcept {
+                return std::hash<uint64_t>{}(key.features) ^
+                       (size_t(key.shadingModel) << 8u | size_t(key.blendingMode));
+            }
+        };
+        static constexpr uint32_t NO_SPEC = UINT32_MAX;
+        tsl::robin_map<SpecKey, uint32_t, SpecKeyHasher> mSpecIndexCache;
     };
 
     struct ArchiveRequirements {
@@ -29,6 +29,7 @@
 #include <filament/Camera.h>
 #include <filament/Engine.h>
 #include <filament/IndexBuffer.h>
+#include <filament/InstanceBuffer.h>
 #include <filament/LightManager.h>
 #include <filament/Material.h>
 #include <filament/MorphTargetBuffer.h>
@@ -45,6 +46,7 @@
 #include <utils/compiler.h>
 #include <utils/EntityManager.h>
 #include <utils/FixedCapacityVector.h>
+#include <utils/JobSystem.h>
 #include <utils/Log.h>
 #include <utils/Panic.h>
 #include <utils/NameComponentManager.h>
@@ -52,6 +54,14 @@
 
 #include <tsl/robin_map.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #define CGLTF_IMPLEMENTATION
 #include <cgltf.h>
 
@@ -67,6 +77,46 @@ using SceneMask = NodeManager::SceneMask;
 
 static const auto FREE_CALLBACK = [](void* mem, size_t, void*) { free(mem); };
 
+// Set this to true to log the time spent in each phase of the asset creation.
+static constexpr bool DEBUG_LOAD_TIMINGS = false;
+
+struct LoadTimer {
+    using clock = std::chrono::steady_clock;
+    clock::time_point last = clock::now();
+    void lap(const char* phase) {
+        if constexpr (DEBUG_LOAD_TIMINGS) {
+            const clock::time_point now = clock::now();
+            slog.i << "gltfio: " << phase << " took "
+                   << std::chrono::duration<float, std::milli>(now - last).count() << " ms"
+                   << io::endl;
+            last = now;
+        }
+    }
+};
+
+// Layout of the Filament objects of a primitive, computed concurrently from the cgltf data before
+// the objects are created serially.
+struct PrimitivePlan {
+    const cgltf_primitive* inPrim = nullptr;
+    Primitive* outPrim = nullptr;
+    const char* name = nullptr;
+    AttributeBitset requiredAttributes;
+
+    IndexBuffer::Builder ibb;
+    IndexBuffer::BufferDescriptor generatedIndices;
+    VertexBuffer::Builder vbb;
+    std::vector<BufferSlot> vertexSlots;
+    uint32_t vertexCount = 0;
+    cgltf_size targetsCount = 0;
+    int dummySlot = 0;
+    bool hasIndices = false;
+    bool needsDummyData = false;
+
+    // Messages are logged when the primitive is built, errors are flagged with true.
+    std::vector<std::pair<bool, std::string>> messages;
+    bool valid = true;
+};
+
 // The default glTF material.
 static constexpr cgltf_material kDefaultMat = {
     .name = (char*) "Default GLTF material",
@@ -118,6 +168,42 @@ static bool primitiveHasVertexColor(const cgltf_primitive& inPrim) {
     return false;
 }
 
+// Reads the array of numbers under the given key of a JSON object, e.g. the node indices of the
+// MSFT_lod extension. This is not a general JSON parser, it only needs to handle the few keys used
+// by the extensions that cgltf does not parse.
+static bool parseNumberArray(std::string const& json, const char* key, std::vector<float>* out) {
+    const std::string quotedKey = std::string("\"") + key + "\"";
+    size_t pos = json.find(quotedKey);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = json.find_first_not_of(" \t\r\n", pos + quotedKey.size());
+    if (pos == std::string::npos || json[pos] != ':') {
+        return false;
+    }
+    pos = json.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string::npos || json[pos] != '[') {
+        return false;
+    }
+    out->clear();
+    const char* cursor = json.c_str() + pos + 1;
+    while (true) {
+        while (*cursor == ',' || isspace(*cursor)) {
+            cursor++;
+        }
+        if (*cursor == ']') {
+            return true;
+        }
+        char* end;
+        const float value = strtof(cursor, &end);
+        if (end == cursor) {
+            return false;
+        }
+        out->push_back(value);
+        cursor = end;
+    }
+}
+
 static LightManager::Type getLightType(const cgltf_light_type light) {
     switch (light) {
         case cgltf_light_type_max_enum:
@@ -224,6 +310,7 @@ struct FAssetLoader : public AssetLoader {
             mTransformManager(config.engine->getTransformManager()),
             mMaterials(*config.materials),
             mEngine(*config.engine),
+            mAutomaticInstancing(config.automaticInstancing),
             mDefaultNodeName(config.defaultNodeName) {}
 
     FFilamentAsset* createAsset(const uint8_t* bytes, uint32_t nbytes);
@@ -261,17 +348,22 @@ private:
 
     // Methods used during the first traveral (creation of VertexBuffer, IndexBuffer, etc)
     FFilamentAsset* createRootAsset(const cgltf_data* srcAsset);
-    void recursePrimitives(const cgltf_node* rootNode, FFilamentAsset* fAsset);
-    void createPrimitives(const cgltf_node* node, const char* name, FFilamentAsset* fAsset);
-    bool createPrimitive(const cgltf_primitive& inPrim, const char* name, Primitive* outPrim,
-            FFilamentAsset* fAsset);
+    void recursePrimitives(const cgltf_node* rootNode, FFilamentAsset* fAsset,
+            std::vector<const cgltf_node*>* meshNodes, std::vector<const cgltf_node*>* lodNodes);
+    void addLevelsOfDetail(const cgltf_node* node, FFilamentAsset* fAsset,
+            std::vector<const cgltf_node*>* lodNodes);
+    void createPrimitives(FFilamentAsset* fAsset, std::vector<const cgltf_node*> const& meshNodes,
+            std::vector<const cgltf_node*> const& lodNodes);
+    void planPrimitive(PrimitivePlan& plan, FFilamentAsset* fAsset) const;
+    bool buildPrimitive(PrimitivePlan& plan, FFilamentAsset* fAsset);
 
     // Methods used during subsequent traverals (creation of entities, renderables, etc)
     void createInstances(size_t numInstances, FFilamentAsset* fAsset);
     void recurseEntities(const cgltf_node* node, SceneMask scenes, Entity parent,
             FFilamentAsset* fAsset, FFilamentInstance* instance);
     void createRenderable(const cgltf_node* node, Entity entity, const char* name,
-            FFilamentAsset* fAsset);
+            FFilamentAsset* fAsset, InstanceBuffer* instanceBuffer = nullptr);
+    void createInstancedMeshes(FFilamentAsset* fAsset, FFilamentInstance* instance);
     void createLight(const cgltf_light* light, Entity entity, FFilamentAsset* fAsset);
     void createCamera(const cgltf_camera* camera, Entity entity, FFilamentAsset* fAsset);
     void addTextureBinding(MaterialInstance* materialInstance, const char* parameterName,
@@ -298,6 +390,7 @@ public:
     Engine& mEngine;
     FNodeManager mNodeManager;
     FTrsTransformManager mTrsTransformManager;
+    const bool mAutomaticInstancing;
 
     // Transient state used only for the asset currently being loaded:
     const char* mDefaultNodeName;
@@ -305,6 +398,14 @@ public:
     bool mDiagnosticsEnabled = false;
     MaterialInstanceCache mMaterialInstanceCache;
 
+    // Nodes of the instance being created that can be drawn as GPU instances, grouped by mesh and
+    // by scene membership. See AssetConfiguration::automaticInstancing.
+    struct InstancingGroup {
+        SceneMask scenes;
+        std::vector<std::pair<const cgltf_node*, Entity>> nodes;
+    };
+    std::map<std::pair<const cgltf_mesh*, uint32_t>, InstancingGroup> mInstancingGroups;
+
     // Weak reference to the largest dummy buffer so far in the current loading phase.
     BufferObject* mDummyBufferObject = nullptr;
 };
@@ -404,6 +505,8 @@ FilamentInstance* FAssetLoader::createInstance(FFilamentAsset* fAsset) {
         recurseEntities(pair.first, pair.second, instanceRoot, fAsset, instance);
     }
 
+    createInstancedMeshes(fAsset, instance);
+
     importSkins(instance, srcAsset);
 
     // Now that all entities have been created, the instance can create the animator component.
@@ -479,9 +582,12 @@ FFilamentAsset* FAssetLoader::createRootAsset(const cgltf_data* srcAsset) {
         }
     }
 
+    std::vector<const cgltf_node*> meshNodes;
+    std::vector<const cgltf_node*> lodNodes;
     for (const auto& [node, sceneMask] : fAsset->mRootNodes) {
-        recursePrimitives(node, fAsset);
+        recursePrimitives(node, fAsset, &meshNodes, &lodNodes);
     }
+    createPrimitives(fAsset, meshNodes, lodNodes);
 
     // Find every unique resource URI and store a pointer to any of the cgltf-owned cstrings
     // that match the URI. These strings get freed during releaseSourceData().
@@ -505,20 +611,86 @@ FFilamentAsset* FAssetLoader::createRootAsset(const cgltf_data* srcAsset) {
     return fAsset;
 }
 
-void FAssetLoader::recursePrimitives(const cgltf_node* node, FFilamentAsset* fAsset) {
-    const char* name = getNodeName(node, mDefaultNodeName);
-    name = name ? name : "node";
-
+void FAssetLoader::recursePrimitives(const cgltf_node* node, FFilamentAsset* fAsset,
+        std::vector<const cgltf_node*>* meshNodes, std::vector<const cgltf_node*>* lodNodes) {
     if (node->mesh) {
-        createPrimitives(node, name, fAsset);
+        meshNodes->push_back(node);
         fAsset->mRenderableCount++;
+        addLevelsOfDetail(node, fAsset, lodNodes);
     }
 
     for (cgltf_size i = 0, len = node->children_count; i < len; ++i) {
-        recursePrimitives(node->children[i], fAsset);
+        recursePrimitives(node->children[i], fAsset, meshNodes, lodNodes);
     }
 }
 
+// Handles the MSFT_lod extension, which lists the nodes that hold the lower levels of detail of a
+// node. Only the meshes of these nodes are used: they become extra levels of detail of the
+// renderable of the node, see RenderableManager::Builder::levelOfDetail(). The screen coverage of
+// each level comes from the MSFT_screencoverage array in the node extras, if any.
+void FAssetLoader::addLevelsOfDetail(const cgltf_node* node, FFilamentAsset* fAsset,
+        std::vector<const cgltf_node*>* lodNodes) {
+    const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
+    std::vector<float> ids;
+    for (cgltf_size i = 0, len = node->extensions_count; i < len; ++i) {
+        const cgltf_extension& extension = node->extensions[i];
+        if (!strcmp(extension.name, "MSFT_lod") && extension.data) {
+            if (!parseNumberArray(extension.data, "ids", &ids)) {
+                slog.w << "Ignoring malformed MSFT_lod extension." << io::endl;
+                ids.clear();
+            }
+            break;
+        }
+    }
+    if (ids.empty()) {
+        return;
+    }
+
+    FFilamentAsset::LevelsOfDetail lods;
+    lods.meshes = FixedCapacityVector<const cgltf_mesh*>::with_capacity(ids.size() + 1);
+    lods.meshes.push_back(node->mesh);
+    for (float id : ids) {
+        if (id < 0.0f || id >= float(srcAsset->nodes_count)) {
+            slog.w << "Ignoring MSFT_lod extension with invalid node index." << io::endl;
+            return;
+        }
+        const cgltf_node* lodNode = srcAsset->nodes + size_t(id);
+        lods.meshes.push_back(lodNode->mesh);
+        if (lodNode->mesh) {
+            lodNodes->push_back(lodNode);
+        }
+    }
+
+    // MSFT_screencoverage is the fraction of the screen area covered by the node. The screen size
+    // used by RenderableManager is a length, so the square root of the coverage is a reasonable
+    // approximation. By default, each level is drawn at half the size of the previous one.
+    const size_t levelCount = lods.meshes.size();
+    lods.screenSizes = FixedCapacityVector<float>(levelCount);
+    for (size_t level = 0; level < levelCount; ++level) {
+        lods.screenSizes[level] = level + 1 < levelCount ? std::pow(0.5f, float(level + 1)) : 0.0f;
+    }
+    std::vector<float> coverages;
+    const cgltf_size extrasSize = node->extras.end_offset - node->extras.start_offset;
+    if (extrasSize > 0 && parseNumberArray(
+            std::string(srcAsset->json + node->extras.start_offset, extrasSize),
+            "MSFT_screencoverage", &coverages)) {
+        bool decreasing = coverages.size() >= levelCount;
+        for (size_t level = 1; decreasing && level < levelCount; ++level) {
+            decreasing = coverages[level] < coverages[level - 1];
+        }
+        if (decreasing) {
+            for (size_t level = 0; level < levelCount; ++level) {
+                lods.screenSizes[level] = std::sqrt(std::max(0.0f, coverages[level]));
+            }
+        } else {
+            slog.w << "Ignoring MSFT_screencoverage, which must have a decreasing value for each "
+                      "level of detail." << io::endl;
+        }
+    }
+
+    fAsset->mLevelsOfDetail[node] = std::move(lods);
+}
+
 void FAssetLoader::createInstances(size_t numInstances, FFilamentAsset* fAsset) {
     // Create a separate entity hierarchy for each instance. Note that MeshCache (vertex
     // buffers and index buffers) and MaterialInstanceCache (materials and textures) help avoid
@@ -537,6 +709,13 @@ void FAssetLoader::createInstances(size_t numInstances, FFilamentAsset* fAsset)
         return rm.hasComponent(a);
     });
 
+    // With automatic instancing, nodes that share a mesh do not have their own renderable.
+    if (mAutomaticInstancing && !fAsset->mInstances.empty()) {
+        const auto& entities = fAsset->mInstances[0]->mEntities;
+        fAsset->mRenderableCount = std::count_if(entities.begin(), entities.end(),
+                [&rm](Entity a) { return rm.hasComponent(a); });
+    }
+
     if (mError) {
         destroyAsset(fAsset);
         fAsset = nullptr;
@@ -594,8 +773,16 @@ void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Ent
     // If no name is provided in the glTF or AssetConfiguration, use "node" for error messages.
     name = name ? name : "node";
 
-    // If the node has a mesh, then create a renderable component.
-    if (node->mesh) {
+    // If the node has a mesh, then create a renderable component, unless the mesh can be drawn
+    // together with other nodes (see createInstancedMeshes). Nodes with levels of detail are not
+    // instanced, since the level is selected per renderable.
+    if (node->mesh && mAutomaticInstancing && !node->skin && !node->weights_count &&
+            node->mesh->primitives_count && !node->mesh->primitives[0].targets_count &&
+            fAsset->mLevelsOfDetail.find(node) == fAsset->mLevelsOfDetail.end()) {
+        InstancingGroup& group = mInstancingGroups[{ node->mesh, scenes.getValue() }];
+        group.scenes = scenes;
+        group.nodes.emplace_back(node, entity);
+    } else if (node->mesh) {
         createRenderable(node, entity, name, fAsset);
         if (srcAsset->variants_count > 0) {
             createMaterialVariants(node->mesh, entity, fAsset, instance);
@@ -615,112 +802,192 @@ void FAssetLoader::recurseEntities(const cgltf_node* node, SceneMask scenes, Ent
     }
 }
 
-void FAssetLoader::createPrimitives(const cgltf_node* node, const char* name,
-        FFilamentAsset* fAsset) {
+// Creates the VertexBuffer, IndexBuffer and MorphTargetBuffer objects for every glTF mesh
+// referenced by the given nodes. This happens in phases: materials are fetched serially because
+// MaterialProvider is not thread safe, then the layout of every primitive is planned concurrently
+// from the cgltf data, and finally the Filament objects are created serially in the original
+// order.
+void FAssetLoader::createPrimitives(FFilamentAsset* fAsset,
+        std::vector<const cgltf_node*> const& meshNodes,
+        std::vector<const cgltf_node*> const& lodNodes) {
     const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
-    const cgltf_mesh* mesh = node->mesh;
     assert_invariant(srcAsset != nullptr);
-    assert_invariant(mesh != nullptr);
-
-    // If the mesh is already loaded, obtain the list of Filament VertexBuffer / IndexBuffer objects
-    // that were already generated (one for each primitive), otherwise allocate a new list of
-    // pointers for the primitives.
-    FixedCapacityVector<Primitive>& prims = fAsset->mMeshCache[mesh - srcAsset->meshes];
-    if (prims.empty()) {
+    JobSystem& js = mEngine.getJobSystem();
+    LoadTimer timer;
+    SYSTRACE_CONTEXT();
+
+    // If a mesh is referenced by multiple nodes, its primitives are only created once. The list of
+    // Filament VertexBuffer / IndexBuffer objects is stored in the mesh cache.
+    SYSTRACE_NAME_BEGIN("gltfio::fetchMaterials");
+    std::vector<PrimitivePlan> plans;
+    auto planNode = [&](const cgltf_node* node) {
+        const cgltf_mesh* mesh = node->mesh;
+        FixedCapacityVector<Primitive>& prims = fAsset->mMeshCache[mesh - srcAsset->meshes];
+        if (!prims.empty()) {
+            return;
+        }
         prims.reserve(mesh->primitives_count);
         prims.resize(mesh->primitives_count);
-    }
-
-    Aabb aabb;
-
-    for (cgltf_size index = 0, n = mesh->primitives_count; index < n; ++index) {
-        Primitive& outputPrim = prims[index];
-        const cgltf_primitive& inputPrim = mesh->primitives[index];
-
-        // Create a Filament VertexBuffer and IndexBuffer for this prim if we haven't already.
-        if (!outputPrim.vertices && !createPrimitive(inputPrim, name, &outputPrim, fAsset)) {
+        const char* name = getNodeName(node, mDefaultNodeName);
+        for (cgltf_size index = 0, n = mesh->primitives_count; index < n; ++index) {
+            const cgltf_primitive& inputPrim = mesh->primitives[index];
+            Material* material = getMaterial(srcAsset, inputPrim.material, &prims[index].uvmap,
+                    primitiveHasVertexColor(inputPrim));
+            PrimitivePlan& plan = plans.emplace_back();
+            plan.inPrim = &inputPrim;
+            plan.outPrim = &prims[index];
+            plan.name = name ? name : "node";
+            plan.requiredAttributes = material->getRequiredAttributes();
+        }
+    };
+    std::for_each(meshNodes.begin(), meshNodes.end(), planNode);
+    std::for_each(lodNodes.begin(), lodNodes.end(), planNode);
+    SYSTRACE_NAME_END();
+    timer.lap("fetch materials");
+
+    SYSTRACE_NAME_BEGIN("gltfio::planPrimitives");
+    auto planWork = [this, fAsset](PrimitivePlan* plans, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            planPrimitive(plans[i], fAsset);
+        }
+    };
+    auto* planJob = jobs::parallel_for(js, nullptr, plans.data(), uint32_t(plans.size()),
+            std::cref(planWork), jobs::CountSplitter<16>());
+    js.runAndWait(planJob);
+    SYSTRACE_NAME_END();
+    timer.lap("plan primitives");
+
+    SYSTRACE_NAME_BEGIN("gltfio::buildPrimitives");
+    for (PrimitivePlan& plan : plans) {
+        if (!buildPrimitive(plan, fAsset)) {
             mError = true;
-            return;
+            break;
         }
-
-        // Expand the object-space bounding box.
-        aabb.min = min(outputPrim.aabb.min, aabb.min);
-        aabb.max = max(outputPrim.aabb.max, aabb.max);
+    }
+    SYSTRACE_NAME_END();
+    timer.lap("build primitives");
+    if (mError) {
+        return;
     }
 
-    mat4f worldTransform;
-    cgltf_node_transform_world(node, &worldTransform[0][0]);
-
-    const Aabb transformed = aabb.transform(worldTransform);
-    fAsset->mBoundingBox.min = min(fAsset->mBoundingBox.min, transformed.min);
-    fAsset->mBoundingBox.max = max(fAsset->mBoundingBox.max, transformed.max);
- }
+    // Expand the asset's bounding box with the world-space bounds of each mesh, except for the lower
+    // levels of detail, which do not have a place in the scene. Computing the world
+    // transform walks up the hierarchy, so this is done concurrently.
+    SYSTRACE_NAME_BEGIN("gltfio::computeBounds");
+    FixedCapacityVector<Aabb> bounds(meshNodes.size());
+    auto boundsWork = [srcAsset, fAsset, &meshNodes, &bounds](uint32_t start, uint32_t count) {
+        for (uint32_t i = start; i < start + count; i++) {
+            const cgltf_node* node = meshNodes[i];
+            const FixedCapacityVector<Primitive>& prims =
+                    fAsset->mMeshCache[node->mesh - srcAsset->meshes];
+            Aabb aabb;
+            for (const Primitive& prim : prims) {
+                aabb.min = min(prim.aabb.min, aabb.min);
+                aabb.max = max(prim.aabb.max, aabb.max);
+            }
+            mat4f worldTransform;
+            cgltf_node_transform_world(node, &worldTransform[0][0]);
+            bounds[i] = aabb.transform(worldTransform);
+        }
+    };
+    auto* boundsJob = jobs::parallel_for(js, nullptr, 0, uint32_t(meshNodes.size()),
+            std::cref(boundsWork), jobs::CountSplitter<64>());
+    js.runAndWait(boundsJob);
+    for (const Aabb& transformed : bounds) {
+        fAsset->mBoundingBox.min = min(fAsset->mBoundingBox.min, transformed.min);
+        fAsset->mBoundingBox.max = max(fAsset->mBoundingBox.max, transformed.max);
+    }
+    SYSTRACE_NAME_END();
+    timer.lap("compute bounds");
+}
 
 void FAssetLoader::createRenderable(const cgltf_node* node, Entity entity, const char* name,
-        FFilamentAsset* fAsset) {
+        FFilamentAsset* fAsset, InstanceBuffer* instanceBuffer) {
     const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
     const cgltf_mesh* mesh = node->mesh;
-    const cgltf_size primitiveCount = mesh->primitives_count;
 
-    // If the mesh is already loaded, obtain the list of Filament VertexBuffer / IndexBuffer objects
-    // that were already generated (one for each primitive).
-    FixedCapacityVector<Primitive>& prims = fAsset->mMeshCache[mesh - srcAsset->meshes];
-    assert_invariant(prims.size() == primitiveCount);
-    Primitive* outputPrim = prims.data();
-    const cgltf_primitive* inputPrim = &mesh->primitives[0];
+    // With MSFT_lod, the primitives of the lower levels of detail follow those of the node's mesh.
+    const auto lodIter = fAsset->mLevelsOfDetail.find(node);
+    const FFilamentAsset::LevelsOfDetail* lods =
+            lodIter != fAsset->mLevelsOfDetail.end() ? &lodIter->second : nullptr;
+    const size_t levelCount = lods ? lods->meshes.size() : 1;
+    cgltf_size primitiveCount = 0;
+    for (size_t level = 0; level < levelCount; ++level) {
+        const cgltf_mesh* levelMesh = lods ? lods->meshes[level] : mesh;
+        primitiveCount += levelMesh ? levelMesh->primitives_count : 0;
+    }
 
     Aabb aabb;
 
     // glTF spec says that all primitives must have the same number of morph targets.
-    const cgltf_size numMorphTargets = inputPrim ? inputPrim->targets_count : 0;
+    const cgltf_size numMorphTargets =
+            mesh->primitives_count ? mesh->primitives[0].targets_count : 0;
     RenderableManager::Builder builder(primitiveCount);
     builder.morphing(numMorphTargets);
 
     // For each prim, create a Filament VertexBuffer, IndexBuffer, and MaterialInstance.
     // The VertexBuffer and IndexBuffer objects are cached for possible re-use, but MaterialInstance
     // is not.
-    for (cgltf_size index = 0; index < primitiveCount; ++index, ++outputPrim, ++inputPrim) {
-        RenderableManager::PrimitiveType primType;
-        if (!getPrimitiveType(inputPrim->type, &primType)) {
-            slog.e << "Unsupported primitive type in " << name << io::endl;
+    cgltf_size index = 0;
+    for (size_t level = 0; level < levelCount; ++level) {
+        const cgltf_mesh* levelMesh = lods ? lods->meshes[level] : mesh;
+        const cgltf_size levelPrimitiveCount = levelMesh ? levelMesh->primitives_count : 0;
+        if (lods) {
+            builder.levelOfDetail(level, levelPrimitiveCount, lods->screenSizes[level]);
         }
-
-        if (numMorphTargets != inputPrim->targets_count) {
-            slog.e << "Sister primitives must all have the same number of morph targets."
-                   << io::endl;
-            mError = true;
+        if (!levelMesh) {
             continue;
         }
 
-        // Create a material instance for this primitive or fetch one from the cache.
-        UvMap uvmap {};
-        bool hasVertexColor = primitiveHasVertexColor(*inputPrim);
-        MaterialInstance* mi = createMaterialInstance(inputPrim->material, &uvmap, hasVertexColor,
-                fAsset);
-        assert_invariant(mi);
-        if (!mi) {
-            mError = true;
-            continue;
-        }
+        // If the mesh is already loaded, obtain the list of Filament VertexBuffer / IndexBuffer
+        // objects that were already generated (one for each primitive).
+        FixedCapacityVector<Primitive>& prims = fAsset->mMeshCache[levelMesh - srcAsset->meshes];
+        assert_invariant(prims.size() == levelPrimitiveCount);
+        Primitive* outputPrim = prims.data();
+        const cgltf_primitive* inputPrim = levelMesh->primitives;
+        for (cgltf_size i = 0; i < levelPrimitiveCount; ++i, ++index, ++outputPrim, ++inputPrim) {
+            RenderableManager::PrimitiveType primType;
+            if (!getPrimitiveType(inputPrim->type, &primType)) {
+                slog.e << "Unsupported primitive type in " << name << io::endl;
+            }
 
-        fAsset->mDependencyGraph.addEdge(entity, mi);
-        builder.material(index, mi);
+            if (numMorphTargets != inputPrim->targets_count) {
+                slog.e << "Sister primitives must all have the same number of morph targets."
+                       << io::endl;
+                mError = true;
+                continue;
+            }
 
-        assert_invariant(outputPrim->vertices);
+            // Create a material instance for this primitive or fetch one from the cache.
+            UvMap uvmap {};
+            bool hasVertexColor = primitiveHasVertexColor(*inputPrim);
+            MaterialInstance* mi = createMaterialInstance(inputPrim->material, &uvmap,
+                    hasVertexColor, fAsset);
+            assert_invariant(mi);
+            if (!mi) {
+                mError = true;
+                continue;
+            }
 
-        // Expand the object-space bounding box.
-        aabb.min = min(outputPrim->aabb.min, aabb.min);
-        aabb.max = max(outputPrim->aabb.max, aabb.max);
+            fAsset->mDependencyGraph.addEdge(entity, mi);
+            builder.material(index, mi);
 
-        // We are not using the optional offset, minIndex, maxIndex, and count arguments when
-        // calling geometry() on the builder. It appears that the glTF spec does not have
-        // facilities for these parameters, which is not a huge loss since some of the buffer
-        // view and accessor features already have this functionality.
-        builder.geometry(index, primType, outputPrim->vertices, outputPrim->indices);
+            assert_invariant(outputPrim->vertices);
 
-        if (numMorphTargets) {
-            assert_invariant(outputPrim->targets);
-            builder.morphing(0, index, outputPrim->targets);
+            // Expand the object-space bounding box.
+            aabb.min = min(outputPrim->aabb.min, aabb.min);
+            aabb.max = max(outputPrim->aabb.max, aabb.max);
+
+            // We are not using the optional offset, minIndex, maxIndex, and count arguments when
+            // calling geometry() on the builder. It appears that the glTF spec does not have
+            // facilities for these parameters, which is not a huge loss since some of the buffer
+            // view and accessor features already have this functionality.
+            builder.geometry(index, primType, outputPrim->vertices, outputPrim->indices);
+
+            if (numMorphTargets) {
+                assert_invariant(outputPrim->targets);
+                builder.morphing(0, index, outputPrim->targets);
+            }
         }
     }
 
@@ -735,6 +1002,10 @@ void FAssetLoader::createRenderable(const cgltf_node* node, Entity entity, const
        builder.skinning(node->skin->joints_count);
     }
 
+    if (instanceBuffer) {
+        builder.instances(instanceBuffer->getInstanceCount(), instanceBuffer);
+    }
+
     // Per the spec, glTF models must have valid mix / max annotations for position attributes.
     // If desired, clients can call "recomputeBoundingBoxes()" in FilamentInstance.
     Box box = Box().set(aabb.min, aabb.max);
@@ -767,6 +1038,65 @@ void FAssetLoader::createRenderable(const cgltf_node* node, Entity entity, const
     }
 }
 
+// Creates a renderable for each group of nodes that share a mesh, which draws one GPU instance per
+// node. The nodes keep their transform components, so that they can still be animated or moved,
+// and their transforms are pushed to the InstanceBuffer by updateInstancedMeshes(). Each renderable
+// has the maximum number of automatic instances supported by the engine.
+void FAssetLoader::createInstancedMeshes(FFilamentAsset* fAsset, FFilamentInstance* instance) {
+    const cgltf_data* srcAsset = fAsset->mSourceAsset->hierarchy;
+    const size_t maxInstances = mEngine.getMaxAutomaticInstances();
+    const auto parent = mTransformManager.getInstance(instance->mRoot);
+    NodeManager& nm = mNodeManager;
+
+    for (const auto& [key, group] : mInstancingGroups) {
+        const cgltf_mesh* mesh = key.first;
+        const auto& nodes = group.nodes;
+        for (size_t first = 0, n = nodes.size(); first < n; first += maxInstances) {
+            const size_t count = std::min(maxInstances, n - first);
+            const char* name = getNodeName(nodes[first].first, mDefaultNodeName);
+            name = name ? name : "node";
+
+            // A lone node keeps its own renderable.
+            if (count == 1) {
+                createRenderable(nodes[first].first, nodes[first].second, name, fAsset);
+                if (srcAsset->variants_count > 0) {
+                    createMaterialVariants(mesh, nodes[first].second, fAsset, instance);
+                }
+                continue;
+            }
+
+            const Entity entity = mEntityManager.create();
+            nm.create(entity);
+            nm.setSceneMembership(nm.getInstance(entity), group.scenes);
+            mTransformManager.create(entity, parent);
+
+            InstanceBuffer* instanceBuffer = InstanceBuffer::Builder(count).build(mEngine);
+            fAsset->mInstanceBuffers.push_back(instanceBuffer);
+            createRenderable(nodes[first].first, entity, name, fAsset, instanceBuffer);
+            if (srcAsset->variants_count > 0) {
+                createMaterialVariants(mesh, entity, fAsset, instance);
+            }
+            fAsset->mEntities.push_back(entity);
+            instance->mEntities.push_back(entity);
+
+            FFilamentInstance::InstancedMesh& instancedMesh =
+                    instance->mInstancedMeshes.emplace_back();
+            instancedMesh.renderable = entity;
+            instancedMesh.instanceBuffer = instanceBuffer;
+            for (size_t i = first; i < first + count; ++i) {
+                instancedMesh.nodes.push_back(nodes[i].second);
+            }
+            for (const Primitive& prim : fAsset->mMeshCache[mesh - srcAsset->meshes]) {
+                instancedMesh.aabb.min = min(instancedMesh.aabb.min, prim.aabb.min);
+                instancedMesh.aabb.max = max(instancedMesh.aabb.max, prim.aabb.max);
+            }
+        }
+    }
+    mInstancingGroups.clear();
+
+    instance->updateInstancedMeshes();
+}
+
 void FAssetLoader::createMaterialVariants(const cgltf_mesh* mesh, Entity entity,
         FFilamentAsset* fAsset, FFilamentInstance* instance) {
     UvMap uvmap {};
@@ -789,67 +1119,54 @@ void FAssetLoader::createMaterialVariants(const cgltf_mesh* mesh, Entity entity,
     }
 }
 
-bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* name,
-        Primitive* outPrim, FFilamentAsset* fAsset) {
-    Material* material = getMaterial(fAsset->mSourceAsset->hierarchy,
-                inPrim.material, &outPrim->uvmap, primitiveHasVertexColor(inPrim));
-    AttributeBitset requiredAttributes = material->getRequiredAttributes();
+// Computes the layout of the Filament objects for a primitive. This only reads cgltf data and the
+// material requirements, so it can be called concurrently for different primitives.
+void FAssetLoader::planPrimitive(PrimitivePlan& plan, FFilamentAsset* fAsset) const {
+    const cgltf_primitive& inPrim = *plan.inPrim;
+    Primitive* outPrim = plan.outPrim;
+    const char* name = plan.name;
+    AttributeBitset const& requiredAttributes = plan.requiredAttributes;
 
     // TODO: populate a mapping of Texture Index => [MaterialInstance, const char*] slots.
-    // By creating this mapping during the "recursePrimitives" phase, we will can allow
+    // By creating this mapping during the "createPrimitives" phase, we will can allow
     // zero-instance assets to exist. This will be useful for "preloading", which is a feature
     // request from Google.
 
-    // Create a little lambda that appends to the asset's vertex buffer slots.
-    auto slots = &fAsset->mBufferSlots;
-    auto addBufferSlot = [slots](BufferSlot entry) {
-        slots->push_back(entry);
+    auto error = [&plan](const char* what) {
+        plan.messages.push_back({ true, std::string(what) + " in " + plan.name });
+        plan.valid = false;
     };
 
     // In glTF, each primitive may or may not have an index buffer.
-    IndexBuffer* indices = nullptr;
     const cgltf_accessor* accessor = inPrim.indices;
     if (accessor) {
         IndexBuffer::IndexType indexType;
         if (!getIndexType(accessor->component_type, &indexType)) {
-            utils::slog.e << "Unrecognized index type in " << name << utils::io::endl;
-            return false;
+            error("Unrecognized index type");
+            return;
         }
-
-        indices = IndexBuffer::Builder()
-            .indexCount(accessor->count)
-            .bufferType(indexType)
-            .build(mEngine);
-
-        BufferSlot slot = { accessor };
-        slot.indexBuffer = indices;
-        addBufferSlot(slot);
+        plan.hasIndices = true;
+        plan.ibb.indexCount(accessor->count).bufferType(indexType);
     } else if (inPrim.attributes_count > 0) {
         // If a primitive does not have an index buffer, generate a trivial one now.
         const uint32_t vertexCount = inPrim.attributes[0].data->count;
-
-        indices = IndexBuffer::Builder()
-            .indexCount(vertexCount)
-            .bufferType(IndexBuffer::IndexType::UINT)
-            .build(mEngine);
+        plan.hasIndices = true;
+        plan.ibb.indexCount(vertexCount).bufferType(IndexBuffer::IndexType::UINT);
 
         const size_t indexDataSize = vertexCount * sizeof(uint32_t);
         uint32_t* indexData = (uint32_t*) malloc(indexDataSize);
         for (size_t i = 0; i < vertexCount; ++i) {
             indexData[i] = i;
         }
-        IndexBuffer::BufferDescriptor bd(indexData, indexDataSize, FREE_CALLBACK);
-        indices->setBuffer(mEngine, std::move(bd));
+        plan.generatedIndices = IndexBuffer::BufferDescriptor(indexData, indexDataSize,
+                FREE_CALLBACK);
     }
-    fAsset->mIndexBuffers.push_back(indices);
 
-    VertexBuffer::Builder vbb;
+    VertexBuffer::Builder& vbb = plan.vbb;
     vbb.enableBufferObjects();
 
     bool hasUv0 = false, hasUv1 = false, hasVertexColor = false, hasNormals = false;
     uint32_t vertexCount = 0;
-
-    const size_t firstSlot = fAsset->mBufferSlots.size();
     int slot = 0;
 
     for (cgltf_size aindex = 0; aindex < inPrim.attributes_count; aindex++) {
@@ -869,7 +1186,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
             vbb.attribute(VertexAttribute::TANGENTS, slot, VertexBuffer::AttributeType::SHORT4);
             vbb.normalized(VertexAttribute::TANGENTS);
             hasNormals = true;
-            addBufferSlot({&fAsset->mGenerateTangents, atype, slot++});
+            plan.vertexSlots.push_back({&fAsset->mGenerateTangents, atype, slot++});
             continue;
         }
 
@@ -880,20 +1197,21 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
         // Translate the cgltf attribute enum into a Filament enum.
         VertexAttribute semantic;
         if (!getVertexAttrType(atype, &semantic)) {
-            utils::slog.e << "Unrecognized vertex semantic in " << name << utils::io::endl;
-            return false;
+            error("Unrecognized vertex semantic");
+            return;
         }
         if (atype == cgltf_attribute_type_weights && index > 0) {
-            utils::slog.e << "Too many bone weights in " << name << utils::io::endl;
+            plan.messages.push_back({ true, std::string("Too many bone weights in ") + name });
             continue;
         }
         if (atype == cgltf_attribute_type_joints && index > 0) {
-            utils::slog.e << "Too many joints in " << name << utils::io::endl;
+            plan.messages.push_back({ true, std::string("Too many joints in ") + name });
             continue;
         }
         if (atype == cgltf_attribute_type_texcoord) {
             if (index >= UvMapSize) {
-                utils::slog.e << "Too many texture coordinate sets in " << name << utils::io::endl;
+                plan.messages.push_back({ true,
+                        std::string("Too many texture coordinate sets in ") + name });
                 continue;
             }
             UvSet uvset = outPrim->uvmap[index];
@@ -937,8 +1255,8 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
         VertexBuffer::AttributeType fatype;
         VertexBuffer::AttributeType actualType;
         if (!getElementType(accessor->type, accessor->component_type, &fatype, &actualType)) {
-            slog.e << "Unsupported accessor type in " << name << io::endl;
-            return false;
+            error("Unsupported accessor type");
+            return;
         }
         const int stride = (fatype == actualType) ? accessor->stride : 0;
 
@@ -947,7 +1265,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
         // As a convenience, cgltf also replaces zero (default) stride with the actual stride.
         vbb.attribute(semantic, slot, fatype, 0, stride);
         vbb.normalized(semantic, accessor->normalized);
-        addBufferSlot({accessor, atype, slot++});
+        plan.vertexSlots.push_back({accessor, atype, slot++});
     }
 
     // If the model is lit but does not have normals, we'll need to generate flat normals.
@@ -955,14 +1273,14 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
         vbb.attribute(VertexAttribute::TANGENTS, slot, VertexBuffer::AttributeType::SHORT4);
         vbb.normalized(VertexAttribute::TANGENTS);
         cgltf_attribute_type atype = cgltf_attribute_type_normal;
-        addBufferSlot({&fAsset->mGenerateNormals, atype, slot++});
+        plan.vertexSlots.push_back({&fAsset->mGenerateNormals, atype, slot++});
     }
 
     cgltf_size targetsCount = inPrim.targets_count;
 
     if (targetsCount > MAX_MORPH_TARGETS) {
-        utils::slog.w << "WARNING: Exceeded max morph target count of "
-                << MAX_MORPH_TARGETS << utils::io::endl;
+        plan.messages.push_back({ false, "WARNING: Exceeded max morph target count of " +
+                std::to_string(MAX_MORPH_TARGETS) });
         targetsCount = MAX_MORPH_TARGETS;
     }
 
@@ -980,9 +1298,10 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
             }
 
             if (atype != cgltf_attribute_type_position) {
-                utils::slog.e << "Only positions, normals, and tangents can be morphed."
-                        << utils::io::endl;
-                return false;
+                plan.messages.push_back({ true,
+                        "Only positions, normals, and tangents can be morphed." });
+                plan.valid = false;
+                return;
             }
 
             if (!accessor->has_min || !accessor->has_max) {
@@ -1003,15 +1322,15 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
             VertexBuffer::AttributeType fatype;
             VertexBuffer::AttributeType actualType;
             if (!getElementType(accessor->type, accessor->component_type, &fatype, &actualType)) {
-                slog.e << "Unsupported accessor type in " << name << io::endl;
-                return false;
+                error("Unsupported accessor type");
+                return;
             }
         }
     }
 
     if (vertexCount == 0) {
-        slog.e << "Empty vertex buffer in " << name << io::endl;
-        return false;
+        error("Empty vertex buffer");
+        return;
     }
 
     vbb.vertexCount(vertexCount);
@@ -1046,29 +1365,69 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
         needsDummyData = true;
         vbb.attribute(VertexAttribute::UV0, slot, VertexBuffer::AttributeType::USHORT2);
         vbb.normalized(VertexAttribute::UV0);
-        slog.w << "Missing UV0 data in " << name << io::endl;
+        plan.messages.push_back({ false, std::string("Missing UV0 data in ") + name });
     }
 
     if (!hasUv1 && numUvSets > 1) {
         needsDummyData = true;
         vbb.attribute(VertexAttribute::UV1, slot, VertexBuffer::AttributeType::USHORT2);
         vbb.normalized(VertexAttribute::UV1);
-        slog.w << "Missing UV1 data in " << name << io::endl;
+        plan.messages.push_back({ false, std::string("Missing UV1 data in ") + name });
     }
 
     vbb.bufferCount(needsDummyData ? slot + 1 : slot);
 
-    VertexBuffer* vertices = vbb.build(mEngine);
+    plan.vertexCount = vertexCount;
+    plan.targetsCount = targetsCount;
+    plan.needsDummyData = needsDummyData;
+    plan.dummySlot = slot;
+}
+
+// Creates the Filament objects for a planned primitive and registers their buffer slots. This
+// must be called serially, in the same order as the primitives were planned.
+bool FAssetLoader::buildPrimitive(PrimitivePlan& plan, FFilamentAsset* fAsset) {
+    for (auto const& [isError, message] : plan.messages) {
+        if (isError) {
+            slog.e << message.c_str() << io::endl;
+        } else {
+            slog.w << message.c_str() << io::endl;
+        }
+    }
+    if (!plan.valid) {
+        return false;
+    }
+
+    const cgltf_primitive& inPrim = *plan.inPrim;
+    Primitive* outPrim = plan.outPrim;
+    auto& slots = fAsset->mBufferSlots;
+
+    IndexBuffer* indices = nullptr;
+    if (plan.hasIndices) {
+        indices = plan.ibb.build(mEngine);
+        if (inPrim.indices) {
+            BufferSlot slot = { inPrim.indices };
+            slot.indexBuffer = indices;
+            slots.push_back(slot);
+        } else {
+            indices->setBuffer(mEngine, std::move(plan.generatedIndices));
+        }
+    }
+    fAsset->mIndexBuffers.push_back(indices);
+
+    VertexBuffer* vertices = plan.vbb.build(mEngine);
 
     outPrim->indices = indices;
     outPrim->vertices = vertices;
     fAsset->mPrimitives.push_back({&inPrim, vertices});
     fAsset->mVertexBuffers.push_back(vertices);
 
-    for (size_t i = firstSlot; i < fAsset->mBufferSlots.size(); ++i) {
-        fAsset->mBufferSlots[i].vertexBuffer = vertices;
+    for (BufferSlot slot : plan.vertexSlots) {
+        slot.vertexBuffer = vertices;
+        slots.push_back(slot);
     }
 
+    const uint32_t vertexCount = plan.vertexCount;
+    const cgltf_size targetsCount = plan.targetsCount;
     if (targetsCount > 0) {
         MorphTargetBuffer* targets = MorphTargetBuffer::Builder()
                 .vertexCount(vertexCount)
@@ -1090,14 +1449,14 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
                     BufferSlot slot = { accessor };
                     slot.morphTargetBuffer = targets;
                     slot.bufferIndex = tindex;
-                    addBufferSlot(slot);
+                    slots.push_back(slot);
                     break;
                 }
             }
         }
     }
 
-    if (needsDummyData) {
+    if (plan.needsDummyData) {
         const uint32_t requiredSize = sizeof(ubyte4) * vertexCount;
         if (mDummyBufferObject == nullptr || requiredSize > mDummyBufferObject->getByteCount()) {
             mDummyBufferObject = BufferObject::Builder().size(requiredSize).build(mEngine);
@@ -1107,7 +1466,7 @@ bool FAssetLoader::createPrimitive(const cgltf_primitive& inPrim, const char* na
             VertexBuffer::BufferDescriptor bd(dummyData, requiredSize, FREE_CALLBACK);
             mDummyBufferObject->setBuffer(mEngine, std::move(bd));
         }
-        vertices->setBufferObjectAt(mEngine, slot, mDummyBufferObject);
+        vertices->setBufferObjectAt(mEngine, plan.dummySlot, mDummyBufferObject);
     }
 
     return true;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BakedCache.h"
+
+#include "FFilamentAsset.h"
+
+#include <utils/Hash.h>
+
+#include <string.h>
+
+using namespace utils;
+
+namespace filament::gltfio {
+
+static size_t padded(size_t size) noexcept {
+    return (size + BAKED_CACHE_ALIGNMENT - 1) & ~(BAKED_CACHE_ALIGNMENT - 1);
+}
+
+uint64_t computeBakedCacheKey(FFilamentAsset const* asset, bool normalizeSkinningWeights) {
+    const cgltf_data* gltf = asset->mSourceAsset->hierarchy;
+    uint64_t key = hash::murmurSlow((const uint8_t*) gltf->json, gltf->json_size, 0);
+    key = (key << 32u) | BAKED_CACHE_VERSION;
+    size_t seed = normalizeSkinningWeights;
+    for (const BufferSlot& slot : asset->mBufferSlots) {
+        const int64_t accessor =
+                slot.accessor == &asset->mGenerateTangents ? -1 :
+                slot.accessor == &asset->mGenerateNormals ? -2 :
+                slot.accessor - gltf->accessors;
+        const uint32_t kind = slot.vertexBuffer ? 0 : slot.indexBuffer ? 1 : 2;
+        hash::combine_fast(seed, accessor);
+        hash::combine_fast(seed, kind);
+        hash::combine_fast(seed, slot.bufferIndex);
+    }
+    return key ^ uint64_t(seed);
+}
+
+BakedCacheWriter::BakedCacheWriter(uint64_t key) {
+    const BakedCacheHeader header{
+            .magic = BAKED_CACHE_MAGIC,
+            .version = BAKED_CACHE_VERSION,
+            .key = key,
+    };
+    mData.resize(sizeof(header));
+    memcpy(mData.data(), &header, sizeof(header));
+}
+
+void BakedCacheWriter::add(BakedRecordType type, uint32_t count, const void* data, size_t size) {
+    const BakedRecord record{ .type = type, .count = count, .size = size };
+    const size_t offset = mData.size();
+    mData.resize(offset + sizeof(record) + padded(size));
+    memcpy(mData.data() + offset, &record, sizeof(record));
+    memcpy(mData.data() + offset + sizeof(record), data, size);
+    mRecordCount++;
+}
+
+std::vector<uint8_t> BakedCacheWriter::finish() {
+    BakedCacheHeader header;
+    memcpy(&header, mData.data(), sizeof(header));
+    header.recordCount = mRecordCount;
+    header.size = mData.size();
+    memcpy(mData.data(), &header, sizeof(header));
+    return std::move(mData);
+}
+
+bool BakedCacheReader::init(const uint8_t* data, size_t size, uint64_t key) noexcept {
+    if (size < sizeof(BakedCacheHeader) || uintptr_t(data) % BAKED_CACHE_ALIGNMENT) {
+        return false;
+    }
+    BakedCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != BAKED_CACHE_MAGIC || header.version != BAKED_CACHE_VERSION ||
+            header.key != key || header.size != size) {
+        return false;
+    }
+
+    // Check the bounds of every record upfront, so that a truncated cache is rejected before
+    // anything gets uploaded.
+    const uint8_t* const end = data + size;
+    const uint8_t* cursor = data + sizeof(header);
+    for (uint32_t i = 0; i < header.recordCount; i++) {
+        BakedRecord record;
+        if (size_t(end - cursor) < sizeof(record)) {
+            return false;
+        }
+        memcpy(&record, cursor, sizeof(record));
+        cursor += sizeof(record);
+        const size_t available = end - cursor;
+        if (record.size > available || padded(record.size) > available) {
+            return false;
+        }
+        cursor += padded(record.size);
+    }
+
+    mCursor = data + sizeof(header);
+    mEnd = end;
+    mRecordCount = header.recordCount;
+    return true;
+}
+
+const uint8_t* BakedCacheReader::next(BakedRecordType type, BakedRecord* outRecord) noexcept {
+    if (size_t(mEnd - mCursor) < sizeof(BakedRecord)) {
+        return nullptr;
+    }
+    BakedRecord record;
+    memcpy(&record, mCursor, sizeof(record));
+    if (record.type != type) {
+        return nullptr;
+    }
+    const uint8_t* payload = mCursor + sizeof(record);
+    mCursor = payload + padded(record.size);
+    *outRecord = record;
+    return payload;
+}
+
+} // namespace filament::gltfio
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GLTFIO_BAKED_CACHE_H
+#define GLTFIO_BAKED_CACHE_H
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament::gltfio {
+
+struct FFilamentAsset;
+
+// A baked cache holds the final form of the data that ResourceLoader uploads for an asset, i.e.
+// after Draco / meshopt decoding, type conversion, morph target packing and tangent generation.
+// Records are stored in upload order, so the cache can only be replayed against an asset that has
+// the same layout, which is enforced by the key (see computeBakedCacheKey).
+//
+// Layout (native endianness):
+//     BakedCacheHeader
+//     recordCount times:
+//         BakedRecord
+//         uint8_t data[size], padded to BAKED_CACHE_ALIGNMENT
+//
+// Payloads are aligned so that they can be handed to the GPU directly from the cache, which is
+// typically memory-mapped.
+
+static constexpr uint64_t BAKED_CACHE_MAGIC = 0x454B41424654'4C47ull; // "GLTFBAKE"
+static constexpr uint32_t BAKED_CACHE_VERSION = 1;
+static constexpr size_t BAKED_CACHE_ALIGNMENT = 8;
+
+enum class BakedRecordType : uint32_t {
+    INVERSE_BIND_MATRICES,  // mat4f per joint, for each skin
+    VERTEX,                 // content of a vertex buffer slot
+    INDEX,                  // content of an index buffer, 16 or 32 bits per index
+    MORPH_POSITIONS,        // float3 or float4 per vertex, for each morph target
+    VERTEX_TANGENTS,        // short4 per vertex, for each vertex buffer that needs tangents
+    MORPH_TANGENTS,         // short4 per vertex, for each morph target that needs tangents
+};
+
+struct BakedCacheHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t recordCount;
+    uint64_t key;
+    uint64_t size;
+};
+
+struct BakedRecord {
+    BakedRecordType type;
+    uint32_t count;         // number of elements, if not implied by the type
+    uint64_t size;          // size of the payload in bytes, without padding
+};
+
+// Computes the key of an asset from its glTF JSON and the layout of its buffer slots, which
+// depends on the MaterialProvider. The content of the binary resources is not part of the key.
+uint64_t computeBakedCacheKey(FFilamentAsset const* asset, bool normalizeSkinningWeights);
+
+class BakedCacheWriter {
+public:
+    explicit BakedCacheWriter(uint64_t key);
+
+    void add(BakedRecordType type, uint32_t count, const void* data, size_t size);
+
+    // Finalizes the header and returns the blob.
+    std::vector<uint8_t> finish();
+
+private:
+    std::vector<uint8_t> mData;
+    uint32_t mRecordCount = 0;
+};
+
+class BakedCacheReader {
+public:
+    // Validates the header and the bounds of every record. Returns false if the blob is malformed,
+    // misaligned, or was baked for a different asset.
+    bool init(const uint8_t* data, size_t size, uint64_t key) noexcept;
+
+    uint32_t getRecordCount() const noexcept { return mRecordCount; }
+
+    // Returns the payload of the next record, or null if it is not of the expected type.
+    const uint8_t* next(BakedRecordType type, BakedRecord* outRecord) noexcept;
+
+private:
+    const uint8_t* mCursor = nullptr;
+    const uint8_t* mEnd = nullptr;
+    uint32_t mRecordCount = 0;
+};
+
+} // namespace filament::gltfio
+
+#endif // GLTFIO_BAKED_CACHE_H
@@ -22,6 +22,7 @@
 #include <tsl/robin_map.h>
 
 #include <memory>
+#include <mutex>
 
 #ifndef GLTFIO_DRACO_SUPPORTED
 #define GLTFIO_DRACO_SUPPORTED 0
@@ -35,11 +36,20 @@ class DracoMesh;
 //
 // The cache key is the buffer view that holds the compressed data. This allows the loader to
 // avoid duplicated work when a single Draco mesh is referenced from multiple primitives.
+//
+// The cache can be used from several threads. Distinct meshes are decoded concurrently, while
+// threads that look up a mesh that is being decoded wait for it. The returned DracoMesh itself is
+// not thread-safe, so the loader converts all the primitives of a given mesh from a single job.
 class DracoCache {
 public:
     DracoMesh* findOrCreateMesh(const cgltf_buffer_view* key);
 private:
-    tsl::robin_map<const cgltf_buffer_view*, std::unique_ptr<DracoMesh>> mCache;
+    struct Entry {
+        std::once_flag decoded;
+        std::unique_ptr<DracoMesh> mesh;
+    };
+    std::mutex mMutex;
+    tsl::robin_map<const cgltf_buffer_view*, std::unique_ptr<Entry>> mCache;
 };
 
 // Decodes a Draco mesh upon construction and retains the results.
@@ -23,6 +23,7 @@
 
 #include <filament/Engine.h>
 #include <filament/IndexBuffer.h>
+#include <filament/InstanceBuffer.h>
 #include <filament/MaterialInstance.h>
 #include <filament/RenderableManager.h>
 #include <filament/Texture.h>
@@ -48,6 +49,7 @@
 
 #include <tsl/htrie_map.h>
 
+#include <memory>
 #include <vector>
 
 #ifdef NDEBUG
@@ -256,6 +258,7 @@ struct FFilamentAsset : public FilamentAsset {
     std::vector<BufferObject*> mBufferObjects;
     std::vector<IndexBuffer*> mIndexBuffers;
     std::vector<MorphTargetBuffer*> mMorphTargetBuffers;
+    std::vector<InstanceBuffer*> mInstanceBuffers;
     utils::FixedCapacityVector<Skin> mSkins;
     utils::FixedCapacityVector<utils::CString> mScenes;
     Aabb mBoundingBox;
@@ -266,6 +269,10 @@ struct FFilamentAsset : public FilamentAsset {
     // Indicates if resource decoding has started (not necessarily finished)
     bool mResourcesLoaded = false;
 
+    // ResourceLoader keeps a weak reference to this, which expires when the asset is destroyed
+    // during an asynchronous load.
+    std::shared_ptr<bool> mLifetime = std::make_shared<bool>(true);
+
     DependencyGraph mDependencyGraph;
     tsl::htrie_map<char, std::vector<utils::Entity>> mNameToEntity;
     utils::CString mAssetExtras;
@@ -313,6 +320,14 @@ struct FFilamentAsset : public FilamentAsset {
     // The mapping from cgltf_mesh to VertexBuffer* (etc) is required when creating new instances.
     MeshCache mMeshCache;
 
+    // Levels of detail of the nodes that have the MSFT_lod extension. The first mesh is the mesh of
+    // the node itself, and the lower levels of detail may have no mesh.
+    struct LevelsOfDetail {
+        utils::FixedCapacityVector<const cgltf_mesh*> meshes;
+        utils::FixedCapacityVector<float> screenSizes;
+    };
+    tsl::robin_map<const cgltf_node*, LevelsOfDetail> mLevelsOfDetail;
+
     // Asset information that is produced by AssetLoader and consumed by ResourceLoader:
     std::vector<BufferSlot> mBufferSlots;
     std::vector<std::pair<const cgltf_primitive*, VertexBuffer*> > mPrimitives;
@@ -25,6 +25,7 @@
 
 #include <math/mat4.h>
 
+#include <tsl/robin_map.h>
 #include <tsl/robin_set.h>
 
 #include <vector>
@@ -34,6 +35,7 @@
 struct cgltf_node;
 
 namespace filament {
+    class InstanceBuffer;
     class MaterialInstance;
 }
 
@@ -79,6 +81,18 @@ struct FFilamentInstance : public FilamentInstance {
 
     const char* getMaterialVariantName(size_t variantIndex) const noexcept;
 
+    struct BoneRange {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    // The bones of a skin as computed for one of its targets.
+    struct SkinTarget {
+        math::mat4 worldTransform;
+        std::vector<math::mat4f> boneMatrices;
+        std::vector<BoneRange> dirtyRanges;     // ranges of boneMatrices not yet uploaded
+    };
+
     // The per-instance skin structure caches information to allow animation to be applied
     // efficiently at run time. Note that shared immutable data, such as the skin name and inverse
     // bind transforms, are stored in FFilamentAsset.
@@ -89,6 +103,28 @@ struct FFilamentInstance : public FilamentInstance {
         // The set of all entities that are influenced by this skin.
         // This is initially derived from the glTF, but users can dynamically add or remove targets.
         tsl::robin_set<utils::Entity, utils::Entity::Hasher> targets;
+
+        // State of the last bone update, which lets Animator recompute and upload only the bones
+        // whose joint (or target) has moved since. Empty until the first update.
+        std::vector<math::mat4> jointTransforms;
+        std::vector<bool> dirtyJoints;
+        tsl::robin_map<utils::Entity, SkinTarget, utils::Entity::Hasher> targetCache;
+    };
+
+    // A renderable that draws the mesh shared by several nodes, with one GPU instance per node.
+    // See AssetConfiguration::automaticInstancing.
+    struct InstancedMesh {
+        utils::Entity renderable;
+        InstanceBuffer* instanceBuffer;
+        std::vector<utils::Entity> nodes;
+        std::vector<math::mat4f> localTransforms;  // relative to the renderable, one per node
+        Aabb aabb;                                  // object-space bounding box of the mesh
+
+        // World transforms seen by the last update, so that only the nodes that moved since are
+        // recomputed. Empty until the first update.
+        std::vector<math::mat4> worldTransforms;
+        math::mat4 parentTransform;
+        math::mat4 inverseParentTransform;
     };
 
     const utils::Entity mRoot;
@@ -98,6 +134,7 @@ struct FFilamentInstance : public FilamentInstance {
     utils::FixedCapacityVector<Variant> mVariants;
     Animator* mAnimator = nullptr;
     utils::FixedCapacityVector<Skin> mSkins;
+    std::vector<InstancedMesh> mInstancedMeshes;
 
     // Note that nodeMap is yet another a vector of entities, but unlike the "entities" field, it
     // may be sparsely populated. This is used as a simple mapping between cgltf_node and Entity,
@@ -120,6 +157,7 @@ struct FFilamentInstance : public FilamentInstance {
     math::mat4f const* getInverseBindMatricesAt(size_t skinIndex) const;
 
     void recomputeBoundingBoxes();
+    void updateInstancedMeshes();
 };
 
 FILAMENT_DOWNCAST(FilamentInstance)
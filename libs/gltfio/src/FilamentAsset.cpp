@@ -93,6 +93,9 @@ FFilamentAsset::~FFilamentAsset() {
     for (auto tb : mMorphTargetBuffers) {
         mEngine->destroy(tb);
     }
+    for (auto ib : mInstanceBuffers) {
+        mEngine->destroy(ib);
+    }
 }
 
 const char* FFilamentAsset::getExtras(utils::Entity entity) const noexcept {
@@ -88,6 +88,7 @@ void FFilamentInstance::detachSkin(size_t skinIndex, Entity target) noexcept {
         return;
     }
     mSkins[skinIndex].targets.erase(target);
+    mSkins[skinIndex].targetCache.erase(target);
 }
 
 mat4f const* FFilamentInstance::getInverseBindMatricesAt(size_t skinIndex) const {
@@ -306,7 +307,17 @@ void FFilamentInstance::recomputeBoundingBoxes() {
                 aabb.max = max(aabb.max, primBounds.max);
             }
             auto renderable = rm.getInstance(entity);
-            rm.setAxisAlignedBoundingBox(renderable, Box().set(aabb.min, aabb.max));
+            if (renderable) {
+                rm.setAxisAlignedBoundingBox(renderable, Box().set(aabb.min, aabb.max));
+            } else {
+                // The node is drawn as a GPU instance, all of which share the same mesh.
+                for (InstancedMesh& instancedMesh : mInstancedMeshes) {
+                    if (instancedMesh.nodes.front() == entity) {
+                        instancedMesh.aabb = aabb;
+                        instancedMesh.worldTransforms.clear();
+                    }
+                }
+            }
 
             // Transform this bounding box, then update the asset-level bounding box.
             auto transformable = tm.getInstance(entity);
@@ -323,6 +334,64 @@ void FFilamentInstance::recomputeBoundingBoxes() {
     }
 
     mBoundingBox = assetBounds;
+
+    updateInstancedMeshes();
+}
+
+void FFilamentInstance::updateInstancedMeshes() {
+    if (mInstancedMeshes.empty()) {
+        return;
+    }
+    TransformManager& tm = mOwner->mEngine->getTransformManager();
+    RenderableManager& rm = mOwner->mEngine->getRenderableManager();
+    for (InstancedMesh& mesh : mInstancedMeshes) {
+        const size_t count = mesh.nodes.size();
+
+        // The transform of each GPU instance is relative to the renderable, which is a child of
+        // the instance root. When the renderable moves, every instance must be recomputed.
+        const mat4 parent = tm.getWorldTransformAccurate(tm.getInstance(mesh.renderable));
+        const bool moved = mesh.worldTransforms.size() != count || parent != mesh.parentTransform;
+        if (moved) {
+            mesh.worldTransforms.clear();
+            mesh.worldTransforms.resize(count);
+            mesh.localTransforms.resize(count);
+            mesh.parentTransform = parent;
+            mesh.inverseParentTransform = inverse(parent);
+        }
+
+        // Otherwise, only the nodes that moved since the last update are recomputed.
+        bool dirty = moved;
+        for (size_t i = 0; i < count; ++i) {
+            const mat4 world = tm.getWorldTransformAccurate(tm.getInstance(mesh.nodes[i]));
+            if (!moved && world == mesh.worldTransforms[i]) {
+                continue;
+            }
+            mesh.worldTransforms[i] = world;
+            const mat4f local{ mesh.inverseParentTransform * world };
+            if (local != mesh.localTransforms[i]) {
+                mesh.localTransforms[i] = local;
+                dirty = true;
+            }
+        }
+        if (!dirty) {
+            continue;
+        }
+
+        // All instances are culled together, so the bounding box of the renderable must enclose
+        // every one of them.
+        mesh.instanceBuffer->setLocalTransforms(mesh.localTransforms.data(), count);
+        if (mesh.aabb.isEmpty()) {
+            continue;
+        }
+        Aabb bounds;
+        for (const mat4f& local : mesh.localTransforms) {
+            const Aabb transformed = mesh.aabb.transform(local);
+            bounds.min = min(bounds.min, transformed.min);
+            bounds.max = max(bounds.max, transformed.max);
+        }
+        rm.setAxisAlignedBoundingBox(rm.getInstance(mesh.renderable),
+                Box().set(bounds.min, bounds.max));
+    }
 }
 
 size_t FFilamentInstance::getMaterialVariantCount() const noexcept {
@@ -429,6 +498,10 @@ void FilamentInstance::recomputeBoundingBoxes() {
     return downcast(this)->recomputeBoundingBoxes();
 }
 
+void FilamentInstance::updateInstancedMeshes() {
+    downcast(this)->updateInstancedMeshes();
+}
+
 Aabb FilamentInstance::getBoundingBox() const noexcept {
     return downcast(this)->mBoundingBox;
 }
@@ -232,6 +232,8 @@ void Ktx2Provider::transcodeSingleTexture() {
 
 Ktx2Provider::Ktx2Provider(Engine* engine) : mEngine(engine) {
     mDecoderRootJob = mEngine->getJobSystem().createJob();
+    // decoding is done in the background, it shouldn't delay the jobs of a frame
+    mEngine->getJobSystem().setPriority(mDecoderRootJob, JobSystem::JobPriority::BACKGROUND);
 #ifdef NDEBUG
     const bool quiet = true;
 #else
@@ -17,6 +17,7 @@
 #include <gltfio/ResourceLoader.h>
 #include <gltfio/TextureProvider.h>
 
+#include "BakedCache.h"
 #include "GltfEnums.h"
 #include "FFilamentAsset.h"
 #include "TangentsJob.h"
@@ -29,6 +30,7 @@
 #include <filament/Texture.h>
 #include <filament/VertexBuffer.h>
 #include <filament/MorphTargetBuffer.h>
+#include <filament/RenderableManager.h>
 
 #include <geometry/Transcoder.h>
 
@@ -47,9 +49,12 @@
 
 #include <tsl/robin_map.h>
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 using namespace filament;
 using namespace filament::math;
@@ -66,6 +71,7 @@ using FilepathTextureCache = tsl::robin_map<std::string, Texture*>;
 using UriDataCache = tsl::robin_map<std::string, gltfio::ResourceLoader::BufferDescriptor>;
 using UriDataCacheHandle = std::shared_ptr<UriDataCache>;
 using TextureProviderList = tsl::robin_map<std::string, TextureProvider*>;
+using BakedCacheHandle = std::shared_ptr<gltfio::ResourceLoader::BufferDescriptor>;
 
 enum class CacheResult {
     ERROR,
@@ -97,11 +103,36 @@ struct ResourceLoader::Impl {
     FilepathTextureCache mFilepathTextureCache;
 
     FFilamentAsset* mAsyncAsset = nullptr;
+    std::weak_ptr<bool> mAsyncAssetLifetime;
     size_t mRemainingTextureDownloads = 0;
 
+    // Texture streaming state, used only by asynchronous loads with a decode budget. Pending
+    // textures are sorted by increasing priority, so that the next one to decode is at the back.
+    size_t mDecodeBudget = 0;
+    std::vector<size_t> mPendingTextures;
+    tsl::robin_map<Texture*, size_t> mDecodingTextures;
+    size_t mDecodingBytes = 0;
+    tsl::robin_map<Entity, float, Entity::Hasher> mScreenCoverage;
+    bool mPrioritiesDirty = false;
+
+    // Baked cache supplied with setBakedCache() for the next load, and the one recorded during the
+    // last load when recording is enabled.
+    BakedCacheHandle mBakedCache;
+    std::vector<uint8_t> mRecordedBakedCache;
+    bool mRecordBakedCache = false;
+    bool mBakedCacheUsed = false;
+
     void addResourceData(const char* uri, BufferDescriptor&& buffer);
-    void computeTangents(FFilamentAsset* asset);
+    std::vector<TangentsJob::Params> collectTangentsJobs(FFilamentAsset* asset);
+    void computeTangents(FFilamentAsset* asset, std::vector<TangentsJob::Params>& jobParams,
+            BakedCacheWriter* recorder);
+    bool uploadBakedCache(FFilamentAsset* asset, BakedCacheReader& reader,
+            BakedCacheHandle const& cache, std::vector<TangentsJob::Params> const& jobParams);
     void createTextures(FFilamentAsset* asset, bool async);
+    void createTexture(FFilamentAsset* asset, size_t textureIndex, bool streaming);
+    void streamTextures(FFilamentAsset* asset);
+    void sortPendingTextures(FFilamentAsset* asset);
+    FFilamentAsset* getAsyncAsset();
     void cancelTextureDecoding();
     std::pair<Texture*, CacheResult> getOrCreateTexture(FFilamentAsset* asset, size_t textureIndex,
             TextureProvider::TextureFlags flags);
@@ -116,10 +147,15 @@ uint32_t computeBindingOffset(const cgltf_accessor* accessor);
 struct UploadEvent {
     FFilamentAsset::SourceHandle handle;
     UriDataCacheHandle dataCacheHandle;
+    BakedCacheHandle bakedCacheHandle;
 };
 
 UploadEvent* uploadUserdata(FFilamentAsset* asset, UriDataCacheHandle dataCache) {
-    return new UploadEvent({ asset->mSourceAsset, dataCache });
+    return new UploadEvent({ asset->mSourceAsset, dataCache, {} });
+}
+
+UploadEvent* uploadUserdata(BakedCacheHandle bakedCache) {
+    return new UploadEvent({ {}, {}, bakedCache });
 }
 
 static void uploadCallback(void* buffer, size_t size, void* user) {
@@ -166,8 +202,85 @@ static bool requiresPacking(const cgltf_accessor* accessor) {
     }
 }
 
-static void decodeDracoMeshes(FFilamentAsset* asset) {
-    DracoCache* dracoCache = &asset->mSourceAsset->dracoCache;
+// Decodes Draco meshes and meshopt buffer views on the JobSystem, with one job per compressed
+// buffer view. The jobs are retained so that the loader can upload each buffer as soon as the data
+// it reads has been decoded, rather than after every buffer has been decoded.
+class CompressionDecoder {
+public:
+    CompressionDecoder(JobSystem& js, FFilamentAsset* asset) : mJobSystem(js), mAsset(asset) {}
+    ~CompressionDecoder() { finish(); }
+
+    void decodeDracoMeshes();
+    void decodeMeshoptCompression();
+
+    // Waits for the jobs that produce the data read by the given accessor, if any.
+    void wait(const cgltf_accessor* accessor);
+
+    // Waits for all jobs, and detaches the primitives that could not be decoded.
+    void finish();
+
+private:
+    struct DracoJob {
+        const cgltf_buffer_view* bufferView;
+        std::vector<size_t> primitives;
+    };
+
+    void decodeDracoJob(DracoJob const& job);
+    static void decodeMeshopt(cgltf_buffer_view* bufferView);
+    void waitBufferView(const cgltf_buffer_view* bufferView);
+    void waitJob(size_t index);
+
+    JobSystem& mJobSystem;
+    FFilamentAsset* const mAsset;
+    std::vector<JobSystem::Job*> mJobs;
+    std::vector<DracoJob> mDracoJobs;
+    std::vector<uint8_t> mDracoFailures;
+    tsl::robin_map<const cgltf_accessor*, size_t> mDracoAccessors;
+    tsl::robin_map<const cgltf_buffer_view*, size_t> mMeshoptBufferViews;
+};
+
+void CompressionDecoder::decodeDracoMeshes() {
+    // Group the primitives by Draco mesh, so that each mesh is decoded and converted by a single
+    // job, even when several primitives share it.
+    tsl::robin_map<const cgltf_buffer_view*, size_t> jobIndices;
+    for (size_t i = 0, n = mAsset->mPrimitives.size(); i < n; ++i) {
+        const cgltf_primitive* prim = mAsset->mPrimitives[i].first;
+        if (!prim->has_draco_mesh_compression) {
+            continue;
+        }
+        const cgltf_buffer_view* bufferView = prim->draco_mesh_compression.buffer_view;
+        auto [iter, inserted] = jobIndices.try_emplace(bufferView, mDracoJobs.size());
+        if (inserted) {
+            mDracoJobs.push_back({ bufferView, {} });
+        }
+        mDracoJobs[iter->second].primitives.push_back(i);
+    }
+    if (mDracoJobs.empty()) {
+        return;
+    }
+    mDracoFailures.resize(mAsset->mPrimitives.size(), false);
+
+    for (DracoJob const& dracoJob : mDracoJobs) {
+        const size_t jobIndex = mJobs.size();
+        for (size_t i : dracoJob.primitives) {
+            const cgltf_primitive* prim = mAsset->mPrimitives[i].first;
+            if (prim->indices) {
+                mDracoAccessors[prim->indices] = jobIndex;
+            }
+            for (cgltf_size j = 0; j < prim->attributes_count; j++) {
+                mDracoAccessors[prim->attributes[j].data] = jobIndex;
+            }
+        }
+        DracoJob const* job = &dracoJob;
+        JobSystem::Job* decoder = jobs::createJob(mJobSystem, nullptr,
+                [this, job] { decodeDracoJob(*job); });
+        mJobSystem.setPriority(decoder, JobSystem::JobPriority::BACKGROUND);
+        mJobs.push_back(mJobSystem.runAndRetain(decoder));
+    }
+}
+
+void CompressionDecoder::decodeDracoJob(DracoJob const& job) {
+    DracoCache* dracoCache = &mAsset->mSourceAsset->dracoCache;
 
     // For a given primitive and attribute, find the corresponding accessor.
     auto findAccessor = [](const cgltf_primitive* prim, cgltf_attribute_type type, cgltf_int idx) {
@@ -180,28 +293,22 @@ static void decodeDracoMeshes(FFilamentAsset* asset) {
         return (cgltf_accessor*) nullptr;
     };
 
-    // Go through every primitive and check if it has a Draco mesh.
-    for (auto& [prim, vertexBuffer] : asset->mPrimitives) {
-        if (!prim->has_draco_mesh_compression) {
-            continue;
-        }
-
+    // If an error occurs, we can simply set the primitive's associated VertexBuffer to null,
+    // which is done in finish(). This does not cause a leak because it is a weak reference.
+    DracoMesh* mesh = dracoCache->findOrCreateMesh(job.bufferView);
+    for (size_t primIndex : job.primitives) {
+        const cgltf_primitive* prim = mAsset->mPrimitives[primIndex].first;
         const cgltf_draco_mesh_compression& draco = prim->draco_mesh_compression;
 
-        // If an error occurs, we can simply set the primitive's associated VertexBuffer to null.
-        // This does not cause a leak because it is a weak reference.
-
-        // Check if we have already decoded this mesh.
-        DracoMesh* mesh = dracoCache->findOrCreateMesh(draco.buffer_view);
         if (!mesh) {
             slog.e << "Cannot decompress mesh, Draco decoding error." << io::endl;
-            vertexBuffer = nullptr;
+            mDracoFailures[primIndex] = true;
             continue;
         }
 
         // Copy over the decompressed data, converting the data type if necessary.
         if (prim->indices && !mesh->getFaceIndices(prim->indices)) {
-            vertexBuffer = nullptr;
+            mDracoFailures[primIndex] = true;
             continue;
         }
 
@@ -209,7 +316,7 @@ static void decodeDracoMeshes(FFilamentAsset* asset) {
         for (cgltf_size i = 0; i < draco.attributes_count; i++) {
 
             // In cgltf, each Draco attribute's data pointer is an attribute id, not an accessor.
-            const uint32_t id = draco.attributes[i].data - asset->mSourceAsset->hierarchy->accessors;
+            const uint32_t id = draco.attributes[i].data - mAsset->mSourceAsset->hierarchy->accessors;
 
             // Find the destination accessor; this contains the desired component type, etc.
             const cgltf_attribute_type type = draco.attributes[i].type;
@@ -222,71 +329,121 @@ static void decodeDracoMeshes(FFilamentAsset* asset) {
 
             // Copy over the decompressed data, converting the data type if necessary.
             if (!mesh->getVertexAttributes(id, accessor)) {
-                vertexBuffer = nullptr;
+                mDracoFailures[primIndex] = true;
                 break;
             }
         }
     }
 }
 
-static void decodeMeshoptCompression(cgltf_data* data) {
+void CompressionDecoder::decodeMeshoptCompression() {
+    cgltf_data* data = (cgltf_data*) mAsset->mSourceAsset->hierarchy;
     for (size_t i = 0; i < data->buffer_views_count; ++i) {
-        if (!data->buffer_views[i].has_meshopt_compression) {
+        cgltf_buffer_view* bufferView = &data->buffer_views[i];
+        if (!bufferView->has_meshopt_compression || mMeshoptBufferViews.count(bufferView)) {
             continue;
         }
+        mMeshoptBufferViews[bufferView] = mJobs.size();
+        JobSystem::Job* decoder = jobs::createJob(mJobSystem, nullptr,
+                [bufferView] { decodeMeshopt(bufferView); });
+        mJobSystem.setPriority(decoder, JobSystem::JobPriority::BACKGROUND);
+        mJobs.push_back(mJobSystem.runAndRetain(decoder));
+    }
+}
 
-        cgltf_meshopt_compression* compression = &data->buffer_views[i].meshopt_compression;
-        const uint8_t* source = (const uint8_t*) compression->buffer->data;
-        assert_invariant(source);
-        source += compression->offset;
+void CompressionDecoder::decodeMeshopt(cgltf_buffer_view* bufferView) {
+    cgltf_meshopt_compression* compression = &bufferView->meshopt_compression;
+    const uint8_t* source = (const uint8_t*) compression->buffer->data;
+    assert_invariant(source);
+    source += compression->offset;
+
+    // This memory is freed by cgltf.
+    void* destination = malloc(compression->count * compression->stride);
+    assert_invariant(destination);
+
+    UTILS_UNUSED_IN_RELEASE int error = 0;
+    switch (compression->mode) {
+        case cgltf_meshopt_compression_mode_invalid:
+            break;
+        case cgltf_meshopt_compression_mode_attributes:
+            error = meshopt_decodeVertexBuffer(destination, compression->count, compression->stride,
+                    source, compression->size);
+            break;
+        case cgltf_meshopt_compression_mode_triangles:
+            error = meshopt_decodeIndexBuffer(destination, compression->count, compression->stride,
+                    source, compression->size);
+            break;
+        case cgltf_meshopt_compression_mode_indices:
+            error = meshopt_decodeIndexSequence(destination, compression->count, compression->stride,
+                    source, compression->size);
+            break;
+        default:
+            assert_invariant(false);
+            break;
+    }
+    assert_invariant(!error);
+
+    switch (compression->filter) {
+        case cgltf_meshopt_compression_filter_none:
+            break;
+        case cgltf_meshopt_compression_filter_octahedral:
+            meshopt_decodeFilterOct(destination, compression->count, compression->stride);
+            break;
+        case cgltf_meshopt_compression_filter_quaternion:
+            meshopt_decodeFilterQuat(destination, compression->count, compression->stride);
+            break;
+        case cgltf_meshopt_compression_filter_exponential:
+            meshopt_decodeFilterExp(destination, compression->count, compression->stride);
+            break;
+        default:
+            assert_invariant(false);
+            break;
+    }
 
-        // This memory is freed by cgltf.
-        void* destination = malloc(compression->count * compression->stride);
-        assert_invariant(destination);
+    bufferView->data = destination;
+}
 
-        UTILS_UNUSED_IN_RELEASE int error = 0;
-        switch (compression->mode) {
-            case cgltf_meshopt_compression_mode_invalid:
-                break;
-            case cgltf_meshopt_compression_mode_attributes:
-                error = meshopt_decodeVertexBuffer(destination, compression->count, compression->stride,
-                        source, compression->size);
-                break;
-            case cgltf_meshopt_compression_mode_triangles:
-                error = meshopt_decodeIndexBuffer(destination, compression->count, compression->stride,
-                        source, compression->size);
-                break;
-            case cgltf_meshopt_compression_mode_indices:
-                error = meshopt_decodeIndexSequence(destination, compression->count, compression->stride,
-                        source, compression->size);
-                break;
-            default:
-                assert_invariant(false);
-                break;
-        }
-        assert_invariant(!error);
+void CompressionDecoder::wait(const cgltf_accessor* accessor) {
+    // The buffer view of a Draco accessor is only known once its mesh has been decoded.
+    auto iter = mDracoAccessors.find(accessor);
+    if (iter != mDracoAccessors.end()) {
+        waitJob(iter->second);
+        return;
+    }
+    waitBufferView(accessor->buffer_view);
+    if (accessor->is_sparse) {
+        waitBufferView(accessor->sparse.indices_buffer_view);
+        waitBufferView(accessor->sparse.values_buffer_view);
+    }
+}
 
-        switch (compression->filter) {
-            case cgltf_meshopt_compression_filter_none:
-                break;
-            case cgltf_meshopt_compression_filter_octahedral:
-                meshopt_decodeFilterOct(destination, compression->count, compression->stride);
-                break;
-            case cgltf_meshopt_compression_filter_quaternion:
-                meshopt_decodeFilterQuat(destination, compression->count, compression->stride);
-                break;
-            case cgltf_meshopt_compression_filter_exponential:
-                meshopt_decodeFilterExp(destination, compression->count, compression->stride);
-                break;
-            default:
-                assert_invariant(false);
-                break;
+void CompressionDecoder::waitBufferView(const cgltf_buffer_view* bufferView) {
+    if (bufferView && bufferView->has_meshopt_compression) {
+        auto iter = mMeshoptBufferViews.find(bufferView);
+        if (iter != mMeshoptBufferViews.end()) {
+            waitJob(iter->second);
         }
+    }
+}
 
-        data->buffer_views[i].data = destination;
+void CompressionDecoder::waitJob(size_t index) {
+    if (mJobs[index]) {
+        mJobSystem.waitAndRelease(mJobs[index]);
     }
 }
 
+void CompressionDecoder::finish() {
+    for (size_t i = 0, n = mJobs.size(); i < n; ++i) {
+        waitJob(i);
+    }
+    for (size_t i = 0, n = mDracoFailures.size(); i < n; ++i) {
+        if (mDracoFailures[i]) {
+            mAsset->mPrimitives[i].second = nullptr;
+        }
+    }
+    mDracoFailures.clear();
+}
+
 // Parses a data URI and returns a blob that gets malloc'd in cgltf, which the caller must free.
 // (implementation snarfed from meshoptimizer)
 static const uint8_t* parseDataUri(const char* uri, std::string* mimeType, size_t* psize) {
@@ -372,7 +529,7 @@ void ResourceLoader::Impl::addResourceData(const char* uri, BufferDescriptor&& b
     mUriDataCache->emplace(uri, std::move(buffer));
 
     // If this is a texture and async loading has already started, add a new decoder job.
-    if (isTexture(uri) && mAsyncAsset && mRemainingTextureDownloads > 0) {
+    if (isTexture(uri) && getAsyncAsset() && mRemainingTextureDownloads > 0) {
         createTextures(mAsyncAsset, true);
     }
 }
@@ -463,14 +620,43 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
         return false;
     }
     #endif
-    // Decompress Draco meshes early on, which allows us to exploit subsequent processing such as
-    // tangent generation.
-    decodeDracoMeshes(asset);
-    decodeMeshoptCompression((cgltf_data*) gltf);
+
+    // If the client supplied a baked cache for this asset, the processed data is uploaded from it
+    // and the decoding, conversion and tangent generation steps below are skipped.
+    BakedCacheHandle bakedCache = std::move(pImpl->mBakedCache);
+    pImpl->mRecordedBakedCache.clear();
+    const uint64_t bakedCacheKey = (bakedCache || pImpl->mRecordBakedCache) ?
+            computeBakedCacheKey(asset, pImpl->mNormalizeSkinningWeights) : 0;
+    BakedCacheReader bakedCacheReader;
+    if (bakedCache && !bakedCacheReader.init((const uint8_t*) bakedCache->buffer,
+            bakedCache->size, bakedCacheKey)) {
+        slog.w << "Ignoring baked cache, it was created for a different asset." << io::endl;
+        bakedCache.reset();
+    }
+    std::optional<BakedCacheWriter> bakedCacheWriter;
+    if (pImpl->mRecordBakedCache) {
+        bakedCacheWriter.emplace(bakedCacheKey);
+    }
+    BakedCacheWriter* const recorder = bakedCacheWriter ? &bakedCacheWriter.value() : nullptr;
+    pImpl->mBakedCacheUsed = bool(bakedCache);
+
+    // Decompress Draco meshes and meshopt buffers early on, which allows us to exploit subsequent
+    // processing such as tangent generation. Decoding happens on the JobSystem, and each buffer is
+    // uploaded below as soon as its data is ready.
+    CompressionDecoder decoder(pImpl->mEngine->getJobSystem(), asset);
+    if (!bakedCache) {
+        decoder.decodeDracoMeshes();
+        decoder.decodeMeshoptCompression();
+    } else if (gltf->animations_count > 0) {
+        // Animation data is read from the source buffers, which might be compressed.
+        decoder.decodeMeshoptCompression();
+        decoder.finish();
+    }
 
     // For each skin, optionally normalize skinning weights and store a copy of the bind matrices.
     if (gltf->skins_count > 0) {
-        if (pImpl->mNormalizeSkinningWeights) {
+        if (pImpl->mNormalizeSkinningWeights && !bakedCache) {
+            decoder.finish();
             normalizeSkinningWeights(asset);
         }
         asset->mSkins.reserve(gltf->skins_count);
@@ -482,7 +668,18 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
             }
             const cgltf_accessor* srcMatrices = srcSkin.inverse_bind_matrices;
             FixedCapacityVector<mat4f> inverseBindMatrices(srcSkin.joints_count);
-            if (srcMatrices) {
+            const size_t matricesSize = srcSkin.joints_count * sizeof(mat4f);
+            if (bakedCache) {
+                BakedRecord record;
+                const uint8_t* data = bakedCacheReader.next(
+                        BakedRecordType::INVERSE_BIND_MATRICES, &record);
+                if (!data || record.size != matricesSize) {
+                    slog.e << "Corrupted baked cache." << io::endl;
+                    return false;
+                }
+                memcpy((uint8_t*) inverseBindMatrices.data(), data, matricesSize);
+            } else if (srcMatrices) {
+                decoder.wait(srcMatrices);
                 uint8_t* bytes = nullptr;
                 uint8_t* srcBuffer = nullptr;
                 if (srcMatrices->buffer_view->has_meshopt_compression) {
@@ -494,7 +691,11 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
                 }
                 assert_invariant(bytes);
                 memcpy((uint8_t*) inverseBindMatrices.data(),
-                        (const void*) srcBuffer, srcSkin.joints_count * sizeof(mat4f));
+                        (const void*) srcBuffer, matricesSize);
+            }
+            if (recorder) {
+                recorder->add(BakedRecordType::INVERSE_BIND_MATRICES, srcSkin.joints_count,
+                        inverseBindMatrices.data(), matricesSize);
             }
             FFilamentAsset::Skin skin {
                 .name = std::move(name),
@@ -506,89 +707,134 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
 
     Engine& engine = *pImpl->mEngine;
 
-    // Upload VertexBuffer and IndexBuffer data to the GPU.
-    for (auto slot : asset->mBufferSlots) {
-        const cgltf_accessor* accessor = slot.accessor;
-        if (!accessor->buffer_view) {
-            continue;
+    if (bakedCache) {
+        std::vector<TangentsJob::Params> tangentsJobs = pImpl->collectTangentsJobs(asset);
+        if (!pImpl->uploadBakedCache(asset, bakedCacheReader, bakedCache, tangentsJobs)) {
+            slog.e << "Corrupted baked cache." << io::endl;
+            return false;
         }
-        const uint8_t* bufferData = nullptr;
-        const uint8_t* data = nullptr;
-        if (accessor->buffer_view->has_meshopt_compression) {
-            bufferData = (const uint8_t*) accessor->buffer_view->data;
-            data = bufferData + accessor->offset;
-        } else {
-            bufferData = (const uint8_t*) accessor->buffer_view->buffer->data;
-            data = computeBindingOffset(accessor) + bufferData;
-        }
-        assert_invariant(bufferData);
-        const uint32_t size = computeBindingSize(accessor);
-        if (slot.vertexBuffer) {
-            if (requiresConversion(accessor)) {
-                const size_t floatsCount = accessor->count * cgltf_num_components(accessor->type);
-                const size_t floatsByteCount = sizeof(float) * floatsCount;
-                float* floatsData = (float*) malloc(floatsByteCount);
-                cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
-                BufferObject* bo = BufferObject::Builder().size(floatsByteCount).build(engine);
+    } else {
+        // Upload VertexBuffer and IndexBuffer data to the GPU.
+        for (auto slot : asset->mBufferSlots) {
+            const cgltf_accessor* accessor = slot.accessor;
+            decoder.wait(accessor);
+            if (!accessor->buffer_view) {
+                continue;
+            }
+            const uint8_t* bufferData = nullptr;
+            const uint8_t* data = nullptr;
+            if (accessor->buffer_view->has_meshopt_compression) {
+                bufferData = (const uint8_t*) accessor->buffer_view->data;
+                data = bufferData + accessor->offset;
+            } else {
+                bufferData = (const uint8_t*) accessor->buffer_view->buffer->data;
+                data = computeBindingOffset(accessor) + bufferData;
+            }
+            assert_invariant(bufferData);
+            const uint32_t size = computeBindingSize(accessor);
+            if (slot.vertexBuffer) {
+                if (requiresConversion(accessor)) {
+                    const size_t floatsCount =
+                            accessor->count * cgltf_num_components(accessor->type);
+                    const size_t floatsByteCount = sizeof(float) * floatsCount;
+                    float* floatsData = (float*) malloc(floatsByteCount);
+                    cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
+                    if (recorder) {
+                        recorder->add(BakedRecordType::VERTEX, 0, floatsData, floatsByteCount);
+                    }
+                    BufferObject* bo = BufferObject::Builder().size(floatsByteCount).build(engine);
+                    asset->mBufferObjects.push_back(bo);
+                    bo->setBuffer(engine,
+                            BufferDescriptor(floatsData, floatsByteCount, FREE_CALLBACK));
+                    slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
+                    continue;
+                }
+                if (recorder) {
+                    recorder->add(BakedRecordType::VERTEX, 0, data, size);
+                }
+                BufferObject* bo = BufferObject::Builder().size(size).build(engine);
                 asset->mBufferObjects.push_back(bo);
-                bo->setBuffer(engine, BufferDescriptor(floatsData, floatsByteCount, FREE_CALLBACK));
+                bo->setBuffer(engine, BufferDescriptor(data, size,
+                        uploadCallback, uploadUserdata(asset, pImpl->mUriDataCache)));
                 slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
                 continue;
-            }
-            BufferObject* bo = BufferObject::Builder().size(size).build(engine);
-            asset->mBufferObjects.push_back(bo);
-            bo->setBuffer(engine, BufferDescriptor(data, size,
-                    uploadCallback, uploadUserdata(asset, pImpl->mUriDataCache)));
-            slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
-            continue;
-        } else if (slot.indexBuffer) {
-            if (accessor->component_type == cgltf_component_type_r_8u) {
-                const size_t size16 = size * 2;
-                uint16_t* data16 = (uint16_t*) malloc(size16);
-                convertBytesToShorts(data16, data, size);
-                IndexBuffer::BufferDescriptor bd(data16, size16, FREE_CALLBACK);
+            } else if (slot.indexBuffer) {
+                if (accessor->component_type == cgltf_component_type_r_8u) {
+                    const size_t size16 = size * 2;
+                    uint16_t* data16 = (uint16_t*) malloc(size16);
+                    convertBytesToShorts(data16, data, size);
+                    if (recorder) {
+                        recorder->add(BakedRecordType::INDEX, 0, data16, size16);
+                    }
+                    IndexBuffer::BufferDescriptor bd(data16, size16, FREE_CALLBACK);
+                    slot.indexBuffer->setBuffer(engine, std::move(bd));
+                    continue;
+                }
+                if (recorder) {
+                    recorder->add(BakedRecordType::INDEX, 0, data, size);
+                }
+                IndexBuffer::BufferDescriptor bd(data, size, uploadCallback,
+                        uploadUserdata(asset, pImpl->mUriDataCache));
                 slot.indexBuffer->setBuffer(engine, std::move(bd));
                 continue;
             }
-            IndexBuffer::BufferDescriptor bd(data, size, uploadCallback,
-                    uploadUserdata(asset, pImpl->mUriDataCache));
-            slot.indexBuffer->setBuffer(engine, std::move(bd));
-            continue;
-        }
 
-        // If the buffer slot does not have an associated VertexBuffer or IndexBuffer, then this
-        // must be a morph target.
-        assert(slot.morphTargetBuffer);
+            // If the buffer slot does not have an associated VertexBuffer or IndexBuffer, then this
+            // must be a morph target.
+            assert(slot.morphTargetBuffer);
+
+            const size_t vertexCount = slot.morphTargetBuffer->getVertexCount();
+            const size_t positionSize = accessor->type == cgltf_type_vec3 ?
+                    sizeof(float3) : sizeof(float4);
 
-        if (requiresPacking(accessor)) {
-            const size_t floatsCount = accessor->count * cgltf_num_components(accessor->type);
-            const size_t floatsByteCount = sizeof(float) * floatsCount;
-            float* floatsData = (float*) malloc(floatsByteCount);
-            cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
+            if (requiresPacking(accessor)) {
+                const size_t floatsCount = accessor->count * cgltf_num_components(accessor->type);
+                const size_t floatsByteCount = sizeof(float) * floatsCount;
+                float* floatsData = (float*) malloc(floatsByteCount);
+                cgltf_accessor_unpack_floats(accessor, floatsData, floatsCount);
+                if (recorder) {
+                    recorder->add(BakedRecordType::MORPH_POSITIONS, vertexCount, floatsData,
+                            vertexCount * positionSize);
+                }
+                if (accessor->type == cgltf_type_vec3) {
+                    slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                            (const float3*) floatsData, vertexCount);
+                } else {
+                    slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                            (const float4*) floatsData, vertexCount);
+                }
+                free(floatsData);
+                continue;
+            }
+
+            if (recorder) {
+                recorder->add(BakedRecordType::MORPH_POSITIONS, vertexCount, data,
+                        vertexCount * positionSize);
+            }
             if (accessor->type == cgltf_type_vec3) {
                 slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                        (const float3*) floatsData, slot.morphTargetBuffer->getVertexCount());
+                        (const float3*) data, vertexCount);
             } else {
+                assert_invariant(accessor->type == cgltf_type_vec4);
                 slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                        (const float4*) data, slot.morphTargetBuffer->getVertexCount());
+                        (const float4*) data, vertexCount);
             }
-            free(floatsData);
-            continue;
         }
 
-        if (accessor->type == cgltf_type_vec3) {
-            slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                    (const float3*) data, slot.morphTargetBuffer->getVertexCount());
-        } else {
-            assert_invariant(accessor->type == cgltf_type_vec4);
-            slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
-                    (const float4*) data, slot.morphTargetBuffer->getVertexCount());
-        }
+        // Primitives that failed to decode are detached here, so that no tangents are generated
+        // for them.
+        decoder.finish();
+
+        // Compute surface orientation quaternions if necessary. This is similar to sparse data in
+        // that we need to generate the contents of a GPU buffer by processing one or more CPU
+        // buffer(s).
+        std::vector<TangentsJob::Params> tangentsJobs = pImpl->collectTangentsJobs(asset);
+        pImpl->computeTangents(asset, tangentsJobs, recorder);
     }
 
-    // Compute surface orientation quaternions if necessary. This is similar to sparse data in that
-    // we need to generate the contents of a GPU buffer by processing one or more CPU buffer(s).
-    pImpl->computeTangents(asset);
+    if (recorder) {
+        pImpl->mRecordedBakedCache = recorder->finish();
+    }
 
     asset->mBufferSlots = {};
     asset->mPrimitives = {};
@@ -613,8 +859,26 @@ bool ResourceLoader::loadResources(FFilamentAsset* asset, bool async) {
     return true;
 }
 
+void ResourceLoader::enableBakedCacheRecording(bool enabled) {
+    pImpl->mRecordBakedCache = enabled;
+}
+
+const uint8_t* ResourceLoader::getBakedCache(size_t* size) const {
+    *size = pImpl->mRecordedBakedCache.size();
+    return pImpl->mRecordedBakedCache.empty() ? nullptr : pImpl->mRecordedBakedCache.data();
+}
+
+void ResourceLoader::setBakedCache(BufferDescriptor&& cache) {
+    pImpl->mBakedCache = std::make_shared<BufferDescriptor>(std::move(cache));
+}
+
+bool ResourceLoader::isBakedCacheUsed() const {
+    return pImpl->mBakedCacheUsed;
+}
+
 bool ResourceLoader::asyncBeginLoad(FilamentAsset* asset) {
     pImpl->mAsyncAsset = downcast(asset);
+    pImpl->mAsyncAssetLifetime = pImpl->mAsyncAsset->mLifetime;
     return loadResources(downcast(asset), true);
 }
 
@@ -624,6 +888,15 @@ void ResourceLoader::asyncCancelLoad() {
     pImpl->mEngine->flushAndWait();
 }
 
+void ResourceLoader::setDecodeMemoryBudget(size_t bytes) {
+    pImpl->mDecodeBudget = bytes;
+}
+
+void ResourceLoader::asyncSetScreenCoverage(Entity renderable, float coverage) {
+    pImpl->mScreenCoverage[renderable] = coverage;
+    pImpl->mPrioritiesDirty = true;
+}
+
 void ResourceLoader::addTextureProvider(const char* mimeType, TextureProvider* provider) {
     pImpl->mTextureProviders[mimeType] = provider;
 }
@@ -639,23 +912,32 @@ float ResourceLoader::asyncGetLoadProgress() const {
         poppedCount += iter.second->getPoppedCount();
     }
 
-    // Textures that haven't been fully downloaded are not yet pushed into one of the
-    // decoding queues, so here we include them in the total "pending" count.
-    const size_t pendingCount = pushedCount + pImpl->mRemainingTextureDownloads;
+    // Textures that haven't been fully downloaded or that are held back by the decode budget are
+    // not yet pushed into one of the decoding queues, so here we include them in the total
+    // "pending" count.
+    const size_t pendingCount = pushedCount + pImpl->mRemainingTextureDownloads +
+            pImpl->mPendingTextures.size();
 
     return pendingCount == 0 ? 1 : (float(poppedCount) / pendingCount);
 }
 
 void ResourceLoader::asyncUpdateLoad() {
-    if (!pImpl->mAsyncAsset) {
+    FFilamentAsset* asset = pImpl->getAsyncAsset();
+    if (!asset) {
         return;
     }
     for (const auto& iter : pImpl->mTextureProviders) {
         iter.second->updateQueue();
         while (Texture* texture = iter.second->popTexture()) {
-            pImpl->mAsyncAsset->mDependencyGraph.markAsReady(texture);
+            asset->mDependencyGraph.markAsReady(texture);
+            if (auto pos = pImpl->mDecodingTextures.find(texture);
+                    pos != pImpl->mDecodingTextures.end()) {
+                pImpl->mDecodingBytes -= pos->second;
+                pImpl->mDecodingTextures.erase(pos);
+            }
         }
     }
+    pImpl->streamTextures(asset);
 }
 
 std::pair<Texture*, CacheResult> ResourceLoader::Impl::getOrCreateTexture(FFilamentAsset* asset,
@@ -765,38 +1047,152 @@ void ResourceLoader::Impl::cancelTextureDecoding() {
         iter.second->cancelDecoding();
     }
     mAsyncAsset = nullptr;
+    mPendingTextures.clear();
+    mDecodingTextures.clear();
+    mDecodingBytes = 0;
 }
 
-void ResourceLoader::Impl::createTextures(FFilamentAsset* asset, bool async) {
-    mRemainingTextureDownloads = 0;
+FFilamentAsset* ResourceLoader::Impl::getAsyncAsset() {
+    if (mAsyncAsset && mAsyncAssetLifetime.expired()) {
+        // The asset was destroyed during the load, along with its textures. Drop the textures that
+        // were not submitted yet and discard the ones that are in the decoding queues.
+        cancelTextureDecoding();
+        for (const auto& iter : mTextureProviders) {
+            iter.second->updateQueue();
+            while (iter.second->popTexture()) {}
+        }
+    }
+    return mAsyncAsset;
+}
 
-    // Create new texture objects if they are not cached and kick off decoding jobs.
-    for (size_t textureIndex = 0, n = asset->mTextures.size(); textureIndex < n; ++textureIndex) {
-        FFilamentAsset::TextureInfo& info = asset->mTextures[textureIndex];
-        auto [texture, cacheResult] = getOrCreateTexture(asset, textureIndex, info.flags);
-        if (texture == nullptr) {
-            if (cacheResult == CacheResult::NOT_READY) {
-                mRemainingTextureDownloads++;
-            }
-            continue;
+void ResourceLoader::Impl::createTexture(FFilamentAsset* asset, size_t textureIndex,
+        bool streaming) {
+    FFilamentAsset::TextureInfo& info = asset->mTextures[textureIndex];
+    auto [texture, cacheResult] = getOrCreateTexture(asset, textureIndex, info.flags);
+    if (texture == nullptr) {
+        if (cacheResult == CacheResult::NOT_READY) {
+            mRemainingTextureDownloads++;
+        }
+        return;
+    }
+
+    // If this cgtf_texture slot is being initialized, copy the Texture into the slot
+    // and note if the Texture was created or re-used.
+    if (info.texture == nullptr) {
+        info.texture = texture;
+        info.isOwner = cacheResult == CacheResult::MISS;
+    }
+
+    // Keep track of the textures being decoded when streaming. The decoded size is estimated
+    // from the dimensions, assuming 4 bytes per texel and a full mip chain.
+    if (streaming && cacheResult == CacheResult::MISS) {
+        size_t size = size_t(texture->getWidth()) * texture->getHeight() * 4;
+        if (texture->getLevels() > 1) {
+            size += size / 3;
         }
+        mDecodingTextures[texture] = size;
+        mDecodingBytes += size;
+    }
+
+    // For each binding to a material instance, call setParameter(...) on the material.
+    for (const TextureSlot& slot : info.bindings) {
+        asset->applyTextureBinding(textureIndex, slot);
+    }
+}
+
+void ResourceLoader::Impl::sortPendingTextures(FFilamentAsset* asset) {
+    SYSTRACE_CALL();
 
-        // If this cgtf_texture slot is being initialized, copy the Texture into the slot
-        // and note if the Texture was created or re-used.
-        if (info.texture == nullptr) {
-            info.texture = texture;
-            info.isOwner = cacheResult == CacheResult::MISS;
+    // The priority of a texture is the largest screen coverage of the renderables that use it.
+    tsl::robin_map<const MaterialInstance*, float> materialCoverage;
+    RenderableManager& rm = mEngine->getRenderableManager();
+    for (Entity entity : asset->mEntities) {
+        auto pos = mScreenCoverage.find(entity);
+        if (pos == mScreenCoverage.end()) {
+            continue;
+        }
+        auto ri = rm.getInstance(entity);
+        if (!ri) {
+            continue;
+        }
+        for (size_t i = 0, n = rm.getPrimitiveCount(ri); i < n; i++) {
+            float& coverage = materialCoverage[rm.getMaterialInstanceAt(ri, i)];
+            coverage = std::max(coverage, pos->second);
         }
+    }
 
-        // For each binding to a material instance, call setParameter(...) on the material.
-        for (const TextureSlot& slot : info.bindings) {
-            asset->applyTextureBinding(textureIndex, slot);
+    auto getPriority = [asset, &materialCoverage](size_t textureIndex) {
+        float priority = 0.0f;
+        for (const TextureSlot& slot : asset->mTextures[textureIndex].bindings) {
+            if (auto pos = materialCoverage.find(slot.materialInstance);
+                    pos != materialCoverage.end()) {
+                priority = std::max(priority, pos->second);
+            }
         }
+        return priority;
+    };
+
+    // Textures are decoded from the back of the list, in the order of the glTF file for equal
+    // priorities.
+    std::vector<std::pair<float, size_t>> sorted;
+    sorted.reserve(mPendingTextures.size());
+    for (size_t textureIndex : mPendingTextures) {
+        sorted.emplace_back(getPriority(textureIndex), textureIndex);
     }
+    std::sort(sorted.begin(), sorted.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second > rhs.second);
+    });
+    for (size_t i = 0, n = sorted.size(); i < n; i++) {
+        mPendingTextures[i] = sorted[i].second;
+    }
+    mPrioritiesDirty = false;
+}
+
+void ResourceLoader::Impl::streamTextures(FFilamentAsset* asset) {
+    if (mPendingTextures.empty()) {
+        return;
+    }
+    if (mPrioritiesDirty) {
+        sortPendingTextures(asset);
+    }
+    while (!mPendingTextures.empty() &&
+            (mDecodingBytes < mDecodeBudget || mDecodingTextures.empty())) {
+        const size_t textureIndex = mPendingTextures.back();
+        mPendingTextures.pop_back();
+        createTexture(asset, textureIndex, true);
+    }
+    if (mPendingTextures.empty()) {
+        mScreenCoverage.clear();
+    }
+}
+
+void ResourceLoader::Impl::createTextures(FFilamentAsset* asset, bool async) {
+    mRemainingTextureDownloads = 0;
 
     // Non-threaded systems are required to use the asynchronous API.
     assert_invariant(UTILS_HAS_THREADING || async);
 
+    // When streaming, textures are submitted to their provider progressively, from
+    // asyncUpdateLoad(), so that the decode budget is honored.
+    if (async && mDecodeBudget) {
+        mPendingTextures.clear();
+        for (size_t textureIndex = 0, n = asset->mTextures.size(); textureIndex < n;
+                ++textureIndex) {
+            if (asset->mTextures[textureIndex].texture == nullptr) {
+                mPendingTextures.push_back(textureIndex);
+            }
+        }
+        std::reverse(mPendingTextures.begin(), mPendingTextures.end());
+        mPrioritiesDirty = !mScreenCoverage.empty();
+        streamTextures(asset);
+        return;
+    }
+
+    // Create new texture objects if they are not cached and kick off decoding jobs.
+    for (size_t textureIndex = 0, n = asset->mTextures.size(); textureIndex < n; ++textureIndex) {
+        createTexture(asset, textureIndex, false);
+    }
+
     if (async) {
         return;
     }
@@ -807,9 +1203,8 @@ void ResourceLoader::Impl::createTextures(FFilamentAsset* asset, bool async) {
     }
 }
 
-void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
-    SYSTRACE_CALL();
-
+std::vector<TangentsJob::Params> ResourceLoader::Impl::collectTangentsJobs(
+        FFilamentAsset* asset) {
     const cgltf_accessor* kGenerateTangents = &asset->mGenerateTangents;
     const cgltf_accessor* kGenerateNormals = &asset->mGenerateNormals;
 
@@ -868,6 +1263,15 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
         }
     }
 
+    return jobParams;
+}
+
+void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset,
+        std::vector<TangentsJob::Params>& jobParams, BakedCacheWriter* recorder) {
+    SYSTRACE_CALL();
+
+    using Params = TangentsJob::Params;
+
     // Kick off jobs for computing tangent frames.
     JobSystem* js = &mEngine->getJobSystem();
     JobSystem::Job* parent = js->createJob();
@@ -879,6 +1283,12 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
 
     // Finally, upload quaternions to the GPU from the main thread.
     for (Params& params : jobParams) {
+        if (recorder) {
+            recorder->add(params.context.vb ?
+                    BakedRecordType::VERTEX_TANGENTS : BakedRecordType::MORPH_TANGENTS,
+                    params.out.vertexCount, params.out.results,
+                    params.out.vertexCount * sizeof(short4));
+        }
         if (params.context.vb) {
             BufferObject* bo = BufferObject::Builder()
                     .size(params.out.vertexCount * sizeof(short4)).build(*mEngine);
@@ -895,6 +1305,76 @@ void ResourceLoader::Impl::computeTangents(FFilamentAsset* asset) {
     }
 }
 
+bool ResourceLoader::Impl::uploadBakedCache(FFilamentAsset* asset, BakedCacheReader& reader,
+        BakedCacheHandle const& cache, std::vector<TangentsJob::Params> const& jobParams) {
+    SYSTRACE_CALL();
+
+    // The records are in the same order as the uploads of a regular load, see loadResources().
+    Engine& engine = *mEngine;
+    BakedRecord record;
+    for (auto slot : asset->mBufferSlots) {
+        if (!slot.accessor->buffer_view) {
+            continue;
+        }
+        if (slot.vertexBuffer) {
+            const uint8_t* data = reader.next(BakedRecordType::VERTEX, &record);
+            if (!data) {
+                return false;
+            }
+            BufferObject* bo = BufferObject::Builder().size(record.size).build(engine);
+            asset->mBufferObjects.push_back(bo);
+            bo->setBuffer(engine, BufferDescriptor(data, record.size,
+                    uploadCallback, uploadUserdata(cache)));
+            slot.vertexBuffer->setBufferObjectAt(engine, slot.bufferIndex, bo);
+        } else if (slot.indexBuffer) {
+            const uint8_t* data = reader.next(BakedRecordType::INDEX, &record);
+            if (!data) {
+                return false;
+            }
+            IndexBuffer::BufferDescriptor bd(data, record.size,
+                    uploadCallback, uploadUserdata(cache));
+            slot.indexBuffer->setBuffer(engine, std::move(bd));
+        } else {
+            assert_invariant(slot.morphTargetBuffer);
+            const uint8_t* data = reader.next(BakedRecordType::MORPH_POSITIONS, &record);
+            const size_t vertexCount = slot.morphTargetBuffer->getVertexCount();
+            if (!data || record.count != vertexCount) {
+                return false;
+            }
+            if (record.size == vertexCount * sizeof(float3)) {
+                slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                        (const float3*) data, vertexCount);
+            } else if (record.size == vertexCount * sizeof(float4)) {
+                slot.morphTargetBuffer->setPositionsAt(engine, slot.bufferIndex,
+                        (const float4*) data, vertexCount);
+            } else {
+                return false;
+            }
+        }
+    }
+
+    for (const TangentsJob::Params& params : jobParams) {
+        const uint8_t* data = reader.next(params.context.vb ?
+                BakedRecordType::VERTEX_TANGENTS : BakedRecordType::MORPH_TANGENTS, &record);
+        if (!data || record.size != record.count * sizeof(short4)) {
+            return false;
+        }
+        if (params.context.vb) {
+            BufferObject* bo = BufferObject::Builder().size(record.size).build(engine);
+            asset->mBufferObjects.push_back(bo);
+            bo->setBuffer(engine, BufferDescriptor(data, record.size,
+                    uploadCallback, uploadUserdata(cache)));
+            params.context.vb->setBufferObjectAt(engine, params.context.slot, bo);
+        } else {
+            assert_invariant(params.context.tb);
+            params.context.tb->setTangentsAt(engine, params.in.morphTargetIndex,
+                    (const short4*) data, record.count);
+        }
+    }
+
+    return true;
+}
+
 ResourceLoader::Impl::~Impl() {
     for (const auto& iter : mTextureProviders) {
         iter.second->cancelDecoding();
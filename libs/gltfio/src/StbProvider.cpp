@@ -263,6 +263,8 @@ void StbProvider::decodeSingleTexture() {
 
 StbProvider::StbProvider(Engine* engine) : mEngine(engine) {
     mDecoderRootJob = mEngine->getJobSystem().createJob();
+    // decoding is done in the background, it shouldn't delay the jobs of a frame
+    mEngine->getJobSystem().setPriority(mDecoderRootJob, JobSystem::JobPriority::BACKGROUND);
 #ifndef NDEBUG
     slog.i << "Texture Decoder has "
             << mEngine->getJobSystem().getThreadCount()
@@ -25,6 +25,7 @@
 
 #include <gltfio/AssetLoader.h>
 #include <gltfio/FilamentAsset.h>
+#include <gltfio/FilamentInstance.h>
 #include <gltfio/ResourceLoader.h>
 #include <gltfio/TextureProvider.h>
 #include <gltfio/math.h>
@@ -36,7 +37,10 @@
 #include "materials/uberarchive.h"
 
 #include <fstream>
+#include <iterator>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 using namespace filament;
 using namespace backend;
@@ -236,6 +240,109 @@ TEST_F(glTFIOTest, AnimatedMorphCubeRenderables) {
     EXPECT_EQ(morphTargetBuffer->getVertexCount(), 24u);
 }
 
+TEST_F(glTFIOTest, AnimatedMorphCubeBakedCache) {
+    Path const path = Path::getCurrentExecutable().getParent() + ANIMATED_MORPH_CUBE_GLB;
+    std::ifstream in(path.c_str(), std::ifstream::binary);
+    std::vector<uint8_t> content(std::istreambuf_iterator<char>(in), {});
+
+    AssetLoader* assetLoader = AssetLoader::create({ mEngine, mMaterialProvider, mNameManager });
+    ResourceLoader resourceLoader({ mEngine, path.c_str(), false });
+
+    // Record a baked cache.
+    resourceLoader.enableBakedCacheRecording(true);
+    FilamentAsset* asset = assetLoader->createAsset(content.data(), content.size());
+    ASSERT_NE(asset, nullptr);
+    EXPECT_TRUE(resourceLoader.loadResources(asset));
+    EXPECT_FALSE(resourceLoader.isBakedCacheUsed());
+    assetLoader->destroyAsset(asset);
+    resourceLoader.enableBakedCacheRecording(false);
+
+    size_t size = 0;
+    uint8_t const* data = resourceLoader.getBakedCache(&size);
+    ASSERT_NE(data, nullptr);
+    std::vector<uint64_t> cache((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    memcpy(cache.data(), data, size);
+
+    // A load of the same asset uses the cache.
+    resourceLoader.setBakedCache({ cache.data(), size });
+    asset = assetLoader->createAsset(content.data(), content.size());
+    ASSERT_NE(asset, nullptr);
+    EXPECT_TRUE(resourceLoader.loadResources(asset));
+    EXPECT_TRUE(resourceLoader.isBakedCacheUsed());
+    assetLoader->destroyAsset(asset);
+
+    // A truncated cache is ignored.
+    resourceLoader.setBakedCache({ cache.data(), size - sizeof(uint64_t) });
+    asset = assetLoader->createAsset(content.data(), content.size());
+    ASSERT_NE(asset, nullptr);
+    EXPECT_TRUE(resourceLoader.loadResources(asset));
+    EXPECT_FALSE(resourceLoader.isBakedCacheUsed());
+    assetLoader->destroyAsset(asset);
+
+    mEngine->flushAndWait();
+    AssetLoader::destroy(&assetLoader);
+}
+
+TEST_F(glTFIOTest, AutomaticInstancing) {
+    // A triangle that is drawn by three nodes, 10 units apart.
+    std::string const json = R"({
+        "asset": { "version": "2.0" },
+        "scene": 0,
+        "scenes": [ { "nodes": [ 0, 1, 2 ] } ],
+        "nodes": [
+            { "name": "a", "mesh": 0 },
+            { "name": "b", "mesh": 0, "translation": [ 10, 0, 0 ] },
+            { "name": "c", "mesh": 0, "translation": [ 20, 0, 0 ] }
+        ],
+        "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0 } } ] } ],
+        "accessors": [ {
+            "bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3",
+            "min": [ 0, 0, 0 ], "max": [ 1, 1, 0 ]
+        } ],
+        "bufferViews": [ { "buffer": 0, "byteLength": 36 } ],
+        "buffers": [ {
+            "byteLength": 36,
+            "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAA"
+        } ]
+    })";
+
+    AssetLoader* assetLoader = AssetLoader::create({
+            mEngine, mMaterialProvider, mNameManager, nullptr, nullptr, true });
+    FilamentAsset* asset = assetLoader->createAsset((uint8_t const*) json.data(), json.size());
+    ASSERT_NE(asset, nullptr);
+
+    // The three nodes are drawn by a single renderable.
+    auto& rm = mEngine->getRenderableManager();
+    ASSERT_EQ(asset->getRenderableEntityCount(), 1u);
+    Entity const renderable = asset->getRenderableEntities()[0];
+    EXPECT_FALSE(rm.hasComponent(asset->getFirstEntityByName("a")));
+    EXPECT_FALSE(rm.hasComponent(asset->getFirstEntityByName("b")));
+
+    // Its bounding box encloses every instance, and follows the nodes when they move.
+    Box box = rm.getAxisAlignedBoundingBox(rm.getInstance(renderable));
+    EXPECT_FLOAT_EQ(box.getMin().x, 0.0f);
+    EXPECT_FLOAT_EQ(box.getMax().x, 21.0f);
+
+    auto& tm = mEngine->getTransformManager();
+    tm.setTransform(tm.getInstance(asset->getFirstEntityByName("c")),
+            math::mat4f::translation(math::float3{ 40, 0, 0 }));
+    asset->getInstance()->updateInstancedMeshes();
+    box = rm.getAxisAlignedBoundingBox(rm.getInstance(renderable));
+    EXPECT_FLOAT_EQ(box.getMin().x, 0.0f);
+    EXPECT_FLOAT_EQ(box.getMax().x, 41.0f);
+
+    // Only "a" moved since the previous update, the other instances keep their transforms.
+    tm.setTransform(tm.getInstance(asset->getFirstEntityByName("a")),
+            math::mat4f::translation(math::float3{ -10, 0, 0 }));
+    asset->getInstance()->updateInstancedMeshes();
+    box = rm.getAxisAlignedBoundingBox(rm.getInstance(renderable));
+    EXPECT_FLOAT_EQ(box.getMin().x, -10.0f);
+    EXPECT_FLOAT_EQ(box.getMax().x, 41.0f);
+
+    assetLoader->destroyAsset(asset);
+    AssetLoader::destroy(&assetLoader);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -125,7 +125,7 @@ bool ShaderReplacer::replaceShaderSource(ShaderModel shaderModel, Variant varian
     }
 
     filaflat::ChunkContainer const& cc = mOriginalPackage;
-    if (!cc.hasChunk(mMaterialTag) || !cc.hasChunk(mDictionaryTag)) {
+    if (!cc.hasChunk(mMaterialTag) || !DictionaryReader::hasDictionary(cc, mDictionaryTag)) {
         return false;
     }
 
@@ -145,7 +145,9 @@ bool ShaderReplacer::replaceShaderSource(ShaderModel shaderModel, Variant varian
             sstream.read((char*) &size, sizeof(size));
             content.resize(size);
             sstream.read((char*) content.data(), size);
-            if (ChunkType(type) == mDictionaryTag|| ChunkType(type) == mMaterialTag) {
+            // the new dictionary is never compressed, so the compressed one is dropped too
+            if (ChunkType(type) == mDictionaryTag || ChunkType(type) == mMaterialTag ||
+                    ChunkType(type) == DictionaryReader::getLz4Tag(mDictionaryTag)) {
                 continue;
             }
             tstream.write((char*) &type, sizeof(type));
@@ -262,7 +264,9 @@ bool ShaderReplacer::replaceSpirv(ShaderModel shaderModel, Variant variant,
             sstream.read((char*) &size, sizeof(size));
             content.resize(size);
             sstream.read((char*) content.data(), size);
-            if (ChunkType(type) == mDictionaryTag || ChunkType(type) == mMaterialTag) {
+            // the new dictionary is never compressed, so the compressed one is dropped too
+            if (ChunkType(type) == mDictionaryTag || ChunkType(type) == mMaterialTag ||
+                    ChunkType(type) == DictionaryReader::getLz4Tag(mDictionaryTag)) {
                 continue;
             }
             tstream.write((char*) &type, sizeof(type));
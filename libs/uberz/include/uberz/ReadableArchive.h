@@ -17,6 +17,7 @@
 #ifndef UBERZ_READABLE_ARCHIVE_H
 #define UBERZ_READABLE_ARCHIVE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <uberz/ArchiveEnums.h>
@@ -30,9 +31,31 @@ namespace filament::uberz {
 // offset fields into pointers.
 void convertOffsetsToPointers(struct ReadableArchive* archive);
 
+// Alternatively, the offsets can be resolved on the fly with resolveOffset(), which leaves the
+// archive untouched. This allows an uncompressed archive to be used in place, e.g. straight from
+// a read-only memory-mapped file.
+template<typename T>
+inline T const* resolveOffset(struct ReadableArchive const* archive, uint64_t offset) noexcept {
+    return (T const*) (((uint8_t const*) archive) + offset);
+}
+
+// Returns the index of the given feature name in the spec masks, or -1 if the archive has no
+// feature index or if none of its specs has a flag with that name. This requires an archive whose
+// offsets have not been converted to pointers.
+int findFeatureBit(struct ReadableArchive const* archive, const char* name, size_t length) noexcept;
+
+// Computes the hash used by the feature index.
+uint32_t hashFeatureName(const char* name, size_t length) noexcept;
+
 UTILS_WARNING_PUSH
 UTILS_WARNING_ENABLE_PADDED
 
+static constexpr uint32_t ARCHIVE_MAGIC = 'UBER';
+static constexpr uint32_t ARCHIVE_VERSION = 1;
+
+// The feature index stores one bit per distinct feature flag name, in a 64-bit mask.
+static constexpr size_t MAX_INDEXED_FEATURES = 64;
+
 // Precompiled set of materials bundled with a list of features flags that each material supports.
 // This is the readable counterpart to WriteableArchive.
 // Used by gltfio; users do not need to access this class directly.
@@ -44,6 +67,18 @@ struct ReadableArchive {
         struct ArchiveSpec* specs;
         uint64_t specsOffset;
     };
+    // The following fields are only present when version >= 1, older archives have a 24 byte
+    // header and must not access them.
+    // Number of buckets in the feature index (a power of two), zero if there is no index.
+    uint64_t featureBucketCount;
+    union {
+        struct ArchiveFeatureBucket* featureBuckets;
+        uint64_t featureBucketsOffset;
+    };
+    union {
+        struct ArchiveSpecMasks* specMasks;
+        uint64_t specMasksOffset;
+    };
 };
 
 static constexpr Shading INVALID_SHADING_MODEL = (Shading) 0xff;
@@ -72,6 +107,24 @@ struct ArchiveFlag {
     ArchiveFeature value;
 };
 
+// Open-addressing hash table (linear probing) that maps a feature flag name to a bit index.
+// Empty buckets have a null name.
+struct ArchiveFeatureBucket {
+    union {
+        const char* name;
+        uint64_t nameOffset;
+    };
+    uint32_t hash;
+    uint32_t bit;
+};
+
+// For each spec, the set of features it supports (OPTIONAL or REQUIRED) and the set of features
+// it requires, as bitmasks indexed by the feature index.
+struct ArchiveSpecMasks {
+    uint64_t supported;
+    uint64_t required;
+};
+
 UTILS_WARNING_POP
 
 } // namespace filament::uberz
@@ -40,7 +40,10 @@ public:
 
     void addMaterial(const char* name, const uint8_t* package, size_t packageSize);
     void addSpecLine(std::string_view line);
-    utils::FixedCapacityVector<uint8_t> serialize() const;
+
+    // Serializes the archive, compressed with zstd by default. An uncompressed archive is larger
+    // but can be used in place by gltfio, e.g. straight from a memory-mapped file.
+    utils::FixedCapacityVector<uint8_t> serialize(bool compress = true) const;
 
     // Low-level alternatives to addSpecLine that do not involve parsing:
     void setShadingModel(Shading sm);
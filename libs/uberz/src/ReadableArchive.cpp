@@ -17,15 +17,20 @@
 #include <uberz/ReadableArchive.h>
 
 #include <utils/debug.h>
+#include <utils/Hash.h>
+
+#include <string.h>
 
 using namespace filament;
 using namespace utils;
 
 namespace filament::uberz {
 
-static_assert(sizeof(ReadableArchive) == 4 + 4 + 8 + 8);
+static_assert(sizeof(ReadableArchive) == 4 + 4 + 8 + 8 + 8 + 8 + 8);
 static_assert(sizeof(ArchiveSpec) == 1 + 1 + 2 + 4 + 8 + 8);
 static_assert(sizeof(ArchiveFlag) == 8 + 8);
+static_assert(sizeof(ArchiveFeatureBucket) == 8 + 4 + 4);
+static_assert(sizeof(ArchiveSpecMasks) == 8 + 8);
 
 void convertOffsetsToPointers(ReadableArchive* archive) {
     constexpr size_t wordSize = sizeof(uint64_t);
@@ -42,6 +47,42 @@ void convertOffsetsToPointers(ReadableArchive* archive) {
             flag.name = ((const char*) basePointer) + flag.nameOffset;
         }
     }
+    // Version 0 archives have a shorter header, the following fields do not exist.
+    if (archive->version < 1) {
+        return;
+    }
+    archive->specMasks = (ArchiveSpecMasks*) (basePointer + archive->specMasksOffset / wordSize);
+    archive->featureBuckets = (ArchiveFeatureBucket*)
+            (basePointer + archive->featureBucketsOffset / wordSize);
+    for (uint64_t i = 0; i < archive->featureBucketCount; ++i) {
+        ArchiveFeatureBucket& bucket = archive->featureBuckets[i];
+        if (bucket.nameOffset) {
+            bucket.name = ((const char*) basePointer) + bucket.nameOffset;
+        }
+    }
+}
+
+uint32_t hashFeatureName(const char* name, size_t length) noexcept {
+    return utils::hash::murmurSlow((const uint8_t*) name, length, 0);
+}
+
+int findFeatureBit(ReadableArchive const* archive, const char* name, size_t length) noexcept {
+    if (archive->version < 1 || archive->featureBucketCount == 0) {
+        return -1;
+    }
+    auto const* buckets = resolveOffset<ArchiveFeatureBucket>(archive,
+            archive->featureBucketsOffset);
+    uint64_t const mask = archive->featureBucketCount - 1;
+    uint32_t const hash = hashFeatureName(name, length);
+    for (uint64_t i = hash & mask; buckets[i].nameOffset; i = (i + 1) & mask) {
+        if (buckets[i].hash == hash) {
+            const char* bucketName = resolveOffset<char>(archive, buckets[i].nameOffset);
+            if (strncmp(bucketName, name, length) == 0 && bucketName[length] == 0) {
+                return int(buckets[i].bit);
+            }
+        }
+    }
+    return -1;
 }
 
 } // namespace filament::uberz
@@ -224,11 +224,35 @@ void WritableArchive::addSpecLine(string_view line) {
     ++mLineNumber;
 }
 
-FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
+FixedCapacityVector<uint8_t> WritableArchive::serialize(bool compress) const {
+    // Gather the distinct feature names, they are indexed by the order in which they're found.
+    tsl::robin_map<std::string_view, uint32_t> featureBits;
+    for (const auto& mat : mMaterials) {
+        for (const auto& pair : mat.flags) {
+            featureBits.emplace(std::string_view{ pair.first.c_str(), pair.first.size() },
+                    uint32_t(featureBits.size()));
+        }
+    }
+
+    // The feature index is not emitted if there are too many features to fit in the masks, in
+    // which case clients fall back to matching the flags by name.
+    size_t featureBucketCount = 0;
+    if (featureBits.size() <= MAX_INDEXED_FEATURES) {
+        // keep the load factor under 0.5 so that probe sequences are short
+        featureBucketCount = 1;
+        while (featureBucketCount < featureBits.size() * 2) {
+            featureBucketCount *= 2;
+        }
+    }
+
     size_t byteCount = sizeof(ReadableArchive);
     for (const auto& mat : mMaterials) {
         byteCount += sizeof(ArchiveSpec);
     }
+    size_t specMasksOffset = byteCount;
+    byteCount += sizeof(ArchiveSpecMasks) * mMaterials.size();
+    size_t featureBucketsOffset = byteCount;
+    byteCount += sizeof(ArchiveFeatureBucket) * featureBucketCount;
     size_t flaglistOffset = byteCount;
     for (const auto& mat : mMaterials) {
         for (const auto& pair : mat.flags) {
@@ -246,13 +270,17 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
         byteCount += mat.package.size();
     }
 
-    ReadableArchive archive;
-    archive.magic = 'UBER';
-    archive.version = 0;
+    ReadableArchive archive = {};
+    archive.magic = ARCHIVE_MAGIC;
+    archive.version = ARCHIVE_VERSION;
     archive.specsCount = mMaterials.size();
     archive.specsOffset = sizeof(ReadableArchive);
+    archive.featureBucketCount = featureBucketCount;
+    archive.featureBucketsOffset = featureBucketsOffset;
+    archive.specMasksOffset = specMasksOffset;
 
     auto specs = FixedCapacityVector<ArchiveSpec>::with_capacity(mMaterials.size());
+    auto specMasks = FixedCapacityVector<ArchiveSpecMasks>::with_capacity(mMaterials.size());
     size_t flagCount = 0;
     for (const auto& mat : mMaterials) {
         ArchiveSpec spec = {};
@@ -265,8 +293,24 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
         specs.push_back(spec);
         filamatOffset += mat.package.size();
         flagCount += mat.flags.size();
+
+        ArchiveSpecMasks masks = {};
+        if (featureBucketCount) {
+            for (const auto& pair : mat.flags) {
+                const uint64_t bit = uint64_t(1) << featureBits[{ pair.first.c_str(),
+                        pair.first.size() }];
+                if (pair.second != ArchiveFeature::UNSUPPORTED) {
+                    masks.supported |= bit;
+                }
+                if (pair.second == ArchiveFeature::REQUIRED) {
+                    masks.required |= bit;
+                }
+            }
+        }
+        specMasks.push_back(masks);
     }
 
+    auto featureBuckets = FixedCapacityVector<ArchiveFeatureBucket>(featureBucketCount);
     auto flags = FixedCapacityVector<ArchiveFlag>::with_capacity(flagCount);
     size_t charCount = 0;
     for (const auto& mat : mMaterials) {
@@ -276,6 +320,19 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
             flag.value = pair.second;
             charCount += pair.first.size() + 1;
             flags.push_back(flag);
+
+            // The feature index references the first occurrence of each name.
+            if (featureBucketCount) {
+                const uint32_t hash = hashFeatureName(pair.first.c_str(), pair.first.size());
+                const uint32_t bit = featureBits[{ pair.first.c_str(), pair.first.size() }];
+                size_t i = hash & (featureBucketCount - 1);
+                while (featureBuckets[i].nameOffset && featureBuckets[i].bit != bit) {
+                    i = (i + 1) & (featureBucketCount - 1);
+                }
+                if (!featureBuckets[i].nameOffset) {
+                    featureBuckets[i] = { { .nameOffset = flag.nameOffset }, hash, bit };
+                }
+            }
         }
     }
 
@@ -295,6 +352,10 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
     writeCursor += sizeof(archive);
     memcpy(writeCursor, specs.data(), sizeof(ArchiveSpec) * specs.size());
     writeCursor += sizeof(ArchiveSpec) * specs.size();
+    memcpy(writeCursor, specMasks.data(), sizeof(ArchiveSpecMasks) * specMasks.size());
+    writeCursor += sizeof(ArchiveSpecMasks) * specMasks.size();
+    memcpy(writeCursor, featureBuckets.data(), sizeof(ArchiveFeatureBucket) * featureBucketCount);
+    writeCursor += sizeof(ArchiveFeatureBucket) * featureBucketCount;
     memcpy(writeCursor, flags.data(), sizeof(ArchiveFlag) * flags.size());
     writeCursor += sizeof(ArchiveFlag) * flags.size();
     memcpy(writeCursor, flagNames.data(), charCount);
@@ -305,6 +366,10 @@ FixedCapacityVector<uint8_t> WritableArchive::serialize() const {
     }
     assert_invariant(writeCursor - outputBuf.data() == outputBuf.size());
 
+    if (!compress) {
+        return outputBuf;
+    }
+
     FixedCapacityVector<uint8_t> compressedBuf(ZSTD_compressBound(outputBuf.size()));
 
     // Maximum zstd compression is slow, but that's okay since uberz is invoked during the build,
@@ -21,6 +21,9 @@
 
 #include <benchmark/benchmark.h>
 
+#include <functional>
+#include <vector>
+
 using namespace utils;
 
 
@@ -78,7 +81,91 @@ static void BM_JobSystemParallelFor(benchmark::State& state) {
     js.emancipate();
 }
 
+// The two benchmarks below mimic the parallel_for() of RenderPass::appendCommands() and
+// FScene::prepare(), with their CountSplitter, and a few items worth of work for each index.
+
+struct alignas(8) Command {
+    uint64_t key;
+    uint32_t index;
+    float distance;
+};
+
+template<typename Splitter>
+static void BM_JobSystemParallelForCommands(benchmark::State& state) {
+    JobSystem js;
+    js.adopt();
+
+    uint32_t const count = uint32_t(state.range(0));
+    std::vector<float> positions(count);
+    for (uint32_t i = 0; i < count; i++) {
+        positions[i] = float(i % 1024) * 0.5f;
+    }
+    std::vector<Command> commands(count * 2);
+
+    auto work = [&](uint32_t start, uint32_t c) {
+        for (uint32_t i = start; i < start + c; i++) {
+            float const distance = positions[i] * positions[i] + 1.0f;
+            uint64_t const key = (uint64_t(i & 0xFF) << 32u) | uint32_t(distance);
+            commands[i * 2 + 0] = { key, i, distance };
+            commands[i * 2 + 1] = { key | (1ull << 63u), i, -distance };
+        }
+    };
+
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            if (count <= 2048) {
+                work(0, count);
+            } else {
+                js.runAndWait(jobs::parallel_for(js, nullptr, 0, count,
+                        std::cref(work), Splitter()));
+            }
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * count);
+
+    js.emancipate();
+}
+
+template<typename Splitter>
+static void BM_JobSystemParallelForTransforms(benchmark::State& state) {
+    JobSystem js;
+    js.adopt();
+
+    uint32_t const count = uint32_t(state.range(0));
+    std::vector<float> transforms(count * 16, 1.0f);
+    std::vector<float> worlds(count * 16);
+
+    auto work = [&](uint32_t start, uint32_t c) {
+        for (uint32_t i = start; i < start + c; i++) {
+            float const* UTILS_RESTRICT m = transforms.data() + i * 16;
+            float* UTILS_RESTRICT w = worlds.data() + i * 16;
+            for (size_t j = 0; j < 16; j++) {
+                w[j] = m[j & 3] * m[4 + (j >> 2)] + m[8 + (j & 3)] * m[12 + (j >> 2)];
+            }
+        }
+    };
+
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            js.runAndWait(jobs::parallel_for(js, nullptr, 0, count,
+                    std::cref(work), Splitter()));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * count);
+
+    js.emancipate();
+}
 
 BENCHMARK(BM_JobSystem);
 BENCHMARK(BM_JobSystemAsChildren4k);
 BENCHMARK(BM_JobSystemParallelFor);
+
+BENCHMARK_TEMPLATE(BM_JobSystemParallelForCommands, jobs::CountSplitter<2048, 5>)
+        ->Range(1024, 256 * 1024);
+
+BENCHMARK_TEMPLATE(BM_JobSystemParallelForTransforms, jobs::CountSplitter<128, 5>)
+        ->Range(64, 64 * 1024);
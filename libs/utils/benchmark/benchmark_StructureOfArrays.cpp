@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerformanceCounters.h"
+
+#include <utils/JobSystem.h>
+#include <utils/StructureOfArrays.h>
+#include <utils/StructureOfArraysJobs.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace utils;
+
+// Roughly the shape of FScene's RenderableSoa: a sort key and a few fields of various sizes.
+
+struct Bounds {
+    float center[3];
+    float extent[3];
+};
+
+using Soa = StructureOfArrays<
+        uint32_t,   // sort key
+        Bounds,
+        uint64_t,
+        uint16_t,
+        uint8_t>;
+
+static constexpr size_t ROW_COUNT = 1024 * 1024;
+
+static void fill(Soa& soa, std::vector<uint32_t> const& keys) {
+    soa.clear();
+    for (uint32_t i = 0, c = uint32_t(keys.size()); i < c; i++) {
+        soa.push_back_unsafe(keys[i], Bounds{}, uint64_t(i), uint16_t(i), uint8_t(i));
+    }
+}
+
+static std::vector<uint32_t> randomKeys(size_t count) {
+    std::vector<uint32_t> keys(count);
+    std::mt19937 gen(42);
+    std::generate(keys.begin(), keys.end(), [&gen]() { return uint32_t(gen()); });
+    return keys;
+}
+
+static std::vector<uint32_t> randomOrder(size_t count) {
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+    return order;
+}
+
+// sorting whole structures through the SoA iterators, i.e.: what std::sort() does today
+static void BM_SoaSortIterator(benchmark::State& state) {
+    std::vector<uint32_t> const keys = randomKeys(ROW_COUNT);
+    Soa soa(ROW_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            state.PauseTiming();
+            fill(soa, keys);
+            state.ResumeTiming();
+            std::sort(soa.begin(), soa.end(), [](auto const& lhs, auto const& rhs) {
+                return lhs.template get<0>() < rhs.template get<0>();
+            });
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+}
+
+static void BM_SoaSortParallel(benchmark::State& state) {
+    JobSystem js;
+    js.adopt();
+
+    std::vector<uint32_t> const keys = randomKeys(ROW_COUNT);
+    Soa soa(ROW_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            state.PauseTiming();
+            fill(soa, keys);
+            state.ResumeTiming();
+            jobs::sort<0>(js, soa);
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+
+    js.emancipate();
+}
+
+static void BM_SoaPermute(benchmark::State& state) {
+    std::vector<uint32_t> const order = randomOrder(ROW_COUNT);
+    Soa soa(ROW_COUNT);
+    fill(soa, order);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            soa.permute(order.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+}
+
+static void BM_SoaPermuteParallel(benchmark::State& state) {
+    JobSystem js;
+    js.adopt();
+
+    std::vector<uint32_t> const order = randomOrder(ROW_COUNT);
+    Soa soa(ROW_COUNT);
+    fill(soa, order);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            jobs::permute(js, soa, order.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+
+    js.emancipate();
+}
+
+// gathering a structure at a time through the SoA iterators
+static void BM_SoaGatherIterator(benchmark::State& state) {
+    std::vector<uint32_t> const order = randomOrder(ROW_COUNT);
+    Soa src(ROW_COUNT);
+    Soa dst(ROW_COUNT);
+    fill(src, order);
+    dst.resize(ROW_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            auto s = src.begin();
+            auto d = dst.begin();
+            for (size_t i = 0; i < ROW_COUNT; i++) {
+                d[i] = s[order[i]];
+            }
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+}
+
+static void BM_SoaGather(benchmark::State& state) {
+    std::vector<uint32_t> const order = randomOrder(ROW_COUNT);
+    Soa src(ROW_COUNT);
+    Soa dst(ROW_COUNT);
+    fill(src, order);
+    dst.resize(ROW_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            dst.gather(src, order.data(), 0, ROW_COUNT);
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+}
+
+static void BM_SoaGatherParallel(benchmark::State& state) {
+    JobSystem js;
+    js.adopt();
+
+    std::vector<uint32_t> const order = randomOrder(ROW_COUNT);
+    Soa src(ROW_COUNT);
+    Soa dst(ROW_COUNT);
+    fill(src, order);
+    dst.resize(ROW_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            js.runAndWait(jobs::gather(js, nullptr, dst, src, order.data(), ROW_COUNT));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+
+    js.emancipate();
+}
+
+static void BM_SoaScatterParallel(benchmark::State& state) {
+    JobSystem js;
+    js.adopt();
+
+    std::vector<uint32_t> const order = randomOrder(ROW_COUNT);
+    Soa src(ROW_COUNT);
+    Soa dst(ROW_COUNT);
+    fill(src, order);
+    dst.resize(ROW_COUNT);
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            js.runAndWait(jobs::scatter(js, nullptr, dst, src, order.data(), ROW_COUNT));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed((int64_t)state.iterations() * ROW_COUNT);
+
+    js.emancipate();
+}
+
+BENCHMARK(BM_SoaSortIterator)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SoaSortParallel)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SoaPermute)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SoaPermuteParallel)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SoaGatherIterator)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SoaGather)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SoaGatherParallel)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SoaScatterParallel)->Unit(benchmark::kMillisecond);
@@ -39,6 +39,26 @@ protected:
     utils::Arena<utils::ObjectPoolAllocator<Payload>, std::mutex> mPoolAllocatorStdMutex;
     utils::Arena<utils::ObjectPoolAllocator<Payload>, utils::Mutex> mPoolAllocatorUtilsMutex;
     utils::Arena<utils::ThreadSafeObjectPoolAllocator<Payload>, LockingPolicy::NoLock> mPoolAllocatorAtomic;
+    utils::Arena<utils::ThreadCachedObjectPoolAllocator<Payload>, LockingPolicy::NoLock> mPoolAllocatorThreadCached;
+
+    // allocates a batch of objects then frees them, like jobs generating commands do
+    template<typename ARENA>
+    static void allocateBatches(ARENA& pool, benchmark::State& state) {
+        Payload* batch[BATCH_SIZE];
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            for (auto& p : batch) {
+                p = pool.template alloc<Payload>(1);
+            }
+            benchmark::ClobberMemory();
+            for (auto p : batch) {
+                pool.free(p);
+            }
+        }
+        state.SetItemsProcessed((int64_t)state.iterations() * BATCH_SIZE);
+    }
+
+    static constexpr size_t BATCH_SIZE = 32;
 };
 
 static constexpr size_t POOL_ITEM_COUNT = 4096;
@@ -47,7 +67,8 @@ Allocators::Allocators()
         : mPoolAllocatorNoLock("nolock", POOL_ITEM_COUNT * sizeof(Payload)),
           mPoolAllocatorStdMutex("std::mutex", POOL_ITEM_COUNT * sizeof(Payload)),
           mPoolAllocatorUtilsMutex("utils::Mutex", POOL_ITEM_COUNT * sizeof(Payload)),
-          mPoolAllocatorAtomic("atomic", POOL_ITEM_COUNT * sizeof(Payload)) {
+          mPoolAllocatorAtomic("atomic", POOL_ITEM_COUNT * sizeof(Payload)),
+          mPoolAllocatorThreadCached("thread cached", POOL_ITEM_COUNT * sizeof(Payload)) {
 }
 
 Allocators::~Allocators() = default;
@@ -99,3 +120,40 @@ BENCHMARK_REGISTER_F(Allocators, poolAllocator_utils_mutex)
 BENCHMARK_REGISTER_F(Allocators, poolAllocator_atomic)
         ->ThreadRange(1, 4)
         ->Threads(benchmark::CPUInfo::Get().num_cpus * 2);
+
+BENCHMARK_DEFINE_F(Allocators, poolAllocator_thread_cached)(benchmark::State& state) {
+    auto& pool = mPoolAllocatorThreadCached;
+    PerformanceCounters pc(state);
+    for (auto _ : state) {
+        Payload* p = pool.alloc<Payload>(1);
+        pool.free(p);
+    }
+}
+
+BENCHMARK_DEFINE_F(Allocators, poolAllocatorBatch_utils_mutex)(benchmark::State& state) {
+    allocateBatches(mPoolAllocatorUtilsMutex, state);
+}
+
+BENCHMARK_DEFINE_F(Allocators, poolAllocatorBatch_atomic)(benchmark::State& state) {
+    allocateBatches(mPoolAllocatorAtomic, state);
+}
+
+BENCHMARK_DEFINE_F(Allocators, poolAllocatorBatch_thread_cached)(benchmark::State& state) {
+    allocateBatches(mPoolAllocatorThreadCached, state);
+}
+
+BENCHMARK_REGISTER_F(Allocators, poolAllocator_thread_cached)
+        ->ThreadRange(1, 4)
+        ->Threads(benchmark::CPUInfo::Get().num_cpus * 2);
+
+BENCHMARK_REGISTER_F(Allocators, poolAllocatorBatch_utils_mutex)
+        ->ThreadRange(1, 4)
+        ->Threads(benchmark::CPUInfo::Get().num_cpus * 2);
+
+BENCHMARK_REGISTER_F(Allocators, poolAllocatorBatch_atomic)
+        ->ThreadRange(1, 4)
+        ->Threads(benchmark::CPUInfo::Get().num_cpus * 2);
+
+BENCHMARK_REGISTER_F(Allocators, poolAllocatorBatch_thread_cached)
+        ->ThreadRange(1, 4)
+        ->Threads(benchmark::CPUInfo::Get().num_cpus * 2);
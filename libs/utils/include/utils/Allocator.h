@@ -17,6 +17,7 @@
 #ifndef TNT_UTILS_ALLOCATOR_H
 #define TNT_UTILS_ALLOCATOR_H
 
+#include <utils/architecture.h>
 #include <utils/compiler.h>
 #include <utils/debug.h>
 #include <utils/memalign.h>
@@ -24,6 +25,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 
@@ -364,6 +366,102 @@ private:
     Node* mStorage = nullptr;
 };
 
+/*
+ * A thread-safe free list with a small cache of free elements (a magazine) per thread, in front
+ * of a shared FreeList. Threads allocate from and free to their own magazine without touching
+ * any shared cache line; the shared list is only locked to refill or drain half a magazine at
+ * a time. When the shared list runs out, elements cached by other threads are taken.
+ *
+ * Threads are mapped to magazines by their index modulo MAGAZINE_COUNT. When two threads
+ * sharing a magazine race for it, the loser uses the shared list directly.
+ *
+ * Unlike AtomicFreeList, this is movable, but not lock-free.
+ */
+class ThreadCachedFreeList {
+public:
+    static constexpr size_t MAGAZINE_COUNT = 16;
+    static constexpr size_t MAGAZINE_CAPACITY = 32;
+
+    ThreadCachedFreeList() noexcept = default;
+    ThreadCachedFreeList(void* begin, void* end,
+            size_t elementSize, size_t alignment, size_t extra) noexcept;
+    ThreadCachedFreeList(const ThreadCachedFreeList& rhs) = delete;
+    ThreadCachedFreeList& operator=(const ThreadCachedFreeList& rhs) = delete;
+    ThreadCachedFreeList(ThreadCachedFreeList&& rhs) noexcept = default;
+    ThreadCachedFreeList& operator=(ThreadCachedFreeList&& rhs) noexcept = default;
+    ~ThreadCachedFreeList() noexcept;
+
+    void* pop() noexcept {
+        assert_invariant(mState);
+        Magazine& magazine = getMagazine();
+        if (UTILS_LIKELY(magazine.tryLock())) {
+            if (UTILS_UNLIKELY(!magazine.count)) {
+                refill(magazine);
+            }
+            void* const p = magazine.count ? magazine.items[--magazine.count] : nullptr;
+            magazine.unlock();
+            if (UTILS_LIKELY(p)) {
+                return p;
+            }
+        }
+        return popSlow();
+    }
+
+    void push(void* p) noexcept {
+        assert_invariant(p);
+        assert_invariant(mState);
+        Magazine& magazine = getMagazine();
+        if (UTILS_LIKELY(magazine.tryLock())) {
+            if (UTILS_UNLIKELY(magazine.count == MAGAZINE_CAPACITY)) {
+                drain(magazine);
+            }
+            magazine.items[magazine.count++] = p;
+            magazine.unlock();
+            return;
+        }
+        pushSlow(p);
+    }
+
+    void* getFirst() noexcept;
+
+    using Node = FreeList::Node;
+
+private:
+    struct alignas(CACHELINE_SIZE) Magazine {
+        std::atomic<bool> locked{ false };
+        uint32_t count = 0;
+        void* items[MAGAZINE_CAPACITY];
+
+        bool tryLock() noexcept {
+            return !locked.exchange(true, std::memory_order_acquire);
+        }
+        void unlock() noexcept {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    struct State {
+        Magazine magazines[MAGAZINE_COUNT];
+        Mutex lock;
+        FreeList freeList;
+    };
+
+    Magazine& getMagazine() noexcept {
+        return mState->magazines[getThreadIndex() % MAGAZINE_COUNT];
+    }
+
+    static uint32_t getThreadIndex() noexcept;
+
+    // these are called with the magazine locked
+    void refill(Magazine& magazine) noexcept;
+    void drain(Magazine& magazine) noexcept;
+
+    void* popSlow() noexcept;
+    void pushSlow(void* p) noexcept;
+
+    std::unique_ptr<State> mState;
+};
+
 // ------------------------------------------------------------------------------------------------
 
 template <
@@ -434,6 +532,10 @@ template <typename T, size_t OFFSET = 0>
 using ThreadSafeObjectPoolAllocator = PoolAllocator<sizeof(T),
         UTILS_MAX(alignof(FreeList), alignof(T)), OFFSET, AtomicFreeList>;
 
+template <typename T, size_t OFFSET = 0>
+using ThreadCachedObjectPoolAllocator = PoolAllocator<sizeof(T),
+        UTILS_MAX(alignof(FreeList), alignof(T)), OFFSET, ThreadCachedFreeList>;
+
 
 // ------------------------------------------------------------------------------------------------
 // Areas
@@ -561,6 +663,8 @@ struct HighWatermark {
     void onReset() noexcept;
     void onRewind(void const* addr) noexcept;
     uint32_t getHighWatermark() const noexcept { return mHighWaterMark; }
+    // restarts tracking the high watermark from the current usage, e.g. at the start of a frame
+    void resetHighWatermark() noexcept { mHighWaterMark = mCurrent; }
 protected:
     const char* mName = nullptr;
     void* mBase = nullptr;
@@ -588,6 +692,8 @@ struct DebugAndHighWatermark : protected HighWatermark, protected Debug {
     DebugAndHighWatermark() noexcept = default;
     DebugAndHighWatermark(const char* name, void* base, size_t size) noexcept
             : HighWatermark(name, base, size), Debug(name, base, size) { }
+    using HighWatermark::getHighWatermark;
+    using HighWatermark::resetHighWatermark;
     void onAlloc(void* p, size_t size, size_t alignment, size_t extra) noexcept {
         HighWatermark::onAlloc(p, size, alignment, extra);
         Debug::onAlloc(p, size, alignment, extra);
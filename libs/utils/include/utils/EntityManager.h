@@ -20,6 +20,8 @@
 #include <utils/Entity.h>
 #include <utils/compiler.h>
 
+#include <atomic>
+
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -41,6 +43,7 @@ public:
     // Thread Safe.
     static EntityManager& get() noexcept;
 
+    // Listeners are called by destroy(), on the calling thread, with the entities it destroyed.
     class Listener {
     public:
         virtual void onEntitiesDestroyed(size_t n, Entity const* entities) noexcept = 0;
@@ -57,10 +60,11 @@ public:
     // number of active Entities
     size_t getEntityCount() const noexcept;
 
-    // Create n entities. Thread safe.
+    // Create n entities. Thread safe and lock-free.
+    // Entities that can't be allocated are set to the null Entity.
     void create(size_t n, Entity* entities);
 
-    // destroys n entities. Thread safe.
+    // destroys n entities. Thread safe and lock-free, unless listeners are registered.
     void destroy(size_t n, Entity* entities) noexcept;
 
     // Create a new Entity. Thread safe.
@@ -80,7 +84,8 @@ public:
     // Thread safe.
     bool isAlive(Entity e) const noexcept {
         assert(getIndex(e) < RAW_INDEX_COUNT);
-        return (!e.isNull()) && (getGeneration(e) == mGens[getIndex(e)]);
+        return (!e.isNull()) &&
+                (getGeneration(e) == mGens[getIndex(e)].load(std::memory_order_relaxed));
     }
 
     // Registers a listener to be called when an entity is destroyed. Thread safe.
@@ -95,7 +100,7 @@ public:
 
     // current generation of the given index. Use for debugging and testing.
     uint8_t getGenerationForIndex(size_t index) const noexcept {
-        return mGens[index];
+        return mGens[index].load(std::memory_order_relaxed);
     }
 
     // singleton, can't be copied
@@ -129,7 +134,7 @@ private:
     }
 
     // stores the generation of each index.
-    uint8_t * const mGens;
+    std::atomic<uint8_t>* const mGens;
 };
 
 } // namespace utils
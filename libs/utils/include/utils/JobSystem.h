@@ -32,6 +32,7 @@
 
 #include <atomic>
 #include <functional>
+#include <initializer_list>
 #include <mutex>
 #include <type_traits>
 #include <thread>
@@ -53,6 +54,19 @@ public:
 
     using JobFunc = void(*)(void*, JobSystem&, Job*);
 
+    /*
+     * Each thread has a queue per priority, and runs or steals the jobs of a higher priority
+     * queue first. This allows latency-critical per-frame work to share the JobSystem with
+     * long-running background work, e.g. asset streaming.
+     */
+    enum class JobPriority : uint8_t {
+        CRITICAL,       // latency-critical per-frame work, e.g. culling
+        NORMAL,         // default
+        BACKGROUND,     // work that can be delayed, e.g. texture decoding
+    };
+
+    static constexpr size_t JOB_PRIORITY_COUNT = 3;
+
     class alignas(CACHELINE_SIZE) Job {
     public:
         Job() noexcept {} /* = default; */ /* clang bug */ // NOLINT(modernize-use-equals-default,cppcoreguidelines-pro-type-member-init)
@@ -77,7 +91,8 @@ public:
         uint16_t parent;                                        //  2 |  2
         std::atomic<uint16_t> runningJobCount = { 1 };          //  2 |  2
         mutable std::atomic<uint16_t> refCount = { 1 };         //  2 |  2
-                                                                //  6 |  2 (padding)
+        JobPriority priority;                                   //  1 |  1
+                                                                //  5 |  1 (padding)
                                                                 // 64 | 64
     };
 
@@ -215,6 +230,15 @@ public:
     }
 
 
+    /*
+     * Sets the priority of a job. Jobs get the priority of their parent when they're created, or
+     * JobPriority::NORMAL if they don't have one, so this is typically called on a parent job
+     * before creating its children.
+     *
+     * Never use this once a flavor of run() has been called.
+     */
+    void setPriority(Job* job, JobPriority priority) noexcept;
+
     /*
      * Jobs are normally finished automatically, this can be used to cancel a job before it is run.
      *
@@ -255,6 +279,33 @@ public:
         run(p);
     }
 
+    /*
+     * Runs a job once all the given jobs have finished -- i.e. they and all their children have
+     * completed -- without blocking any thread. This allows work to be expressed as a graph of
+     * jobs, e.g.:
+     *
+     *   Job* a = js.createJob(parent, ...);
+     *   Job* c = js.createJob(parent, ...);
+     *   Job* b = js.createJob(parent, ...);
+     *   js.runAfter(b, { a, c });   // b will run once both a and c have finished
+     *   js.run(a);
+     *   js.run(c);
+     *   js.runAndWait(parent);
+     *
+     * The dependencies must not have been run yet, a flavor of run() must be called on them after
+     * this call (or they must be cancelled). Like with run(), the job can't be used after this
+     * call, use retain() beforehand to wait on it.
+     * Current thread must be owned by JobSystem's thread pool. See adopt().
+     */
+    void runAfter(Job*& job, Job* const* dependencies, size_t count) noexcept;
+    void runAfter(Job*& job, std::initializer_list<Job*> dependencies) noexcept {
+        runAfter(job, dependencies.begin(), dependencies.size());
+    }
+    void runAfter(Job*&& job, std::initializer_list<Job*> dependencies) noexcept {
+        Job* p = job;
+        runAfter(p, dependencies.begin(), dependencies.size());
+    }
+
     void signal() noexcept;
 
     /*
@@ -327,8 +378,8 @@ private:
     };
 
     struct alignas(CACHELINE_SIZE) ThreadState {    // this causes 40-bytes padding
-        // make sure storage is cache-line aligned
-        WorkQueue workQueue;
+        // make sure storage is cache-line aligned, one queue per JobPriority
+        WorkQueue workQueues[JOB_PRIORITY_COUNT];
 
         // these are not accessed by the worker threads
         alignas(CACHELINE_SIZE)     // this causes 56-bytes padding
@@ -341,6 +392,20 @@ private:
     static_assert(sizeof(ThreadState) % CACHELINE_SIZE == 0,
             "ThreadState doesn't align to a cache line");
 
+    // a job to run once one of its dependencies has finished
+    struct Continuation {
+        Job* job;
+        Continuation* next;
+    };
+
+    // state used by runAfter(), for each job of the pool
+    struct JobLinks {
+        // jobs depending on this one, only accessed before this job runs and after it finished
+        Continuation* continuations = nullptr;
+        // number of jobs this one is waiting on
+        std::atomic<uint16_t> dependencies = { 0 };
+    };
+
     ThreadState& getState() noexcept;
 
     void incRef(Job const* job) noexcept;
@@ -357,11 +422,12 @@ private:
     void loop(ThreadState* state) noexcept;
     bool execute(JobSystem::ThreadState& state) noexcept;
     Job* steal(JobSystem::ThreadState& state) noexcept;
-    void finish(Job* job) noexcept;
+    void finish(Job* job, ThreadState* state = nullptr) noexcept;
+    void runContinuations(JobLinks& links, ThreadState* state) noexcept;
 
-    void put(WorkQueue& workQueue, Job* job) noexcept;
-    Job* pop(WorkQueue& workQueue) noexcept;
-    Job* steal(WorkQueue& workQueue) noexcept;
+    void put(ThreadState& state, Job* job) noexcept;
+    Job* pop(ThreadState& state) noexcept;
+    Job* stealFrom(ThreadState& stateToStealFrom) noexcept;
 
     void wait(std::unique_lock<Mutex>& lock, Job* job = nullptr) noexcept;
     void wakeAll() noexcept;
@@ -372,7 +438,8 @@ private:
     utils::Condition mWaiterCondition;
 
     std::atomic<uint32_t> mActiveJobs = { 0 };
-    utils::Arena<utils::ThreadSafeObjectPoolAllocator<Job>, LockingPolicy::NoLock> mJobPool;
+    utils::Arena<utils::ThreadCachedObjectPoolAllocator<Job>, LockingPolicy::NoLock> mJobPool;
+    utils::Arena<utils::ThreadCachedObjectPoolAllocator<Continuation>, LockingPolicy::NoLock> mContinuationPool;
 
     template <typename T>
     using aligned_vector = std::vector<T, utils::STLAlignedAllocator<T>>;
@@ -388,6 +455,7 @@ private:
     std::atomic<bool> mExitRequested = { false };       // this one is almost never written
     std::atomic<uint16_t> mAdoptedThreads = { 0 };      // this one is almost never written
     Job* const mJobStorageBase;                         // Base for conversion to indices
+    std::vector<JobLinks> mJobLinks;                    // indexed like the jobs
     uint16_t mThreadCount = 0;                          // total # of threads in the pool
     uint8_t mParallelSplitCount = 0;                    // # of split allowable in parallel_for
     Job* mRootJob = nullptr;
@@ -25,6 +25,8 @@
 
 #include <tsl/robin_map.h>
 
+#include <algorithm>
+
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -253,6 +255,40 @@ protected:
         }
     }
 
+    /*
+     * Removes the components of dead entities, scanning at most maxScanned components starting
+     * where the previous call stopped, so that all components are visited after enough calls.
+     * removeComponent(Entity) must remove the entity's component.
+     * Returns the number of components removed.
+     */
+    template<typename REMOVE>
+    size_t incrementalGc(const EntityManager& em, size_t maxScanned,
+            REMOVE&& removeComponent) noexcept {
+        Entity const* const pEntities = begin<ENTITY_INDEX>();
+        size_t count = getComponentCount();
+        size_t cursor = mGcCursor;
+        size_t removed = 0;
+        UTILS_NOUNROLL
+        for (size_t n = std::min(maxScanned, count); n; n--) {
+            assert_invariant(count == getComponentCount());
+            if (UTILS_UNLIKELY(cursor >= count)) {
+                cursor = 0;
+            }
+            Entity const entity = pEntities[cursor];
+            assert_invariant(entity);
+            if (UTILS_LIKELY(em.isAlive(entity))) {
+                cursor++;
+                continue;
+            }
+            // this moves the last component at the cursor, which we'll check next
+            removeComponent(entity);
+            removed++;
+            count--;
+        }
+        mGcCursor = uint32_t(cursor);
+        return removed;
+    }
+
 protected:
     SoA mData;
 
@@ -260,6 +296,7 @@ private:
     // maps an entity to an instance index
     tsl::robin_map<Entity, Instance, Entity::Hasher> mInstanceMap;
     default_random_engine mRng;
+    uint32_t mGcCursor = 0;
 };
 
 // Keep these outside of the class because CLion has trouble parsing them
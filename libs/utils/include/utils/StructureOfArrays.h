@@ -476,6 +476,45 @@ public:
         return data<ElementIndex>()[size() - 1];
     }
 
+    /*
+     * Bulk operations below process the arrays one at a time, which is much more cache friendly
+     * than moving whole structures around. They work on a [first, last) range of indices so
+     * that they can be split across jobs, see utils/StructureOfArraysJobs.h.
+     */
+
+    // this[i] = src[indices[i]] for i in [first, last).
+    // This array must already be large enough and src must be a different array.
+    void gather(StructureOfArraysBase const& src, uint32_t const* indices,
+            size_t first, size_t last) noexcept {
+        assert_invariant(&src != this);
+        assert_invariant(last <= mSize);
+        gather(src, indices, first, last, std::make_index_sequence<kArrayCount>());
+    }
+
+    // this[indices[i]] = src[i] for i in [first, last).
+    // This array must already be large enough and src must be a different array. indices must
+    // not have duplicates if scatter() is called concurrently on several ranges.
+    void scatter(StructureOfArraysBase const& src, uint32_t const* indices,
+            size_t first, size_t last) noexcept {
+        assert_invariant(&src != this);
+        assert_invariant(last <= src.mSize);
+        scatter(src, indices, first, last, std::make_index_sequence<kArrayCount>());
+    }
+
+    // Reorders the arrays such that the new i-th element is the old order[i]-th element.
+    // order must be a permutation of [0, size()). This allocates a new buffer and moves each
+    // element exactly once.
+    UTILS_NOINLINE
+    void permute(uint32_t const* order) {
+        if (mSize) {
+            constexpr size_t align = std::max({ std::max(alignof(std::max_align_t), alignof(Elements))... });
+            void* buffer = mAllocator.alloc(getNeededSize(mCapacity), align);
+            auto const oldBuffer = std::get<0>(mArrays);
+            permute_each(buffer, order);
+            mAllocator.free(oldBuffer);
+        }
+    }
+
     template <size_t E, typename IndexType = uint32_t>
     struct Field {
         SoA& soa;
@@ -556,6 +595,32 @@ private:
         for_each_index<I + 1, FuncT, Tp...>(t, f);
     }
 
+    template<size_t ... Is>
+    void gather(StructureOfArraysBase const& src, uint32_t const* indices,
+            size_t first, size_t last, std::index_sequence<Is...>) noexcept {
+        // one array at a time
+        ([&]{
+            auto* const UTILS_RESTRICT d = std::get<Is>(mArrays);
+            auto const* const UTILS_RESTRICT s = std::get<Is>(src.mArrays);
+            for (size_t i = first; i < last; i++) {
+                d[i] = s[indices[i]];
+            }
+        }(), ...);
+    }
+
+    template<size_t ... Is>
+    void scatter(StructureOfArraysBase const& src, uint32_t const* indices,
+            size_t first, size_t last, std::index_sequence<Is...>) noexcept {
+        // one array at a time
+        ([&]{
+            auto* const UTILS_RESTRICT d = std::get<Is>(mArrays);
+            auto const* const UTILS_RESTRICT s = std::get<Is>(src.mArrays);
+            for (size_t i = first; i < last; i++) {
+                d[indices[i]] = s[i];
+            }
+        }(), ...);
+    }
+
     inline void resizeNoCheck(size_t needed) noexcept {
         assert_invariant(mCapacity >= needed);
         if (needed < mSize) {
@@ -657,6 +722,32 @@ private:
         });
     }
 
+    void permute_each(void* buffer, uint32_t const* UTILS_RESTRICT order) noexcept {
+        auto offsets = getOffsets(mCapacity);
+        size_t index = 0;
+        auto size = mSize;
+        forEach([buffer, order, &index, &offsets, size](auto p) {
+            using T = typename std::decay<decltype(*p)>::type;
+            T* UTILS_RESTRICT const arrayPointer =
+                    reinterpret_cast<T*>(uintptr_t(buffer) + offsets[index]);
+            // move each element to its new place, and destroy it from the old array
+            for (size_t i = 0; i < size; i++) {
+                assert_invariant(order[i] < size);
+                new(arrayPointer + i) T(std::move(p[order[i]]));
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    p[order[i]].~T();
+                }
+            }
+            index++;
+        });
+
+        // update the pointers
+        for_each(mArrays, [buffer, &offsets](size_t i, auto&& p) {
+            using Type = std::remove_reference_t<decltype(p)>;
+            p = Type((char*)buffer + offsets[i]);
+        });
+    }
+
     // capacity in array elements
     size_t mCapacity = 0;
     // size in array elements
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_STRUCTUREOFARRAYSJOBS_H
+#define TNT_UTILS_STRUCTUREOFARRAYSJOBS_H
+
+#include <utils/JobSystem.h>
+#include <utils/StructureOfArrays.h>
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Parallel versions of StructureOfArrays' bulk operations.
+ *
+ * Each job processes a range of elements one array at a time. The synchronous functions below
+ * (permute() and sort()) must be called from a thread owned by the JobSystem, see
+ * JobSystem::adopt().
+ */
+
+namespace utils {
+namespace jobs {
+
+namespace details {
+
+// runs f(0) ... f(count - 1) in parallel and waits for all of them to finish
+template<typename F>
+void runAndWaitEach(JobSystem& js, size_t count, F const& f) noexcept {
+    JobSystem::Job* root = js.createJob();
+    for (size_t i = 0; i < count; i++) {
+        JobSystem::Job* job = js.createJob(root, [&f, i](JobSystem&, JobSystem::Job*) { f(i); });
+        if (UTILS_LIKELY(job)) {
+            js.run(job);
+        } else {
+            // couldn't create a job, do the work here
+            f(i);
+        }
+    }
+    js.runAndWait(root);
+}
+
+} // namespace details
+
+// Returns a job that sets dst[i] = src[indices[i]], for i in [0, count).
+// dst must already have at least count elements.
+template<typename A, typename ... Elements, typename S = CountSplitter<4096, 5>>
+JobSystem::Job* gather(JobSystem& js, JobSystem::Job* parent,
+        StructureOfArraysBase<A, Elements...>& dst,
+        StructureOfArraysBase<A, Elements...> const& src,
+        uint32_t const* indices, uint32_t count, S const& splitter = S()) noexcept {
+    return parallel_for(js, parent, 0, count,
+            [&dst, &src, indices](uint32_t start, uint32_t c) {
+                dst.gather(src, indices, start, start + c);
+            }, splitter);
+}
+
+// Returns a job that sets dst[indices[i]] = src[i], for i in [0, count).
+// dst must be large enough, and indices must not have duplicates.
+template<typename A, typename ... Elements, typename S = CountSplitter<4096, 5>>
+JobSystem::Job* scatter(JobSystem& js, JobSystem::Job* parent,
+        StructureOfArraysBase<A, Elements...>& dst,
+        StructureOfArraysBase<A, Elements...> const& src,
+        uint32_t const* indices, uint32_t count, S const& splitter = S()) noexcept {
+    return parallel_for(js, parent, 0, count,
+            [&dst, &src, indices](uint32_t start, uint32_t c) {
+                dst.scatter(src, indices, start, start + c);
+            }, splitter);
+}
+
+// Reorders soa such that the new i-th element is the old order[i]-th element, in parallel.
+// order must be a permutation of [0, soa.size()). Unlike StructureOfArrays::permute(), this
+// copies the elements.
+template<typename A, typename ... Elements>
+void permute(JobSystem& js, StructureOfArraysBase<A, Elements...>& soa, uint32_t const* order) {
+    StructureOfArraysBase<A, Elements...> permuted(soa.capacity());
+    permuted.resize(soa.size());
+    js.runAndWait(gather(js, nullptr, permuted, soa, order, uint32_t(soa.size())));
+    soa = std::move(permuted);
+}
+
+// Sorts soa by its E-th array, in parallel. The sort is stable.
+// The keys are sorted along with their index in chunks, which are then merged. Finally, all the
+// arrays are permuted at once.
+template<size_t E, typename A, typename ... Elements, typename Compare = std::less<>>
+void sort(JobSystem& js, StructureOfArraysBase<A, Elements...>& soa, Compare comp = Compare()) {
+    using SoA = StructureOfArraysBase<A, Elements...>;
+    using Key = std::decay_t<typename SoA::template TypeAt<E>>;
+
+    // below this, splitting the sort isn't worth it
+    constexpr size_t MIN_CHUNK_SIZE = 16384;
+
+    struct Item {
+        Key key;
+        uint32_t index;
+    };
+
+    uint32_t const size = uint32_t(soa.size());
+    if (size < 2) {
+        return;
+    }
+
+    // ties are broken with the index, which makes the sort stable and any merge order valid
+    auto const less = [&comp](Item const& lhs, Item const& rhs) {
+        if (comp(lhs.key, rhs.key)) return true;
+        if (comp(rhs.key, lhs.key)) return false;
+        return lhs.index < rhs.index;
+    };
+
+    std::vector<Item> items(size);
+    std::vector<Item> merged(size);
+
+    // gather the keys with their index
+    Key const* const keys = soa.template data<E>();
+    js.runAndWait(parallel_for(js, nullptr, 0, size,
+            [p = items.data(), keys](uint32_t start, uint32_t c) {
+                for (uint32_t i = start; i < start + c; i++) {
+                    p[i] = { keys[i], i };
+                }
+            }, CountSplitter<4096, 5>()));
+
+    // sort each chunk independently, the chunk count is a power of two so they can be
+    // merged pairwise
+    size_t chunkCount = 1;
+    while (chunkCount < js.getThreadCount() && size / (chunkCount * 2) >= MIN_CHUNK_SIZE) {
+        chunkCount *= 2;
+    }
+    auto const bound = [size, chunkCount](size_t i) {
+        return size_t(uint64_t(size) * i / chunkCount);
+    };
+
+    Item* src = items.data();
+    Item* dst = merged.data();
+    details::runAndWaitEach(js, chunkCount, [src, &bound, &less](size_t i) {
+        std::sort(src + bound(i), src + bound(i + 1), less);
+    });
+
+    // merge the sorted chunks pairwise, each round halves the number of chunks
+    for (size_t width = 1; width < chunkCount; width *= 2) {
+        details::runAndWaitEach(js, chunkCount / (width * 2),
+                [src, dst, width, &bound, &less](size_t i) {
+                    size_t const lo = bound(i * width * 2);
+                    size_t const mid = bound(i * width * 2 + width);
+                    size_t const hi = bound(i * width * 2 + width * 2);
+                    std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, less);
+                });
+        std::swap(src, dst);
+    }
+
+    // extract the permutation, then apply it to all the arrays
+    std::vector<uint32_t> order(size);
+    js.runAndWait(parallel_for(js, nullptr, 0, size,
+            [p = order.data(), src](uint32_t start, uint32_t c) {
+                for (uint32_t i = start; i < start + c; i++) {
+                    p[i] = src[i].index;
+                }
+            }, CountSplitter<4096, 5>()));
+
+    permute(js, soa, order.data());
+}
+
+} // namespace jobs
+} // namespace utils
+
+#endif // TNT_UTILS_STRUCTUREOFARRAYSJOBS_H
@@ -37,10 +37,17 @@
 #define FILAMENT_APPLE_SYSTRACE 0
 #endif
 
+// On Linux, events are recorded only when the FILAMENT_TRACE_FILE environment variable is set.
+#ifndef FILAMENT_LINUX_SYSTRACE
+#define FILAMENT_LINUX_SYSTRACE 0
+#endif
+
 #if defined(__ANDROID__)
 #include <utils/android/Systrace.h>
 #elif defined(__APPLE__) && FILAMENT_APPLE_SYSTRACE
 #include <utils/darwin/Systrace.h>
+#elif defined(__linux__) && FILAMENT_LINUX_SYSTRACE
+#include <utils/linux/Systrace.h>
 #else
 
 #define SYSTRACE_ENABLE()
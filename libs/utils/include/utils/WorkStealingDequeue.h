@@ -66,6 +66,13 @@ public:
 
     size_t getSize() const noexcept { return COUNT; }
 
+    // This is exact when called from the main thread, and only a hint otherwise.
+    bool isEmpty() const noexcept {
+        index_t bottom = mBottom.load(std::memory_order_relaxed);
+        index_t top = mTop.load(std::memory_order_relaxed);
+        return bottom <= top;
+    }
+
     // for debugging only...
     size_t getCount() const noexcept {
         index_t bottom = mBottom.load(std::memory_order_relaxed);
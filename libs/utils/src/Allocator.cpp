@@ -151,6 +151,91 @@ AtomicFreeList::AtomicFreeList(void* begin, void* end,
     mHead.store({ int32_t(head - mStorage), 0 });
 }
 
+// ------------------------------------------------------------------------------------------------
+// ThreadCachedFreeList
+// ------------------------------------------------------------------------------------------------
+
+ThreadCachedFreeList::ThreadCachedFreeList(void* begin, void* end,
+        size_t elementSize, size_t alignment, size_t extra) noexcept
+        : mState(std::make_unique<State>()) {
+    mState->freeList = FreeList(begin, end, elementSize, alignment, extra);
+}
+
+ThreadCachedFreeList::~ThreadCachedFreeList() noexcept = default;
+
+uint32_t ThreadCachedFreeList::getThreadIndex() noexcept {
+    static std::atomic<uint32_t> sThreadCount{ 0 };
+    static thread_local uint32_t const sIndex =
+            sThreadCount.fetch_add(1, std::memory_order_relaxed);
+    return sIndex;
+}
+
+void* ThreadCachedFreeList::getFirst() noexcept {
+    std::lock_guard<Mutex> const guard(mState->lock);
+    return mState->freeList.getFirst();
+}
+
+UTILS_NOINLINE
+void ThreadCachedFreeList::refill(Magazine& magazine) noexcept {
+    assert_invariant(magazine.count == 0);
+    std::lock_guard<Mutex> const guard(mState->lock);
+    FreeList& freeList = mState->freeList;
+    uint32_t count = 0;
+    while (count < MAGAZINE_CAPACITY / 2) {
+        void* const p = freeList.pop();
+        if (!p) {
+            break;
+        }
+        magazine.items[count++] = p;
+    }
+    magazine.count = count;
+}
+
+UTILS_NOINLINE
+void ThreadCachedFreeList::drain(Magazine& magazine) noexcept {
+    assert_invariant(magazine.count == MAGAZINE_CAPACITY);
+    // return the oldest half of the magazine, the most recently freed elements are more likely
+    // to be in the cache.
+    constexpr size_t HALF = MAGAZINE_CAPACITY / 2;
+    {
+        std::lock_guard<Mutex> const guard(mState->lock);
+        FreeList& freeList = mState->freeList;
+        for (size_t i = 0; i < HALF; i++) {
+            freeList.push(magazine.items[i]);
+        }
+    }
+    std::copy(magazine.items + HALF, magazine.items + MAGAZINE_CAPACITY, magazine.items);
+    magazine.count = MAGAZINE_CAPACITY - HALF;
+}
+
+UTILS_NOINLINE
+void* ThreadCachedFreeList::popSlow() noexcept {
+    { // our magazine was empty or in use, try the shared list
+        std::lock_guard<Mutex> const guard(mState->lock);
+        void* const p = mState->freeList.pop();
+        if (p) {
+            return p;
+        }
+    }
+    // the shared list is empty too, take an element cached by another thread
+    for (Magazine& magazine : mState->magazines) {
+        if (magazine.tryLock()) {
+            void* const p = magazine.count ? magazine.items[--magazine.count] : nullptr;
+            magazine.unlock();
+            if (p) {
+                return p;
+            }
+        }
+    }
+    return nullptr;
+}
+
+UTILS_NOINLINE
+void ThreadCachedFreeList::pushSlow(void* p) noexcept {
+    std::lock_guard<Mutex> const guard(mState->lock);
+    mState->freeList.push(p);
+}
+
 // ------------------------------------------------------------------------------------------------
 
 void TrackingPolicy::HighWatermark::onAlloc(
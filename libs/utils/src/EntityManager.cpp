@@ -25,9 +25,8 @@ namespace utils {
 EntityManager::Listener::~Listener() noexcept = default;
 
 EntityManager::EntityManager()
-        : mGens(new uint8_t[RAW_INDEX_COUNT]) {
-    // initialize all the generations to 0
-    std::fill_n(mGens, RAW_INDEX_COUNT, 0);
+        : mGens(new std::atomic<uint8_t>[RAW_INDEX_COUNT]{}) {
+    // all the generations are initialized to 0
 }
 
 EntityManager::~EntityManager() {
@@ -57,6 +56,7 @@ void EntityManager::unregisterListener(EntityManager::Listener* l) noexcept {
     static_cast<EntityManagerImpl *>(this)->unregisterListener(l);
 }
 
+
 size_t EntityManager::getEntityCount() const noexcept {
     return static_cast<EntityManagerImpl const *>(this)->getEntityCount();
 }
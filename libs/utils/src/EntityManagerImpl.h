@@ -19,6 +19,7 @@
 
 #include <utils/EntityManager.h>
 
+#include <utils/architecture.h>
 #include <utils/compiler.h>
 #include <utils/Entity.h>
 #include <utils/Mutex.h>
@@ -31,8 +32,12 @@
 #include <tsl/robin_map.h>
 #endif
 
-#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex> // for std::lock_guard
+#include <thread>
+#include <utility>
 #include <vector>
 
 
@@ -48,109 +53,150 @@ public:
     using EntityManager::create;
     using EntityManager::destroy;
 
+    EntityManagerImpl()
+            : mFreeList(new std::atomic<Entity::Type>[RAW_INDEX_COUNT]{}) {
+    }
+
     UTILS_NOINLINE
     size_t getEntityCount() const noexcept {
-        std::lock_guard<Mutex> const lock(mFreeListLock);
-        if (mCurrentIndex < RAW_INDEX_COUNT) {
-            return (mCurrentIndex - 1) - mFreeList.size();
-        } else {
-            return getMaxEntityCount() - mFreeList.size();
-        }
+        // this is only a snapshot if other threads are creating or destroying entities
+        Entity::Type const currentIndex = std::min(
+                mCurrentIndex.load(std::memory_order_relaxed), Entity::Type(RAW_INDEX_COUNT));
+        return (currentIndex - 1) - std::min(getFreeCount(), size_t(currentIndex - 1));
     }
 
     UTILS_NOINLINE
     void create(size_t n, Entity* entities) {
-        Entity::Type index{};
-        auto& freeList = mFreeList;
-        uint8_t* const gens = mGens;
-
-        // this must be thread-safe, acquire the free-list mutex
-        std::lock_guard<Mutex> const lock(mFreeListLock);
-        Entity::Type currentIndex = mCurrentIndex;
-        for (size_t i = 0; i < n; i++) {
-            // If we have more than a certain number of freed indices, get one from the list.
+        std::atomic<uint8_t> const* const gens = mGens;
+        size_t i = 0;
+        while (i < n) {
+            size_t const remaining = n - i;
+            Entity::Type currentIndex = mCurrentIndex.load(std::memory_order_relaxed);
+
+            // If we have more than a certain number of freed indices, get them from the list.
             // this is a trade-off between how often we recycle indices and how large the free list
             // can grow.
-            if (UTILS_UNLIKELY(currentIndex >= RAW_INDEX_COUNT || freeList.size() >= MIN_FREE_INDICES)) {
+            if (UTILS_UNLIKELY(currentIndex >= RAW_INDEX_COUNT ||
+                    getFreeCount() >= MIN_FREE_INDICES)) {
+                auto const [slot, count] = claimFreeSlots(remaining);
 
                 // this could only happen if we had gone through all the indices at least once
-                if (UTILS_UNLIKELY(freeList.empty())) {
+                if (UTILS_UNLIKELY(!count && currentIndex >= RAW_INDEX_COUNT)) {
                     // return the null entity
-                    entities[i] = {};
-                    continue;
+                    std::fill_n(entities + i, remaining, Entity{});
+                    break;
                 }
 
-                index = freeList.front();
-                freeList.pop_front();
+                for (uint32_t k = 0; k < count; k++) {
+                    Entity::Type const index = takeFreeIndex(slot + k);
+                    entities[i++] = Entity{ makeIdentity(
+                            gens[index].load(std::memory_order_relaxed), index) };
+                }
             } else {
-                // In the common case, we just grab the next index.
+                // In the common case, we just grab the next indices.
                 // This works only until all indices have been used once, at which point
                 // we're always in the slower case above. The idea is that we have enough indices
                 // that it doesn't happen in practice.
-                index = currentIndex++;
+                Entity::Type count;
+                do {
+                    count = currentIndex < RAW_INDEX_COUNT ? Entity::Type(
+                            std::min(remaining, RAW_INDEX_COUNT - currentIndex)) : 0;
+                } while (count && !mCurrentIndex.compare_exchange_weak(
+                        currentIndex, currentIndex + count, std::memory_order_relaxed));
+
+                for (Entity::Type k = 0; k < count; k++) {
+                    Entity::Type const index = currentIndex + k;
+                    entities[i++] = Entity{ makeIdentity(
+                            gens[index].load(std::memory_order_relaxed), index) };
+                }
             }
-            entities[i] = Entity{ makeIdentity(gens[index], index) };
+        }
+
 #if FILAMENT_UTILS_TRACK_ENTITIES
-            mDebugActiveEntities.emplace(entities[i], CallStack::unwind(5));
-#endif
+        std::lock_guard<Mutex> const lock(mDebugLock);
+        for (size_t k = 0; k < n; k++) {
+            if (entities[k]) {
+                mDebugActiveEntities.emplace(entities[k], CallStack::unwind(5));
+            }
         }
-        mCurrentIndex = currentIndex;
+#endif
     }
 
     UTILS_NOINLINE
     void destroy(size_t n, Entity* entities) noexcept {
-        auto& freeList = mFreeList;
-        uint8_t* const gens = mGens;
-
-        std::unique_lock<Mutex> lock(mFreeListLock);
-        for (size_t i = 0; i < n; i++) {
-            if (!entities[i]) {
-                // behave like free(), ok to free null Entity.
-                continue;
-            }
+        std::atomic<uint8_t>* const gens = mGens;
 
-            // it's an error to delete an Entity twice...
-            assert(isAlive(entities[i]));
+        // listeners are only looked up when there are some, so that destroy() stays lock-free
+        FixedCapacityVector<EntityManager::Listener*> listeners;
+        if (mListenerCount.load(std::memory_order_relaxed)) {
+            listeners = getListeners();
+        }
 
-            // ... deleting a dead Entity will corrupt the internal state, so we protect ourselves
-            // against it. We don't guarantee anything about external state -- e.g. the listeners
-            // will be called.
-            if (isAlive(entities[i])) {
-                Entity::Type const index = getIndex(entities[i]);
-                freeList.push_back(index);
+        // destroyed indices are returned to the free-list in batches
+        constexpr size_t BATCH_SIZE = 256;
+        Entity::Type indices[BATCH_SIZE];
+        Entity destroyed[BATCH_SIZE];
+
+        for (size_t i = 0; i < n;) {
+            size_t count = 0;
+            for (; i < n && count < BATCH_SIZE; i++) {
+                Entity const e = entities[i];
+                if (!e) {
+                    // behave like free(), ok to free null Entity.
+                    continue;
+                }
 
-                // The generation update doesn't require the lock because it's only used for isAlive()
-                // and entities work as weak references -- it just means that isAlive() could return
-                // true a little longer than expected in some other threads.
-                // We do need a memory fence though, it is provided by the mFreeListLock.unlock() below.
-                gens[index]++;
+                // it's an error to delete an Entity twice...
+                assert(isAlive(e));
+
+                // ... deleting a dead Entity will corrupt the internal state, so we protect
+                // ourselves against it, even when two threads destroy the same Entity: only the
+                // one that bumps the generation returns the index to the free-list.
+                // The generation works as a weak reference, isAlive() could return true a little
+                // longer than expected in some other threads.
+                Entity::Type const index = getIndex(e);
+                uint8_t generation = uint8_t(getGeneration(e));
+                if (gens[index].compare_exchange_strong(generation, uint8_t(generation + 1),
+                        std::memory_order_relaxed)) {
+                    indices[count] = index;
+                    destroyed[count] = e;
+                    count++;
+                }
+            }
 
-#if FILAMENT_UTILS_TRACK_ENTITIES
-                mDebugActiveEntities.erase(entities[i]);
-#endif
+            pushFreeIndices(indices, count);
+
+            // notify our listeners that some entities have been destroyed
+            if (count) {
+                for (auto const& l : listeners) {
+                    l->onEntitiesDestroyed(count, destroyed);
+                }
             }
-        }
-        lock.unlock();
 
-        // notify our listeners that some entities are being destroyed
-        auto listeners = getListeners();
-        for (auto const& l : listeners) {
-            l->onEntitiesDestroyed(n, entities);
+#if FILAMENT_UTILS_TRACK_ENTITIES
+            std::lock_guard<Mutex> const lock(mDebugLock);
+            for (size_t k = 0; k < count; k++) {
+                mDebugActiveEntities.erase(destroyed[k]);
+            }
+#endif
         }
     }
 
     void registerListener(EntityManager::Listener* l) noexcept {
         std::lock_guard<Mutex> const lock(mListenerLock);
         mListeners.insert(l);
+        mListenerCount.store(mListeners.size(), std::memory_order_relaxed);
     }
 
     void unregisterListener(EntityManager::Listener* l) noexcept {
         std::lock_guard<Mutex> const lock(mListenerLock);
         mListeners.erase(l);
+        mListenerCount.store(mListeners.size(), std::memory_order_relaxed);
     }
 
 #if FILAMENT_UTILS_TRACK_ENTITIES
     std::vector<Entity> getActiveEntities() const {
+        std::lock_guard<Mutex> const lock(mDebugLock);
         std::vector<Entity> result(mDebugActiveEntities.size());
         auto p = result.begin();
         for (auto i : mDebugActiveEntities) {
@@ -160,6 +206,7 @@ public:
     }
 
     void dumpActiveEntities(utils::io::ostream& out) const {
+        std::lock_guard<Mutex> const lock(mDebugLock);
         for (auto i : mDebugActiveEntities) {
             out << "*** Entity " << i.first.getId() << " was allocated at:\n";
             out << i.second;
@@ -178,16 +225,74 @@ private:
         return result; // the c++ standard guarantees a move
     }
 
-    uint32_t mCurrentIndex = 1;
+    /*
+     * The free-list is a ring buffer of RAW_INDEX_COUNT slots, which is large enough to hold
+     * all indices. Threads claim a range of slots with a single atomic operation on
+     * mFreeListHead (to take indices) or mFreeListTail (to return them), then read or write
+     * each slot. An empty slot holds 0, which is never a valid index.
+     */
+
+    static constexpr const uint32_t FREE_LIST_MASK = RAW_INDEX_COUNT - 1u;
+
+    size_t getFreeCount() const noexcept {
+        uint32_t const head = mFreeListHead.load(std::memory_order_relaxed);
+        uint32_t const tail = mFreeListTail.load(std::memory_order_relaxed);
+        return size_t(std::max(int32_t(tail - head), 0));
+    }
+
+    // claims up to n slots at the head of the free-list, returns the first slot and the count.
+    std::pair<uint32_t, uint32_t> claimFreeSlots(size_t n) noexcept {
+        uint32_t head = mFreeListHead.load(std::memory_order_acquire);
+        uint32_t count;
+        do {
+            uint32_t const tail = mFreeListTail.load(std::memory_order_acquire);
+            count = uint32_t(std::min(size_t(std::max(int32_t(tail - head), 0)), n));
+        } while (count && !mFreeListHead.compare_exchange_weak(head, head + count,
+                std::memory_order_acq_rel, std::memory_order_acquire));
+        return { head, count };
+    }
+
+    Entity::Type takeFreeIndex(uint32_t slot) noexcept {
+        std::atomic<Entity::Type>& cell = mFreeList[slot & FREE_LIST_MASK];
+        Entity::Type index = cell.load(std::memory_order_acquire);
+        // the slot is claimed, but the thread returning this index might not have written it yet
+        while (UTILS_UNLIKELY(!index)) {
+            std::this_thread::yield();
+            index = cell.load(std::memory_order_acquire);
+        }
+        cell.store(0, std::memory_order_relaxed);
+        return index;
+    }
+
+    void pushFreeIndices(Entity::Type const* indices, size_t n) noexcept {
+        if (!n) {
+            return;
+        }
+        uint32_t const tail = mFreeListTail.fetch_add(uint32_t(n), std::memory_order_acq_rel);
+        for (size_t k = 0; k < n; k++) {
+            std::atomic<Entity::Type>& cell = mFreeList[(tail + k) & FREE_LIST_MASK];
+            // the slot can still be held by a thread taking the index it had on the previous lap
+            while (UTILS_UNLIKELY(cell.load(std::memory_order_relaxed))) {
+                std::this_thread::yield();
+            }
+            cell.store(indices[k], std::memory_order_release);
+        }
+    }
+
+    // indices that were never used are allocated from here
+    std::atomic<Entity::Type> mCurrentIndex = { 1 };
 
     // stores indices that got freed
-    mutable Mutex mFreeListLock;
-    std::deque<Entity::Type> mFreeList;
+    std::unique_ptr<std::atomic<Entity::Type>[]> mFreeList;
+    alignas(CACHELINE_SIZE) std::atomic<uint32_t> mFreeListHead = { 0 };
+    alignas(CACHELINE_SIZE) std::atomic<uint32_t> mFreeListTail = { 0 };
 
-    mutable Mutex mListenerLock;
+    alignas(CACHELINE_SIZE) mutable Mutex mListenerLock;
     tsl::robin_set<Listener*> mListeners;
+    std::atomic<size_t> mListenerCount = { 0 };
 
 #if FILAMENT_UTILS_TRACK_ENTITIES
+    mutable Mutex mDebugLock;
     tsl::robin_map<Entity, CallStack, Entity::Hasher> mDebugActiveEntities;
 #endif
 };
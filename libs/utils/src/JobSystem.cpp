@@ -84,6 +84,9 @@ namespace utils {
 void JobSystem::setThreadName(const char* name) noexcept {
 #if defined(__linux__)
     pthread_setname_np(pthread_self(), name);
+#if !defined(__ANDROID__) && FILAMENT_LINUX_SYSTRACE
+    details::Systrace::setThreadName(name);
+#endif
 #elif defined(__APPLE__)
     pthread_setname_np(name);
 #elif defined(WIN32)
@@ -137,7 +140,9 @@ void JobSystem::setThreadAffinityById(size_t id) noexcept {
 
 JobSystem::JobSystem(const size_t userThreadCount, const size_t adoptableThreadsCount) noexcept
     : mJobPool("JobSystem Job pool", MAX_JOB_COUNT * sizeof(Job)),
-      mJobStorageBase(static_cast<Job *>(mJobPool.getAllocator().getCurrent()))
+      mContinuationPool("JobSystem Continuation pool", MAX_JOB_COUNT * sizeof(Continuation)),
+      mJobStorageBase(static_cast<Job *>(mJobPool.getAllocator().getCurrent())),
+      mJobLinks(MAX_JOB_COUNT)
 {
     SYSTRACE_ENABLE();
 
@@ -303,13 +308,13 @@ JobSystem::Job* JobSystem::allocateJob() noexcept {
     return mJobPool.make<Job>();
 }
 
-void JobSystem::put(WorkQueue& workQueue, Job* job) noexcept {
+void JobSystem::put(ThreadState& state, Job* job) noexcept {
     assert(job);
     size_t index = job - mJobStorageBase;
     assert(index >= 0 && index < MAX_JOB_COUNT);
 
-    // put the job into the queue first
-    workQueue.push(uint16_t(index + 1));
+    // put the job into the queue of its priority first
+    state.workQueues[size_t(job->priority)].push(uint16_t(index + 1));
     // then increase our active job count
     uint32_t oldActiveJobs = mActiveJobs.fetch_add(1, std::memory_order_relaxed);
     // but it's possible that the job has already been picked-up, so oldActiveJobs could be
@@ -319,12 +324,22 @@ void JobSystem::put(WorkQueue& workQueue, Job* job) noexcept {
     }
 }
 
-JobSystem::Job* JobSystem::pop(WorkQueue& workQueue) noexcept {
+JobSystem::Job* JobSystem::pop(ThreadState& state) noexcept {
     // decrement mActiveJobs first, this is to ensure that if there is only a single job left
     // (and we're about to pick it up), other threads don't loop trying to do the same.
     mActiveJobs.fetch_sub(1, std::memory_order_relaxed);
 
-    size_t index = workQueue.pop();
+    // pick-up a job from the highest priority queue that has one. Only this thread adds jobs to
+    // these queues, so an empty queue can be skipped without paying for a pop().
+    size_t index = 0;
+    for (WorkQueue& workQueue : state.workQueues) {
+        if (!workQueue.isEmpty()) {
+            index = workQueue.pop();
+            if (index) {
+                break;
+            }
+        }
+    }
     assert(index <= MAX_JOB_COUNT);
     Job* job = !index ? nullptr : &mJobStorageBase[index - 1];
 
@@ -341,12 +356,22 @@ JobSystem::Job* JobSystem::pop(WorkQueue& workQueue) noexcept {
     return job;
 }
 
-JobSystem::Job* JobSystem::steal(WorkQueue& workQueue) noexcept {
+JobSystem::Job* JobSystem::stealFrom(ThreadState& stateToStealFrom) noexcept {
     // decrement mActiveJobs first, this is to ensure that if there is only a single job left
     // (and we're about to pick it up), other threads don't loop trying to do the same.
     mActiveJobs.fetch_sub(1, std::memory_order_relaxed);
 
-    size_t index = workQueue.steal();
+    // steal from the highest priority queue that has a job, isEmpty() is only a hint here, but
+    // a stale answer only costs a failed steal() or a retry.
+    size_t index = 0;
+    for (WorkQueue& workQueue : stateToStealFrom.workQueues) {
+        if (!workQueue.isEmpty()) {
+            index = workQueue.steal();
+            if (index) {
+                break;
+            }
+        }
+    }
     assert(index <= MAX_JOB_COUNT);
     Job* job = !index ? nullptr : &mJobStorageBase[index - 1];
 
@@ -390,7 +415,7 @@ JobSystem::Job* JobSystem::steal(JobSystem::ThreadState& state) noexcept {
     do {
         ThreadState* const stateToStealFrom = getStateToStealFrom(state);
         if (UTILS_LIKELY(stateToStealFrom)) {
-            job = steal(stateToStealFrom->workQueue);
+            job = stealFrom(*stateToStealFrom);
         }
         // nullptr -> nothing to steal in that queue either, if there are active jobs,
         // continue to try stealing one.
@@ -401,7 +426,7 @@ JobSystem::Job* JobSystem::steal(JobSystem::ThreadState& state) noexcept {
 bool JobSystem::execute(JobSystem::ThreadState& state) noexcept {
     HEAVY_SYSTRACE_CALL();
 
-    Job* job = pop(state.workQueue);
+    Job* job = pop(state);
     if (UTILS_UNLIKELY(job == nullptr)) {
         // our queue is empty, try to steal a job
         job = steal(state);
@@ -414,7 +439,7 @@ bool JobSystem::execute(JobSystem::ThreadState& state) noexcept {
             HEAVY_SYSTRACE_NAME("job->function");
             job->function(job->storage, *this, job);
         }
-        finish(job);
+        finish(job, &state);
     }
     return job != nullptr;
 }
@@ -446,7 +471,7 @@ void JobSystem::loop(ThreadState* state) noexcept {
 }
 
 UTILS_NOINLINE
-void JobSystem::finish(Job* job) noexcept {
+void JobSystem::finish(Job* job, ThreadState* state) noexcept {
     HEAVY_SYSTRACE_CALL();
 
     bool notify = false;
@@ -462,6 +487,10 @@ void JobSystem::finish(Job* job) noexcept {
             // no more work, destroy this job and notify its parent
             notify = true;
             Job* const parent = job->parent == 0x7FFF ? nullptr : &storage[job->parent];
+            JobLinks& links = mJobLinks[job - storage];
+            if (UTILS_UNLIKELY(links.continuations)) {
+                runContinuations(links, state);
+            }
             decRef(job);
             job = parent;
         } else {
@@ -476,6 +505,25 @@ void JobSystem::finish(Job* job) noexcept {
     }
 }
 
+void JobSystem::runContinuations(JobLinks& links, ThreadState* state) noexcept {
+    Continuation* continuation = links.continuations;
+    links.continuations = nullptr;
+    do {
+        Job* const job = continuation->job;
+        Continuation* const next = continuation->next;
+        mContinuationPool.destroy(continuation);
+        // the last dependency to finish runs the job
+        JobLinks& jobLinks = mJobLinks[job - mJobStorageBase];
+        if (jobLinks.dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (!state) {
+                state = &getState();
+            }
+            put(*state, job);
+        }
+        continuation = next;
+    } while (continuation);
+}
+
 // -----------------------------------------------------------------------------------------------
 // public API...
 
@@ -499,10 +547,16 @@ JobSystem::Job* JobSystem::create(JobSystem::Job* parent, JobFunc func) noexcept
         }
         job->function = func;
         job->parent = uint16_t(index);
+        job->priority = parent ? parent->priority : JobPriority::NORMAL;
     }
     return job;
 }
 
+void JobSystem::setPriority(Job* job, JobPriority priority) noexcept {
+    assert(job);
+    job->priority = priority;
+}
+
 void JobSystem::cancel(Job*& job) noexcept {
     finish(job);
     job = nullptr;
@@ -519,6 +573,36 @@ void JobSystem::release(JobSystem::Job*& job) noexcept {
     job = nullptr;
 }
 
+void JobSystem::runAfter(Job*& job, Job* const* dependencies, size_t count) noexcept {
+    HEAVY_SYSTRACE_CALL();
+
+    assert(job);
+    assert(count < MAX_JOB_COUNT);
+
+    // hold an extra dependency while the continuations are added, this also handles the case
+    // where there are no dependencies.
+    JobLinks& links = mJobLinks[job - mJobStorageBase];
+    links.dependencies.store(uint16_t(count + 1), std::memory_order_relaxed);
+
+    for (size_t i = 0; i < count; i++) {
+        assert(dependencies[i]);
+        Continuation* const continuation = mContinuationPool.make<Continuation>();
+        ASSERT_POSTCONDITION(continuation, "JobSystem(%p): too many continuations", this);
+        // the dependencies haven't run yet, so they can't finish concurrently
+        JobLinks& dependency = mJobLinks[dependencies[i] - mJobStorageBase];
+        continuation->job = job;
+        continuation->next = dependency.continuations;
+        dependency.continuations = continuation;
+    }
+
+    if (links.dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        run(job);
+    }
+
+    // after runAfter() returns, the job is virtually invalid (it'll die on its own)
+    job = nullptr;
+}
+
 void JobSystem::signal() noexcept {
     wakeAll();
 }
@@ -528,7 +612,7 @@ void JobSystem::run(Job*& job) noexcept {
 
     ThreadState& state(getState());
 
-    put(state.workQueue, job);
+    put(state, job);
 
     // after run() returns, the job is virtually invalid (it'll die on its own)
     job = nullptr;
@@ -628,7 +712,10 @@ void JobSystem::emancipate() {
 
 io::ostream& operator<<(io::ostream& out, JobSystem const& js) {
     for (auto const& item : js.mThreadStates) {
-        out << size_t(item.id) << ": " << item.workQueue.getCount() << io::endl;
+        out << size_t(item.id) << ": "
+            << item.workQueues[size_t(JobSystem::JobPriority::CRITICAL)].getCount() << ", "
+            << item.workQueues[size_t(JobSystem::JobPriority::NORMAL)].getCount() << ", "
+            << item.workQueues[size_t(JobSystem::JobPriority::BACKGROUND)].getCount() << io::endl;
     }
     return out;
 }
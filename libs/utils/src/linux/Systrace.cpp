@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <utils/Systrace.h>
+#include <utils/Log.h>
+
+#if FILAMENT_LINUX_SYSTRACE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace utils {
+namespace details {
+
+namespace {
+
+// Names are copied into the events, so that transient strings can be traced.
+constexpr size_t EVENT_NAME_LENGTH = 47;
+
+// Number of events per thread, must be a power of two. When a thread records events faster than
+// they are written out, the extra events are dropped. A slot is always kept for the END event of
+// each BEGIN event in the buffer, so that the trace stays balanced.
+constexpr uint32_t RING_BUFFER_SIZE = 8192;
+
+// How often the recorded events are written to the trace file.
+constexpr std::chrono::milliseconds FLUSH_PERIOD{ 100 };
+
+struct Event {
+    uint64_t timestamp;     // in nanoseconds
+    int64_t value;          // counter value or async cookie
+    Systrace::EventType type;
+    char name[EVENT_NAME_LENGTH];
+};
+
+static_assert(sizeof(Event) == 64);
+
+// Single producer (the thread that owns it), single consumer (the writer) ring buffer.
+struct ThreadBuffer {
+    std::atomic<uint32_t> head{ 0 };        // written by the owner thread
+    std::atomic<uint32_t> tail{ 0 };        // written by the writer
+    std::atomic<uint32_t> dropped{ 0 };
+    std::atomic<bool> alive{ true };
+    pid_t tid = 0;
+    uint32_t openBegins = 0;                // accessed by the owner thread only
+    uint32_t droppedBegins = 0;             // accessed by the owner thread only
+    char pendingThreadName[16] = {};        // guarded by the writer's mBuffersLock
+    bool threadNameChanged = false;         // guarded by the writer's mBuffersLock
+    char threadName[16] = {};               // accessed by the writer only, once published
+    bool threadNameWritten = false;
+    Event events[RING_BUFFER_SIZE];
+};
+
+class TraceWriter {
+public:
+    explicit TraceWriter(FILE* file) noexcept : mFile(file), mEpoch(now()) {
+        mPid = getpid();
+        fputs("[\n", mFile);
+        mThread = std::thread(&TraceWriter::loop, this);
+    }
+
+    static uint64_t now() noexcept {
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return uint64_t(ts.tv_sec) * 1000000000u + uint64_t(ts.tv_nsec);
+    }
+
+    void addBuffer(ThreadBuffer* buffer) noexcept {
+        std::lock_guard<std::mutex> const lock(mBuffersLock);
+        mBuffers.push_back(buffer);
+    }
+
+    // called by the thread that owns the buffer, which is the only one that can name it safely
+    void setThreadName(ThreadBuffer* buffer, const char* name) noexcept {
+        std::lock_guard<std::mutex> const lock(mBuffersLock);
+        strncpy(buffer->pendingThreadName, name, sizeof(buffer->pendingThreadName) - 1);
+        buffer->pendingThreadName[sizeof(buffer->pendingThreadName) - 1] = 0;
+        buffer->threadNameChanged = true;
+    }
+
+    void flush() noexcept {
+        std::lock_guard<std::mutex> const lock(mFileLock);
+        if (mFile) {
+            drain();
+            fflush(mFile);
+        }
+    }
+
+    void shutdown() noexcept {
+        {
+            std::lock_guard<std::mutex> const lock(mBuffersLock);
+            mExitRequested = true;
+        }
+        mCondition.notify_one();
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+        std::lock_guard<std::mutex> const lock(mFileLock);
+        if (mFile) {
+            drain();
+            fputs("\n]\n", mFile);
+            fclose(mFile);
+            mFile = nullptr;
+        }
+    }
+
+private:
+    void loop() noexcept {
+        pthread_setname_np(pthread_self(), "FilamentTrace");
+        std::unique_lock<std::mutex> lock(mBuffersLock);
+        while (!mExitRequested) {
+            mCondition.wait_for(lock, FLUSH_PERIOD);
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    // must be called with mFileLock held
+    void drain() noexcept {
+        { // snapshot the buffers, threads that start tracing meanwhile are picked up next time
+            std::lock_guard<std::mutex> const lock(mBuffersLock);
+            mSnapshot = mBuffers;
+            for (ThreadBuffer* buffer : mSnapshot) {
+                if (UTILS_UNLIKELY(buffer->threadNameChanged)) {
+                    strcpy(buffer->threadName, buffer->pendingThreadName);
+                    buffer->threadNameChanged = false;
+                    buffer->threadNameWritten = false;
+                }
+            }
+        }
+
+        for (ThreadBuffer* buffer : mSnapshot) {
+            // alive must be read before head, so that a dead buffer is drained completely
+            bool const alive = buffer->alive.load(std::memory_order_acquire);
+            uint32_t const head = buffer->head.load(std::memory_order_acquire);
+            uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+
+            if (!buffer->threadNameWritten && head != tail) {
+                separator();
+                fprintf(mFile, R"({"name":"thread_name","ph":"M","pid":%d,"tid":%d,)"
+                               R"("args":{"name":)", mPid, buffer->tid);
+                writeString(buffer->threadName);
+                fputs("}}", mFile);
+                buffer->threadNameWritten = true;
+            }
+
+            for (; tail != head; ++tail) {
+                writeEvent(buffer->events[tail & (RING_BUFFER_SIZE - 1)], buffer->tid);
+            }
+            buffer->tail.store(tail, std::memory_order_release);
+
+            uint32_t const dropped = buffer->dropped.exchange(0, std::memory_order_relaxed);
+            if (UTILS_UNLIKELY(dropped)) {
+                separator();
+                fprintf(mFile, R"({"name":"dropped events","ph":"C","pid":%d,"tid":%d,)"
+                               R"("ts":%.3f,"args":{"value":%u}})",
+                        mPid, buffer->tid, microseconds(now()), dropped);
+            }
+
+            if (!alive) {
+                std::lock_guard<std::mutex> const lock(mBuffersLock);
+                mBuffers.erase(std::find(mBuffers.begin(), mBuffers.end(), buffer));
+                delete buffer;
+            }
+        }
+    }
+
+    void writeEvent(Event const& e, pid_t tid) noexcept {
+        separator();
+        double const ts = microseconds(e.timestamp);
+        switch (e.type) {
+            case Systrace::EventType::BEGIN:
+                fputs(R"({"name":)", mFile);
+                writeString(e.name);
+                fprintf(mFile, R"(,"ph":"B","pid":%d,"tid":%d,"ts":%.3f})", mPid, tid, ts);
+                break;
+            case Systrace::EventType::END:
+                fprintf(mFile, R"({"ph":"E","pid":%d,"tid":%d,"ts":%.3f})", mPid, tid, ts);
+                break;
+            case Systrace::EventType::ASYNC_BEGIN:
+            case Systrace::EventType::ASYNC_END:
+                fputs(R"({"name":)", mFile);
+                writeString(e.name);
+                fprintf(mFile, R"(,"cat":"filament","ph":"%c","id":%lld,)"
+                               R"("pid":%d,"tid":%d,"ts":%.3f})",
+                        e.type == Systrace::EventType::ASYNC_BEGIN ? 'b' : 'e',
+                        (long long)e.value, mPid, tid, ts);
+                break;
+            case Systrace::EventType::COUNTER:
+                fputs(R"({"name":)", mFile);
+                writeString(e.name);
+                fprintf(mFile, R"(,"ph":"C","pid":%d,"tid":%d,"ts":%.3f,"args":{"value":%lld}})",
+                        mPid, tid, ts, (long long)e.value);
+                break;
+            case Systrace::EventType::INSTANT:
+                fputs(R"({"name":)", mFile);
+                writeString(e.name);
+                fprintf(mFile, R"(,"ph":"i","s":"p","pid":%d,"tid":%d,"ts":%.3f})",
+                        mPid, tid, ts);
+                break;
+        }
+    }
+
+    void writeString(const char* s) noexcept {
+        fputc('"', mFile);
+        for (; *s; ++s) {
+            unsigned char const c = *s;
+            if (c == '"' || c == '\\') {
+                fputc('\\', mFile);
+                fputc(c, mFile);
+            } else if (c < 0x20) {
+                fprintf(mFile, "\\u%04x", c);
+            } else {
+                fputc(c, mFile);
+            }
+        }
+        fputc('"', mFile);
+    }
+
+    void separator() noexcept {
+        if (!mFirstEvent) {
+            fputs(",\n", mFile);
+        }
+        mFirstEvent = false;
+    }
+
+    double microseconds(uint64_t timestamp) const noexcept {
+        return double(int64_t(timestamp - mEpoch)) * 1e-3;
+    }
+
+    FILE* mFile;
+    uint64_t const mEpoch;
+    pid_t mPid;
+    bool mFirstEvent = true;
+    std::vector<ThreadBuffer*> mSnapshot;
+
+    std::mutex mFileLock;
+    std::mutex mBuffersLock;
+    std::condition_variable mCondition;
+    std::vector<ThreadBuffer*> mBuffers;
+    bool mExitRequested = false;
+    std::thread mThread;
+};
+
+// Never destroyed, so that threads can trace until the very end of the process.
+TraceWriter* gWriter = nullptr;
+
+// The buffer is marked dead when its thread exits, and deleted by the writer once drained.
+struct ThreadBufferHolder {
+    ThreadBuffer* buffer = nullptr;
+    ~ThreadBufferHolder() noexcept;
+};
+
+thread_local bool tThreadExited = false;
+thread_local ThreadBufferHolder tThreadBuffer;
+
+ThreadBufferHolder::~ThreadBufferHolder() noexcept {
+    tThreadExited = true;
+    if (buffer) {
+        buffer->alive.store(false, std::memory_order_release);
+    }
+}
+
+ThreadBuffer* getThreadBuffer() noexcept {
+    // tThreadBuffer can't be accessed anymore once it has been destroyed
+    if (UTILS_UNLIKELY(tThreadExited || !gWriter)) {
+        return nullptr;
+    }
+    ThreadBuffer* buffer = tThreadBuffer.buffer;
+    if (UTILS_UNLIKELY(!buffer)) {
+        buffer = new(std::nothrow) ThreadBuffer;
+        if (!buffer) {
+            return nullptr;
+        }
+        buffer->tid = pid_t(syscall(SYS_gettid));
+        pthread_getname_np(pthread_self(), buffer->threadName, sizeof(buffer->threadName));
+        tThreadBuffer.buffer = buffer;
+        gWriter->addBuffer(buffer);
+    }
+    return buffer;
+}
+
+} // anonymous namespace
+
+static pthread_once_t atrace_once_control = PTHREAD_ONCE_INIT;
+
+Systrace::GlobalState Systrace::sGlobalState = {};
+
+void Systrace::init_once() noexcept {
+    GlobalState& s = sGlobalState;
+
+    const char* const path = getenv("FILAMENT_TRACE_FILE");
+    if (!path || !*path) {
+        return;
+    }
+
+    FILE* const file = fopen(path, "w");
+    if (!file) {
+        slog.e << "Systrace: cannot open " << path << ": " << strerror(errno) << io::endl;
+        return;
+    }
+
+    gWriter = new TraceWriter(file);
+    atexit([]() {
+        sGlobalState.isTracingAvailable = false;
+        sGlobalState.isTracingEnabled.store(0, std::memory_order_relaxed);
+        gWriter->shutdown();
+    });
+
+    s.isTracingAvailable = true;
+}
+
+void Systrace::setup() noexcept {
+    pthread_once(&atrace_once_control, init_once);
+}
+
+void Systrace::enable(uint32_t tags) noexcept {
+    setup();
+    if (UTILS_LIKELY(sGlobalState.isTracingAvailable)) {
+        sGlobalState.isTracingEnabled.fetch_or(tags, std::memory_order_relaxed);
+    }
+}
+
+void Systrace::disable(uint32_t tags) noexcept {
+    sGlobalState.isTracingEnabled.fetch_and(~tags, std::memory_order_relaxed);
+}
+
+void Systrace::setThreadName(const char* name) noexcept {
+    setup();
+    // a thread that hasn't traced anything yet picks up its name when its buffer is created
+    if (gWriter && !tThreadExited && tThreadBuffer.buffer) {
+        gWriter->setThreadName(tThreadBuffer.buffer, name);
+    }
+}
+
+void Systrace::flush() noexcept {
+    setup();
+    if (gWriter) {
+        gWriter->flush();
+    }
+}
+
+// unfortunately, this generates quite a bit of code because reading a global is not
+// trivial. For this reason, we do not inline this method.
+bool Systrace::isTracingEnabled(uint32_t tag) noexcept {
+    if (tag) {
+        setup();
+        if (UTILS_LIKELY(!sGlobalState.isTracingAvailable)) {
+            return false;
+        }
+        return bool((sGlobalState.isTracingEnabled.load(std::memory_order_relaxed) | SYSTRACE_TAG_ALWAYS) & tag);
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void Systrace::init(uint32_t tag) noexcept {
+    // must be called first
+    mIsTracingEnabled = isTracingEnabled(tag);
+}
+
+void Systrace::record(EventType type, const char* name, int64_t value) noexcept {
+    ThreadBuffer* const buffer = getThreadBuffer();
+    if (UTILS_UNLIKELY(!buffer)) {
+        return;
+    }
+
+    uint32_t const head = buffer->head.load(std::memory_order_relaxed);
+    uint32_t const tail = buffer->tail.load(std::memory_order_acquire);
+    uint32_t const available = RING_BUFFER_SIZE - (head - tail);
+
+    // Every BEGIN event in the buffer has a slot reserved for its END event, so ENDs are never
+    // dropped on their own. When a BEGIN is dropped, its END and the BEGIN/END pairs it encloses
+    // are dropped with it, so that the ENDs that are kept still match their BEGINs.
+    bool drop;
+    switch (type) {
+        case EventType::BEGIN:
+            drop = buffer->droppedBegins || available < buffer->openBegins + 2;
+            if (drop) {
+                buffer->droppedBegins++;
+            } else {
+                buffer->openBegins++;
+            }
+            break;
+        case EventType::END:
+            drop = buffer->droppedBegins || (!buffer->openBegins && !available);
+            if (drop) {
+                buffer->droppedBegins -= buffer->droppedBegins ? 1 : 0;
+            } else {
+                buffer->openBegins -= buffer->openBegins ? 1 : 0;
+            }
+            break;
+        default:
+            drop = available < buffer->openBegins + 1;
+            break;
+    }
+    if (UTILS_UNLIKELY(drop)) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& e = buffer->events[head & (RING_BUFFER_SIZE - 1)];
+    e.timestamp = TraceWriter::now();
+    e.value = value;
+    e.type = type;
+    if (name) {
+        strncpy(e.name, name, sizeof(e.name) - 1);
+        e.name[sizeof(e.name) - 1] = 0;
+    } else {
+        e.name[0] = 0;
+    }
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Systrace::recordFrameId(uint32_t frame) noexcept {
+    char buf[64];
+    snprintf(buf, 64, "frame %u", frame);
+    record(EventType::INSTANT, buf, frame);
+}
+
+} // namespace details
+} // namespace utils
+
+#endif // FILAMENT_LINUX_SYSTRACE
@@ -15,8 +15,10 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <functional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -153,6 +155,81 @@ TEST(AllocatorTest, PoolAllocator) {
     }
 }
 
+TEST(AllocatorTest, ThreadCachedPoolAllocator) {
+    constexpr size_t COUNT = 256;
+    alignas(64) static char scratch[COUNT * 64];
+    PoolAllocator<64, 64, 0, ThreadCachedFreeList> pa(scratch, sizeof(scratch));
+
+    for (size_t k = 0; k < 4; k++) {
+        // all elements can be allocated, even the ones cached by this thread
+        std::vector<void*> allocations;
+        for (size_t i = 0; i < COUNT; i++) {
+            void* const p = pa.alloc();
+            ASSERT_NE(nullptr, p);
+            allocations.push_back(p);
+        }
+        EXPECT_EQ(nullptr, pa.alloc());
+
+        // and they're all different
+        std::sort(allocations.begin(), allocations.end());
+        EXPECT_EQ(allocations.end(), std::adjacent_find(allocations.begin(), allocations.end()));
+
+        for (void* p : allocations) {
+            pa.free(p);
+        }
+    }
+}
+
+TEST(AllocatorTest, ThreadCachedPoolAllocatorThreads) {
+    constexpr size_t COUNT = 1024;
+    constexpr size_t THREAD_COUNT = 4;
+    alignas(64) static char scratch[COUNT * 64];
+    PoolAllocator<64, 64, 0, ThreadCachedFreeList> pa(scratch, sizeof(scratch));
+
+    // each thread allocates batches of elements, checks nobody else got them, and frees them
+    std::atomic<bool> failed{ false };
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&, t]() {
+            std::vector<uint32_t*> allocations;
+            for (size_t k = 0; k < 1000; k++) {
+                for (size_t i = 0; i < 48; i++) {
+                    auto* const p = static_cast<uint32_t*>(pa.alloc());
+                    if (!p) {
+                        failed = true;
+                        break;
+                    }
+                    *p = uint32_t(t);
+                    allocations.push_back(p);
+                }
+                for (uint32_t* p : allocations) {
+                    if (*p != uint32_t(t)) {
+                        failed = true;
+                    }
+                    pa.free(p);
+                }
+                allocations.clear();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(failed);
+
+    // elements freed by threads that are gone are still available
+    std::vector<void*> allocations;
+    for (size_t i = 0; i < COUNT; i++) {
+        void* const p = pa.alloc();
+        ASSERT_NE(nullptr, p);
+        allocations.push_back(p);
+    }
+    EXPECT_EQ(nullptr, pa.alloc());
+    for (void* p : allocations) {
+        pa.free(p);
+    }
+}
+
 
 TEST(AllocatorTest, CppAllocator) {
     struct Tracking {
@@ -17,9 +17,12 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "../src/EntityManagerImpl.h"
 #include <utils/NameComponentManager.h>
+#include <utils/SingleInstanceComponentManager.h>
 
 using namespace utils;
 
@@ -176,3 +179,117 @@ TEST(EntityTest, NameComponent) {
 
     cm.gc(em);
 }
+
+TEST(EntityTest, Listeners) {
+    struct Listener : public EntityManager::Listener {
+        void onEntitiesDestroyed(size_t n, Entity const* entities) noexcept override {
+            destroyed.insert(destroyed.end(), entities, entities + n);
+        }
+        std::vector<Entity> destroyed;
+    };
+
+    EntityManagerImpl em;
+    Listener listener;
+    em.registerListener(&listener);
+
+    Entity entities[8];
+    em.create(8, entities);
+    em.destroy(4, entities);
+
+    // listeners are called by destroy()
+    ASSERT_EQ(4, listener.destroyed.size());
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(entities[i], listener.destroyed[i]);
+    }
+
+    // destroying the null entity is not reported
+    listener.destroyed.clear();
+    em.destroy(Entity{});
+    EXPECT_TRUE(listener.destroyed.empty());
+
+    em.unregisterListener(&listener);
+    em.destroy(4, entities + 4);
+    EXPECT_TRUE(listener.destroyed.empty());
+}
+
+TEST(EntityTest, Threads) {
+    EntityManagerImpl em;
+    constexpr size_t THREAD_COUNT = 4;
+    constexpr size_t ENTITY_COUNT = 2000;
+    constexpr size_t ITERATIONS = 64;
+
+    std::vector<Entity> alive[THREAD_COUNT];
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&em, &entities = alive[t]]() {
+            std::vector<Entity> batch(ENTITY_COUNT);
+            for (size_t i = 0; i < ITERATIONS; i++) {
+                em.create(batch.size(), batch.data());
+                for (Entity const e : batch) {
+                    EXPECT_TRUE(em.isAlive(e));
+                }
+                // keep half of the entities alive, so indices get recycled while others are live
+                em.destroy(batch.size() / 2, batch.data());
+                entities.insert(entities.end(), batch.begin() + batch.size() / 2, batch.end());
+                em.destroy(entities.size() / 2, entities.data());
+                entities.erase(entities.begin(), entities.begin() + entities.size() / 2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // all the live entities must be unique and still alive
+    tsl::robin_set<Entity, Entity::Hasher> ids;
+    size_t count = 0;
+    for (auto const& entities : alive) {
+        for (Entity const e : entities) {
+            EXPECT_TRUE(em.isAlive(e));
+            ids.insert(e);
+            count++;
+        }
+    }
+    EXPECT_EQ(count, ids.size());
+    EXPECT_EQ(count, em.getEntityCount());
+}
+
+TEST(EntityTest, IncrementalGc) {
+    struct Manager : public SingleInstanceComponentManager<int> {
+        using SingleInstanceComponentManager::addComponent;
+        using SingleInstanceComponentManager::removeComponent;
+        using SingleInstanceComponentManager::incrementalGc;
+    };
+
+    EntityManagerImpl em;
+    Manager cm;
+
+    Entity entities[100];
+    em.create(100, entities);
+    for (Entity const e : entities) {
+        cm.addComponent(e);
+    }
+
+    // destroy every other entity
+    for (size_t i = 0; i < 100; i += 2) {
+        em.destroy(entities[i]);
+    }
+
+    auto remove = [&cm](Entity e) { cm.removeComponent(e); };
+
+    // each call scans at most 16 components, and resumes where the previous one stopped
+    size_t reclaimed = 0;
+    for (size_t i = 0; i < 100 / 16 + 1; i++) {
+        size_t const removed = cm.incrementalGc(em, 16, remove);
+        EXPECT_LE(removed, 16);
+        reclaimed += removed;
+    }
+    EXPECT_EQ(50, reclaimed);
+    EXPECT_EQ(50, cm.getComponentCount());
+    for (size_t i = 1; i < 100; i += 2) {
+        EXPECT_TRUE(cm.hasComponent(entities[i]));
+    }
+
+    // nothing left to reclaim
+    EXPECT_EQ(0, cm.incrementalGc(em, 100, remove));
+}
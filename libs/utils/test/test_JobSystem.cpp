@@ -24,6 +24,7 @@
 
 #include <array>
 #include <thread>
+#include <vector>
 #include <utils/Allocator.h>
 
 using namespace utils;
@@ -284,6 +285,109 @@ TEST(JobSystem, JobSystemParallelFor) {
     js.emancipate();
 }
 
+TEST(JobSystem, JobSystemPriorities) {
+    JobSystem js;
+    js.adopt();
+
+    // keep the worker threads busy, so that all the jobs below are run by this thread
+    std::atomic_int blockedThreads = { 0 };
+    std::atomic_bool unblock = { false };
+    JobSystem::Job* blockers = js.createJob();
+    for (size_t i = 0; i < js.getThreadCount(); i++) {
+        js.run(jobs::createJob(js, blockers, [&] {
+            blockedThreads++;
+            while (!unblock) {
+                std::this_thread::yield();
+            }
+        }));
+    }
+    blockers = js.runAndRetain(blockers);
+    while (blockedThreads < js.getThreadCount()) {
+        std::this_thread::yield();
+    }
+
+    std::vector<JobSystem::JobPriority> order;
+    auto record = [&order](JobSystem::JobPriority priority) {
+        order.push_back(priority);
+    };
+
+    JobSystem::Job* root = js.createJob();
+
+    // the child inherits the priority of its parent
+    JobSystem::Job* background = js.createJob(root);
+    js.setPriority(background, JobSystem::JobPriority::BACKGROUND);
+    js.run(jobs::createJob(js, background, record, JobSystem::JobPriority::BACKGROUND));
+    js.run(background);
+
+    js.run(jobs::createJob(js, root, record, JobSystem::JobPriority::NORMAL));
+
+    JobSystem::Job* critical = jobs::createJob(js, root, record, JobSystem::JobPriority::CRITICAL);
+    js.setPriority(critical, JobSystem::JobPriority::CRITICAL);
+    js.run(critical);
+
+    js.runAndWait(root);
+
+    ASSERT_EQ(3, order.size());
+    EXPECT_EQ(JobSystem::JobPriority::CRITICAL, order[0]);
+    EXPECT_EQ(JobSystem::JobPriority::NORMAL, order[1]);
+    EXPECT_EQ(JobSystem::JobPriority::BACKGROUND, order[2]);
+
+    unblock = true;
+    js.waitAndRelease(blockers);
+
+    js.emancipate();
+}
+
+TEST(JobSystem, JobSystemContinuations) {
+    JobSystem js;
+    js.adopt();
+
+    for (size_t iteration = 0; iteration < 100; iteration++) {
+        std::atomic_int a = { 0 };
+        std::atomic_int c = { 0 };
+        std::atomic_int b = { 0 };
+        std::atomic_int d = { 0 };
+
+        JobSystem::Job* root = js.createJob();
+
+        // a has children, which must also finish before b runs
+        JobSystem::Job* jobA = jobs::createJob(js, root, [&] { a++; });
+        for (size_t i = 0; i < 16; i++) {
+            js.run(jobs::createJob(js, jobA, [&] { a++; }));
+        }
+        JobSystem::Job* jobC = jobs::createJob(js, root, [&] { c++; });
+        JobSystem::Job* jobB = jobs::createJob(js, root, [&] {
+            EXPECT_EQ(17, a.load());
+            EXPECT_EQ(1, c.load());
+            b++;
+        });
+        JobSystem::Job* jobD = jobs::createJob(js, root, [&] {
+            EXPECT_EQ(1, b.load());
+            d++;
+        });
+
+        JobSystem::Job* const dependenciesOfB[] = { jobA, jobC };
+        js.runAfter(jobD, { jobB });
+        js.runAfter(jobB, dependenciesOfB, 2);
+        js.run(jobC);
+        js.run(jobA);
+        js.runAndWait(root);
+
+        EXPECT_EQ(1, b.load());
+        EXPECT_EQ(1, d.load());
+    }
+
+    // without dependencies, the job is run right away
+    std::atomic_int e = { 0 };
+    JobSystem::Job* jobE = jobs::createJob(js, nullptr, [&] { e++; });
+    JobSystem::Job* retained = js.retain(jobE);
+    js.runAfter(jobE, nullptr, 0);
+    js.waitAndRelease(retained);
+    EXPECT_EQ(1, e.load());
+
+    js.emancipate();
+}
+
 TEST(JobSystem, JobSystemDelegates) {
     JobSystem js;
     js.adopt();
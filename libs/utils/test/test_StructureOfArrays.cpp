@@ -16,9 +16,14 @@
 
 #include <gtest/gtest.h>
 
+#include <utils/JobSystem.h>
 #include <utils/StructureOfArrays.h>
+#include <utils/StructureOfArraysJobs.h>
 #include <math/vec4.h>
 
+#include <numeric>
+#include <vector>
+
 using namespace filament::math;
 using namespace utils;
 
@@ -183,3 +188,86 @@ TEST(StructureOfArraysTest, MoveOnly) {
     EXPECT_EQ(*soa.elementAt<1>(1).get(), 2);
 }
 
+
+TEST(StructureOfArraysTest, Permute) {
+    StructureOfArrays<float, std::unique_ptr<int32_t>> soa;
+    for (int32_t i = 0; i < 5; i++) {
+        soa.push_back(float(i), std::make_unique<int32_t>(i));
+    }
+    uint32_t const order[] = { 3, 0, 4, 1, 2 };
+    soa.permute(order);
+    EXPECT_EQ(soa.size(), 5);
+    for (size_t i = 0; i < 5; i++) {
+        EXPECT_EQ(soa.elementAt<0>(i), float(order[i]));
+        EXPECT_EQ(*soa.elementAt<1>(i), int32_t(order[i]));
+    }
+}
+
+TEST(StructureOfArraysTest, GatherScatter) {
+    StructureOfArrays<uint32_t, double> src;
+    for (uint32_t i = 0; i < 6; i++) {
+        src.push_back(i, double(i) * 0.5);
+    }
+    uint32_t const indices[] = { 5, 4, 0, 2 };
+
+    StructureOfArrays<uint32_t, double> gathered;
+    gathered.resize(4);
+    gathered.gather(src, indices, 0, 2);
+    gathered.gather(src, indices, 2, 4);
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(gathered.elementAt<0>(i), indices[i]);
+        EXPECT_EQ(gathered.elementAt<1>(i), double(indices[i]) * 0.5);
+    }
+
+    // scattering back the gathered elements restores them
+    StructureOfArrays<uint32_t, double> scattered;
+    scattered.resize(6);
+    scattered.scatter(gathered, indices, 0, 4);
+    for (uint32_t i : indices) {
+        EXPECT_EQ(scattered.elementAt<0>(i), i);
+        EXPECT_EQ(scattered.elementAt<1>(i), double(i) * 0.5);
+    }
+}
+
+TEST(StructureOfArraysTest, ParallelSort) {
+    JobSystem js;
+    js.adopt();
+
+    // large enough to be split in several chunks
+    constexpr uint32_t COUNT = 100000;
+    StructureOfArrays<uint32_t, uint32_t, float> soa;
+    soa.setCapacity(COUNT);
+    for (uint32_t i = 0; i < COUNT; i++) {
+        // lots of duplicate keys to check the sort is stable
+        soa.push_back((i * 7919u) % 1024u, i, float(i));
+    }
+
+    jobs::sort<0>(js, soa);
+
+    EXPECT_EQ(soa.size(), COUNT);
+    for (uint32_t i = 1; i < COUNT; i++) {
+        uint32_t const k0 = soa.elementAt<0>(i - 1);
+        uint32_t const k1 = soa.elementAt<0>(i);
+        ASSERT_LE(k0, k1);
+        if (k0 == k1) {
+            ASSERT_LT(soa.elementAt<1>(i - 1), soa.elementAt<1>(i));
+        }
+        ASSERT_EQ(float(soa.elementAt<1>(i)), soa.elementAt<2>(i));
+    }
+
+    // and back, with a custom comparison
+    jobs::sort<2>(js, soa, std::greater<>());
+    for (uint32_t i = 0; i < COUNT; i++) {
+        ASSERT_EQ(soa.elementAt<1>(i), COUNT - 1 - i);
+    }
+
+    // permuting with the inverse order restores the original order
+    std::vector<uint32_t> order(COUNT);
+    std::iota(order.rbegin(), order.rend(), 0);
+    jobs::permute(js, soa, order.data());
+    for (uint32_t i = 0; i < COUNT; i++) {
+        ASSERT_EQ(soa.elementAt<1>(i), i);
+    }
+
+    js.emancipate();
+}
@@ -56,6 +56,8 @@ static void usage(char* name) {
             "       Shader family to generate: desktop, mobile or all (default)\n\n"
             "   --optimize-size, -S\n"
             "       Optimize generated shader code for size instead of just performance\n\n"
+            "   --compress, -z\n"
+            "       Compress the shader dictionaries with LZ4 to reduce the output size\n\n"
             "   --api, -a\n"
             "       Specify the target API: opengl (default), vulkan, metal, or all\n"
             "       This flag can be repeated to individually select APIs for inclusion:\n"
@@ -83,6 +85,8 @@ static void usage(char* name) {
             "       This variant filter is merged with the filter from the material, if any\n\n"
             "   --version, -v\n"
             "       Print the material version number\n\n"
+            "   --verbose\n"
+            "       Print shader compilation statistics\n\n"
             "Internal use and debugging only:\n"
             "   --optimize-none, -g\n"
             "       Disable all shader optimizations, for debugging\n\n"
@@ -174,7 +178,12 @@ static void parseDefine(std::string defineString, Config::StringReplacementMap&
 }
 
 bool CommandlineConfig::parse() {
-    static constexpr const char* OPTSTR = "hLxo:f:dm:a:l:p:D:T:OSEr:vV:gtwF1";
+    // long-only options, outside the range of the short options
+    enum : int {
+        OPTION_VERBOSE = 256
+    };
+
+    static constexpr const char* OPTSTR = "hLxo:f:dm:a:l:p:D:T:OSEr:vV:gtwzF1";
     static const struct option OPTIONS[] = {
             { "help",                    no_argument, nullptr, 'h' },
             { "license",                 no_argument, nullptr, 'L' },
@@ -196,7 +205,9 @@ bool CommandlineConfig::parse() {
             { "reflect",           required_argument, nullptr, 'r' },
             { "print",                   no_argument, nullptr, 't' },
             { "version",                 no_argument, nullptr, 'v' },
+            { "verbose",                 no_argument, nullptr, OPTION_VERBOSE },
             { "raw",                     no_argument, nullptr, 'w' },
+            { "compress",                no_argument, nullptr, 'z' },
             { "no-sampler-validation",   no_argument, nullptr, 'F' },
             { nullptr, 0, nullptr, 0 }  // termination of the option list
     };
@@ -289,6 +300,9 @@ bool CommandlineConfig::parse() {
                 std::cout << filament::MATERIAL_VERSION << std::endl;
                 exit(0);
                 break;
+            case OPTION_VERBOSE:
+                mVerbose = true;
+                break;
             case 'V':
                 mVariantFilter = parseVariantFilter(arg);
                 break;
@@ -315,6 +329,9 @@ bool CommandlineConfig::parse() {
             case 'w':
                 mRawShaderMode = true;
                 break;
+            case 'z':
+                mCompressShaders = true;
+                break;
             case 'F':
                 mNoSamplerValidation = true;
                 break;
@@ -79,6 +79,10 @@ public:
         return mDebug;
     }
 
+    bool isVerbose() const noexcept {
+        return mVerbose;
+    }
+
     Platform getPlatform() const noexcept {
         return mPlatform;
     }
@@ -111,6 +115,10 @@ public:
         return mPrintShaders;
     }
 
+    bool compressShaders() const noexcept {
+        return mCompressShaders;
+    }
+
     bool rawShaderMode() const noexcept {
         return mRawShaderMode;
     }
@@ -141,9 +149,11 @@ public:
 
 protected:
     bool mDebug = false;
+    bool mVerbose = false;
     bool mIsValid = true;
     bool mPrintShaders = false;
     bool mRawShaderMode = false;
+    bool mCompressShaders = false;
     bool mNoSamplerValidation = false;
     Optimization mOptimizationLevel = Optimization::PERFORMANCE;
     Metadata mReflectionTarget = Metadata::NONE;
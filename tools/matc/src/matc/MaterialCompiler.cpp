@@ -409,6 +409,7 @@ bool MaterialCompiler::run(const Config& config) {
         .optimization(config.getOptimizationLevel())
         .printShaders(config.printShaders())
         .generateDebugInfo(config.isDebug())
+        .compressShaders(config.compressShaders())
         .variantFilter(config.getVariantFilter() | builder.getVariantFilter());
 
     for (const auto& define : config.getDefines()) {
@@ -428,6 +429,16 @@ bool MaterialCompiler::run(const Config& config) {
         std::cerr << "Could not compile material " << input->getName() << std::endl;
         return false;
     }
+
+    if (config.isVerbose()) {
+        auto const stats = builder.getShaderCompilationStats();
+        float const hitRate = stats.shaderCount ?
+                100.0f * float(stats.cacheHits) / float(stats.shaderCount) : 0.0f;
+        std::cout << "Compiled " << stats.shaderCount << " shaders, "
+                << stats.cacheHits << " reused from identical shaders ("
+                << hitRate << "% hit rate)" << std::endl;
+    }
+
     return writePackage(package, config);
 }
 
@@ -20,6 +20,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <algorithm>
 #include <string>
 
 #include <tsl/robin_map.h>
@@ -32,6 +33,8 @@
 
 #include <zstd.h>
 
+#include <string.h>
+
 using namespace std;
 using namespace utils;
 using namespace filament::uberz;
@@ -42,6 +45,7 @@ static std::string g_outputFile = "materials.uberz";
 static bool g_appendMode = false;
 static bool g_quietMode = false;
 static bool g_verboseMode = false;
+static bool g_uncompressed = false;
 static StringMap g_templateMap;
 
 static const char* USAGE = R"TXT(
@@ -71,6 +75,8 @@ Options:
         Suppress console output
     --template <macro>=<string>, -T<macro>=<string>
         Replaces ${MACRO} with specified string before parsing spec file
+    --uncompressed, -u
+        Skip zstd compression, gltfio can then use the archive in place
 )TXT";
 
 static void printUsage(const char* name) {
@@ -111,7 +117,7 @@ static void insertMapEntry(std::string assignment, StringMap& map, std::string d
 }
 
 static int handleArguments(int argc, char* argv[]) {
-    static constexpr const char* OPTSTR = "ahLqvo:T:";
+    static constexpr const char* OPTSTR = "ahLquvo:T:";
     static const struct option OPTIONS[] = {
             { "append",   no_argument,       0, 'a' },
             { "help",     no_argument,       0, 'h' },
@@ -120,6 +126,7 @@ static int handleArguments(int argc, char* argv[]) {
             { "verbose",  no_argument,       0, 'v' },
             { "output",   required_argument, 0, 'o' },
             { "template", required_argument, 0, 'T' },
+            { "uncompressed", no_argument,   0, 'u' },
             { 0, 0, 0, 0 }  // termination of the option list
     };
 
@@ -148,6 +155,9 @@ static int handleArguments(int argc, char* argv[]) {
             case 'q':
                 g_quietMode = true;
                 break;
+            case 'u':
+                g_uncompressed = true;
+                break;
             case 'v':
                 g_verboseMode = true;
                 break;
@@ -183,12 +193,20 @@ int main(int argc, char* argv[]) {
             cerr << "Unable to consume " << g_outputFile << endl;
             exit(1);
         }
-        const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveSize);
-        if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
-            PANIC_POSTCONDITION("Decompression error.");
+        uint64_t* basePointer;
+        uint32_t magic = 0;
+        memcpy(&magic, archiveData, std::min(archiveSize, sizeof(magic)));
+        if (magic == ARCHIVE_MAGIC) {
+            basePointer = (uint64_t*) utils::aligned_alloc(archiveSize, 8);
+            memcpy(basePointer, archiveData, archiveSize);
+        } else {
+            const uint64_t decompSize = ZSTD_getFrameContentSize(archiveData, archiveSize);
+            if (decompSize == ZSTD_CONTENTSIZE_UNKNOWN || decompSize == ZSTD_CONTENTSIZE_ERROR) {
+                PANIC_POSTCONDITION("Decompression error.");
+            }
+            basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
+            ZSTD_decompress(basePointer, decompSize, archiveData, archiveSize);
         }
-        uint64_t* basePointer = (uint64_t*) utils::aligned_alloc(decompSize, 8);
-        ZSTD_decompress(basePointer, decompSize, archiveData, archiveSize);
         existingArchive = (ReadableArchive*) basePointer;
         convertOffsetsToPointers(existingArchive);
         existingMaterialsCount = existingArchive->specsCount;
@@ -259,7 +277,7 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    FixedCapacityVector<uint8_t> binBuffer = outputArchive.serialize();
+    FixedCapacityVector<uint8_t> binBuffer = outputArchive.serialize(!g_uncompressed);
 
     ofstream binStream(g_outputFile, ios::binary);
     if (!binStream) {